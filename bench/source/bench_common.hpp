@@ -0,0 +1,44 @@
+#pragma once
+
+#include <recti/halton_int.hpp>  // for HaltonTable
+#include <recti/recti.hpp>       // for Point, Rectangle, Interval
+#include <vector>                // for vector
+
+namespace recti_bench {
+
+    /**
+     * @brief `num` Halton points in [0, 2048) x [0, 2187).
+     */
+    inline auto halton_points(std::size_t num) -> std::vector<recti::Point<int>> {
+        const unsigned base[] = {2, 3};
+        const unsigned scale[] = {11, 7};
+        auto gen = recti::HaltonTable(base, scale);
+        auto pts = std::vector<recti::Point<int>>{};
+        pts.reserve(num);
+        for (auto i = std::size_t{0}; i != num; ++i) {
+            const auto pt = gen();
+            pts.emplace_back(int(pt.xcoord()), int(pt.ycoord()));
+        }
+        return pts;
+    }
+
+    /**
+     * @brief `num` small Halton-placed rectangles (sides 1 to 32).
+     */
+    inline auto halton_rectangles(std::size_t num) -> std::vector<recti::Rectangle<int>> {
+        const unsigned base[] = {5, 7};
+        const unsigned scale[] = {5, 5};
+        auto sides = recti::HaltonTable(base, scale);
+        auto rects = std::vector<recti::Rectangle<int>>{};
+        rects.reserve(num);
+        for (const auto &pt : halton_points(num)) {
+            const auto side = sides();
+            const auto width = 1 + int(side.xcoord() % 32);
+            const auto height = 1 + int(side.ycoord() % 32);
+            rects.emplace_back(recti::Interval<int>{pt.xcoord(), pt.xcoord() + width},
+                               recti::Interval<int>{pt.ycoord(), pt.ycoord() + height});
+        }
+        return rects;
+    }
+
+}  // namespace recti_bench
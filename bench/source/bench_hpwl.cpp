@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <recti/hpwl.hpp>  // for HpwlNetlist
+#include <vector>          // for vector
+
+#include "bench_common.hpp"
+
+using namespace recti;
+
+// range(0) cells on a Halton placement, 4 pins per net, with nets of nearby cell indices
+static auto make_engine(std::size_t num_cells) -> HpwlNetlist<int> {
+    const auto cells = recti_bench::halton_points(num_cells);
+    auto net_offsets = std::vector<std::size_t>{0};
+    auto pin_cells = std::vector<std::size_t>{};
+    auto pin_offsets = std::vector<Vector2<int>>{};
+    for (auto net = std::size_t{0}; net != num_cells; ++net) {
+        for (auto pin = std::size_t{0}; pin != 4; ++pin) {
+            pin_cells.push_back((net + pin * 7) % num_cells);
+            pin_offsets.emplace_back(int(pin), 1);
+        }
+        net_offsets.push_back(pin_cells.size());
+    }
+    return HpwlNetlist<int>(net_offsets, pin_cells, pin_offsets, cells);
+}
+
+static void BM_HpwlUpdateAll(benchmark::State &state) {
+    auto engine = make_engine(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        engine.update_all();
+        benchmark::DoNotOptimize(engine.total());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HpwlUpdateAll)->Arg(1000)->Arg(100000);
+
+// one placer move: a cell swaps places with another
+static void BM_HpwlSwapCells(benchmark::State &state) {
+    auto engine = make_engine(std::size_t(state.range(0)));
+    auto step = std::size_t{0};
+    for (auto _ : state) {
+        const auto first = (step * 7919) % engine.num_cells();
+        const auto second = (step * 104729 + 1) % engine.num_cells();
+        ++step;
+        if (first == second) {
+            continue;
+        }
+        const std::size_t moved[] = {first, second};
+        const Point<int> positions[] = {engine.cell(second), engine.cell(first)};
+        benchmark::DoNotOptimize(engine.move_cells(moved, positions));
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()));
+}
+BENCHMARK(BM_HpwlSwapCells)->Arg(1000)->Arg(100000);
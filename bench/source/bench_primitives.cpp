@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <recti/merge_obj.hpp>  // for MergeObj
+#include <recti/recti.hpp>      // for Interval, Point, Rectangle
+#include <vector>               // for vector
+
+#include "bench_common.hpp"
+
+using namespace recti;
+
+static void BM_IntervalOverlaps(benchmark::State &state) {
+    const auto rects = recti_bench::halton_rectangles(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        auto count = 0;
+        for (auto i = std::size_t{1}; i < rects.size(); ++i) {
+            count += int(rects[i - 1].xcoord().overlaps(rects[i].xcoord()));
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_IntervalOverlaps)->RangeMultiplier(10)->Range(1000, 10000000);
+
+static void BM_PointMinDist(benchmark::State &state) {
+    const auto pts = recti_bench::halton_points(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        auto total = 0;
+        for (auto i = std::size_t{1}; i < pts.size(); ++i) {
+            total += pts[i - 1].min_dist_with(pts[i]);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PointMinDist)->RangeMultiplier(10)->Range(1000, 10000000);
+
+static void BM_RectangleContains(benchmark::State &state) {
+    const auto rects = recti_bench::halton_rectangles(std::size_t(state.range(0)));
+    const auto pts = recti_bench::halton_points(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        auto count = 0;
+        for (auto i = std::size_t{0}; i != rects.size(); ++i) {
+            count += int(rects[i].contains(pts[i]));
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_RectangleContains)->RangeMultiplier(10)->Range(1000, 10000000);
+
+static void BM_MergeObjMergeWith(benchmark::State &state) {
+    const auto pts = recti_bench::halton_points(std::size_t(state.range(0)));
+    auto objs = std::vector<MergeObj<int>>{};
+    objs.reserve(pts.size());
+    for (const auto &pt : pts) {
+        objs.emplace_back(pt.xcoord() + pt.ycoord(), pt.xcoord() - pt.ycoord());
+    }
+    for (auto _ : state) {
+        for (auto i = std::size_t{1}; i < objs.size(); ++i) {
+            auto merged = objs[i - 1].merge_with(objs[i]);
+            benchmark::DoNotOptimize(merged);
+        }
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MergeObjMergeWith)->RangeMultiplier(10)->Range(1000, 1000000);
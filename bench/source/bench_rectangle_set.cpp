@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>                  // for uint64_t
+#include <recti/rectangle_set.hpp>  // for RectangleSet
+#include <recti/recti.hpp>          // for Rectangle
+#include <vector>                   // for vector
+
+#include "bench_common.hpp"
+
+using namespace recti;
+
+// packed layout: std::vector<Rectangle<int>> scanned with the scalar dispatchers
+static void BM_OverlapsPacked(benchmark::State &state) {
+    const auto rects = recti_bench::halton_rectangles(std::size_t(state.range(0)));
+    const auto query = Rectangle<int>{{1000, 1100}, {1000, 1100}};
+    auto mask = std::vector<std::uint64_t>((rects.size() + 63) / 64);
+    for (auto _ : state) {
+        std::fill(mask.begin(), mask.end(), 0);
+        for (auto i = std::size_t{0}; i != rects.size(); ++i) {
+            mask[i / 64] |= std::uint64_t(overlap(rects[i], query)) << (i % 64);
+        }
+        benchmark::DoNotOptimize(mask.data());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * state.range(0)
+                            * std::int64_t(sizeof(Rectangle<int>)));
+}
+BENCHMARK(BM_OverlapsPacked)->RangeMultiplier(10)->Range(1000, 10000000);
+
+// SoA layout: RectangleSet batch kernel
+static void BM_OverlapsSoA(benchmark::State &state) {
+    const auto rects = recti_bench::halton_rectangles(std::size_t(state.range(0)));
+    const auto set = RectangleSet<int>(rects);
+    const auto query = Rectangle<int>{{1000, 1100}, {1000, 1100}};
+    auto mask = std::vector<std::uint64_t>(set.mask_words());
+    for (auto _ : state) {
+        set.overlaps(query, mask);
+        benchmark::DoNotOptimize(mask.data());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * state.range(0)
+                            * std::int64_t(sizeof(Rectangle<int>)));
+}
+BENCHMARK(BM_OverlapsSoA)->RangeMultiplier(10)->Range(1000, 10000000);
+
+static void BM_MinDistPacked(benchmark::State &state) {
+    const auto rects = recti_bench::halton_rectangles(std::size_t(state.range(0)));
+    const auto query = Rectangle<int>{{1000, 1100}, {1000, 1100}};
+    auto dist = std::vector<int>(rects.size());
+    for (auto _ : state) {
+        for (auto i = std::size_t{0}; i != rects.size(); ++i) {
+            dist[i] = min_dist(rects[i], query);
+        }
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MinDistPacked)->RangeMultiplier(10)->Range(1000, 10000000);
+
+static void BM_MinDistSoA(benchmark::State &state) {
+    const auto rects = recti_bench::halton_rectangles(std::size_t(state.range(0)));
+    const auto set = RectangleSet<int>(rects);
+    const auto query = Rectangle<int>{{1000, 1100}, {1000, 1100}};
+    auto dist = std::vector<int>(set.size());
+    for (auto _ : state) {
+        set.min_dist(query, dist);
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MinDistSoA)->RangeMultiplier(10)->Range(1000, 10000000);
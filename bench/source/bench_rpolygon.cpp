@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <recti/prepared_rpolygon.hpp>  // for PreparedRPolygon
+#include <recti/rpolygon.hpp>           // for RPolygon, create_xmono_rpolygon
+#include <vector>                       // for vector
+
+#include "bench_common.hpp"
+
+using namespace recti;
+
+static void BM_CreateXmonoRPolygon(benchmark::State &state) {
+    const auto pts = recti_bench::halton_points(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto S = pts;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(create_xmono_rpolygon(S.begin(), S.end()));
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CreateXmonoRPolygon)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// the constructor computes (and caches) the area, so this times the area kernel
+static void BM_RPolygonConstructArea(benchmark::State &state) {
+    auto S = recti_bench::halton_points(std::size_t(state.range(0)));
+    create_xmono_rpolygon(S.begin(), S.end());
+    for (auto _ : state) {
+        const auto P = RPolygon<int>(S);
+        benchmark::DoNotOptimize(P.signed_area());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_RPolygonConstructArea)->RangeMultiplier(10)->Range(1000, 10000000);
+
+// the cached read, independent of the vertex count
+static void BM_RPolygonSignedArea(benchmark::State &state) {
+    auto S = recti_bench::halton_points(std::size_t(state.range(0)));
+    create_xmono_rpolygon(S.begin(), S.end());
+    const auto P = RPolygon<int>(S);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(P.signed_area());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()));
+}
+BENCHMARK(BM_RPolygonSignedArea)->Arg(1000);
+
+// point_in_rpolygon walks every vertex per query: range(0) vertices, 1024 queries
+static void BM_PointInRPolygon(benchmark::State &state) {
+    auto S = recti_bench::halton_points(std::size_t(state.range(0)));
+    create_xmono_rpolygon(S.begin(), S.end());
+    const auto queries = recti_bench::halton_points(1024 + S.size());
+    for (auto _ : state) {
+        auto count = 0;
+        for (auto i = S.size(); i != queries.size(); ++i) {
+            count += int(point_in_rpolygon<int>(S, queries[i]));
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * 1024);
+}
+BENCHMARK(BM_PointInRPolygon)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BM_PreparedRPolygonContains(benchmark::State &state) {
+    auto S = recti_bench::halton_points(std::size_t(state.range(0)));
+    create_xmono_rpolygon(S.begin(), S.end());
+    const auto queries = recti_bench::halton_points(1024 + S.size());
+    const auto P = PreparedRPolygon<int>(S);
+    const auto batch = gsl::span<const Point<int>>(queries).subspan(S.size());
+    auto mask = std::vector<std::uint64_t>(1024 / 64);
+    for (auto _ : state) {
+        P.contains(batch, mask);
+        benchmark::DoNotOptimize(mask.data());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * 1024);
+}
+BENCHMARK(BM_PreparedRPolygonContains)->RangeMultiplier(10)->Range(1000, 100000);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <recti/polygon_set.hpp>  // for PolygonSet
+#include <recti/rsmt.hpp>         // for rsmt_length, rsmt_lengths
+#include <vector>                 // for vector
+
+#include "bench_common.hpp"
+
+using namespace recti;
+
+// range(0) nets of degree range(1), cut from one Halton sequence
+static auto make_nets(std::size_t num_nets, std::size_t degree) -> PolygonSet<int> {
+    const auto pins = recti_bench::halton_points(num_nets * degree);
+    auto nets = PolygonSet<int>{};
+    nets.reserve(num_nets, pins.size());
+    for (auto net = std::size_t{0}; net != num_nets; ++net) {
+        nets.push_back(gsl::span<const Point<int>>(pins).subspan(net * degree, degree));
+    }
+    return nets;
+}
+
+static void BM_RsmtLength(benchmark::State &state) {
+    const auto nets = make_nets(1000, std::size_t(state.range(0)));
+    for (auto _ : state) {
+        auto total = 0;
+        for (auto net = std::size_t{0}; net != nets.size(); ++net) {
+            total += rsmt_length(nets[net]);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * 1000);
+}
+BENCHMARK(BM_RsmtLength)->DenseRange(2, 10)->Arg(30)->Arg(100);
+
+static void BM_RsmtLengthOneSteiner(benchmark::State &state) {
+    const auto nets = make_nets(1000, std::size_t(state.range(0)));
+    for (auto _ : state) {
+        auto total = 0;
+        for (auto net = std::size_t{0}; net != nets.size(); ++net) {
+            total += rsmt_length(nets[net], SteinerMode::OneSteiner);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * 1000);
+}
+BENCHMARK(BM_RsmtLengthOneSteiner)->DenseRange(4, 9);
+
+static void BM_RsmtLengthsThreads(benchmark::State &state) {
+    const auto nets = make_nets(100000, 3);
+    auto out = std::vector<int>(nets.size());
+    for (auto _ : state) {
+        rsmt_lengths<int>(nets.points(), nets.offsets(), out, unsigned(state.range(0)));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(nets.size()));
+}
+BENCHMARK(BM_RsmtLengthsThreads)->Arg(1)->Arg(4)->UseRealTime();
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>      // for std::int64_t, std::uint64_t
+#include <type_traits>  // for std::is_integral_v, std::is_signed_v
+
+namespace recti {
+
+    /**
+     * @brief Accumulator type of a coordinate type
+     *
+     * Products and long sums of coordinates (`Vector2::cross`, `Rectangle::area`, the polygon
+     * areas, the total HPWL) are computed in `accumulator_t<T>` rather than in `T`, so that the
+     * coordinates can stay 32-bit in memory while real DBU values (1e6 and more per axis) do
+     * not overflow. By default, integers of at most 32 bits accumulate in 64 bits; 64-bit
+     * integers accumulate in `__int128` when `RECTI_WIDE_INT64` is defined (and the compiler
+     * has it), otherwise in themselves; every other type (floating point, `Interval`, ...)
+     * accumulates in itself.
+     *
+     * Specialize the traits to change the policy for a type, e.g. to keep `int` products in
+     * `int`:
+     *
+     *     template <> struct recti::accumulator_traits<int> { using type = int; };
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T, typename Enable = void> struct accumulator_traits {
+        using type = T;
+    };
+
+    template <typename T>
+    struct accumulator_traits<T, std::enable_if_t<std::is_integral_v<T> && (sizeof(T) <= 4)
+                                                  && !std::is_same_v<T, bool>>> {
+        using type = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+    };
+
+#if defined(RECTI_WIDE_INT64) && defined(__SIZEOF_INT128__)
+    namespace detail {
+        __extension__ typedef __int128 int128_t;
+        __extension__ typedef unsigned __int128 uint128_t;
+    }  // namespace detail
+
+    template <typename T>
+    struct accumulator_traits<T, std::enable_if_t<std::is_integral_v<T> && (sizeof(T) == 8)>> {
+        using type = std::conditional_t<std::is_signed_v<T>, detail::int128_t, detail::uint128_t>;
+    };
+#endif
+
+    template <typename T> using accumulator_t = typename accumulator_traits<T>::type;
+
+    /**
+     * @brief Convert a value to its accumulator type (before multiplying or summing).
+     *
+     * @tparam T The value type.
+     * @param[in] value The value.
+     * @return accumulator_t<T>
+     */
+    template <typename T> constexpr auto widen(const T &value) -> accumulator_t<T> {
+        return accumulator_t<T>(value);
+    }
+
+}  // namespace recti
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <new>      // for std::align_val_t, std::bad_alloc
+
+namespace recti {
+
+    /**
+     * @brief Aligned allocator
+     *
+     * `AlignedAllocator` is a minimal standard allocator that returns storage aligned to
+     * `Align` bytes. It is used by the structure-of-arrays containers so that every
+     * coordinate array starts on a cache-line (and SIMD register) boundary.
+     *
+     * @tparam T The value type.
+     * @tparam Align The alignment in bytes (a power of two, at least `alignof(T)`).
+     */
+    template <typename T, std::size_t Align = 64> class AlignedAllocator {
+        static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+        static_assert(Align >= alignof(T), "alignment must not be weaker than alignof(T)");
+
+      public:
+        using value_type = T;
+
+        /**
+         * @brief Rebind to another value type (required by allocator-aware containers).
+         *
+         * @tparam U The new value type.
+         */
+        template <typename U> struct rebind {
+            using other = AlignedAllocator<U, Align>;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+
+        /**
+         * @brief Construct from an allocator of another value type.
+         *
+         * @tparam U The value type of the other allocator.
+         */
+        template <typename U>
+        constexpr AlignedAllocator(const AlignedAllocator<U, Align> & /* other */) noexcept {}
+
+        /**
+         * @brief Allocate storage for `num` objects of type `T`.
+         *
+         * @param[in] num The number of objects.
+         * @return T* Pointer to storage aligned to `Align` bytes.
+         */
+        [[nodiscard]] auto allocate(std::size_t num) -> T * {
+            if (num > std::size_t(-1) / sizeof(T)) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(::operator new(num * sizeof(T), std::align_val_t{Align}));
+        }
+
+        /**
+         * @brief Release storage previously obtained from `allocate`.
+         *
+         * @param[in] ptr The pointer returned by `allocate`.
+         * @param[in] num The number of objects (unused).
+         */
+        auto deallocate(T *ptr, std::size_t /* num */) noexcept -> void {
+            ::operator delete(ptr, std::align_val_t{Align});
+        }
+
+        /**
+         * @brief All aligned allocators of the same alignment are interchangeable.
+         */
+        template <typename U>
+        constexpr auto operator==(const AlignedAllocator<U, Align> & /* rhs */) const noexcept
+            -> bool {
+            return true;
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,579 @@
+#pragma once
+
+#include <cstddef>  // for std::size_t, std::byte
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <cstring>  // for std::memcmp, std::memcpy
+#include <fstream>
+#include <gsl/span>
+#include <stdexcept>  // for std::runtime_error
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>     // for open, O_RDONLY
+#    include <sys/mman.h>  // for mmap, munmap
+#    include <sys/stat.h>  // for fstat
+#    include <unistd.h>    // for close
+#    define RECTI_BINARY_MMAP 1
+#endif
+
+#include "polygon_set.hpp"
+#include "recti.hpp"
+
+namespace recti::binary {
+
+    /**
+     * @brief Binary geometry files
+     *
+     * A file is a 16-byte header followed by sections. Each section is a 32-byte header and a
+     * payload of fixed-size records, padded to a multiple of 8 bytes: the records are the
+     * in-memory (`#pragma pack(1)`, so padding-free) layout of `Point<T>`, `Rectangle<T>`,
+     * `HSegment<T>` or `VSegment<T>`, or, for a polygon set, the vertices followed by a
+     * 64-bit offset table (the `PolygonSet::offsets()` layout). The data are stored in the
+     * byte order of the writer, which the header records; the reader rejects a foreign one.
+     *
+     * `BinaryReader` memory-maps the file (on POSIX; elsewhere it reads it into one buffer)
+     * and hands the sections out as spans into the mapping, with no per-record work.
+     * `BinaryWriter` streams the records to disk and patches the section header at the end.
+     */
+
+    /// The on-disk format version.
+    inline constexpr std::uint32_t format_version = 1;
+
+    /// The kind of records of a section.
+    enum class Kind : std::uint32_t {
+        points = 1,
+        rectangles = 2,
+        hsegments = 3,
+        vsegments = 4,
+        polygon_set = 5,
+    };
+
+    /**
+     * @brief The record kind and coordinate type of `Rec`, for the record types of recti.
+     */
+    template <typename Rec> struct record_traits;
+
+    template <typename T> struct record_traits<Point<T>> {
+        using coord_type = T;
+        static constexpr Kind kind = Kind::points;
+    };
+
+    template <typename T> struct record_traits<Rectangle<T>> {
+        using coord_type = T;
+        static constexpr Kind kind = Kind::rectangles;
+    };
+
+    template <typename T> struct record_traits<HSegment<T>> {
+        using coord_type = T;
+        static constexpr Kind kind = Kind::hsegments;
+    };
+
+    template <typename T> struct record_traits<VSegment<T>> {
+        using coord_type = T;
+        static constexpr Kind kind = Kind::vsegments;
+    };
+
+    namespace detail {
+        inline constexpr char file_magic[8] = {'R', 'E', 'C', 'T', 'I', 'B', 'I', 'N'};
+        inline constexpr std::uint32_t byte_order_mark = 0x01020304U;
+
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+        };
+
+        struct SectionHeader {
+            std::uint32_t kind;
+            std::uint32_t scalar;        // see `scalar_code`
+            std::uint64_t count;         // records, or polygons for a polygon set
+            std::uint64_t num_points;    // vertices of a polygon set (0 otherwise)
+            std::uint64_t payload_size;  // in bytes, excluding the padding
+        };
+
+        static_assert(sizeof(FileHeader) == 16 && sizeof(SectionHeader) == 32);
+
+        /**
+         * @brief Identify the coordinate type: its size, signedness and whether it is
+         * floating point.
+         */
+        template <typename T> constexpr auto scalar_code() -> std::uint32_t {
+            static_assert(std::is_arithmetic_v<T>, "coordinates must be arithmetic");
+            return std::uint32_t(sizeof(T)) | (std::is_signed_v<T> ? 0x100U : 0U)
+                   | (std::is_floating_point_v<T> ? 0x200U : 0U);
+        }
+
+        constexpr auto padded(std::uint64_t size) -> std::uint64_t { return (size + 7U) & ~7ULL; }
+
+        /**
+         * @brief The payload size implied by the record counts of a section (the coordinates
+         * per record times the coordinate size), or `~0` if the counts cannot fit in
+         * `available` bytes (checked before multiplying, so crafted counts cannot wrap).
+         */
+        constexpr auto payload_size(const SectionHeader &section, std::uint64_t available)
+            -> std::uint64_t {
+            constexpr auto invalid = ~std::uint64_t{0};
+            const auto coord_size = std::uint64_t(section.scalar & 0xFFU);
+            auto records = [&](std::uint64_t record_size) {
+                return record_size != 0 && section.count > available / record_size
+                           ? invalid
+                           : section.count * record_size;
+            };
+            switch (Kind(section.kind)) {
+                case Kind::points:
+                    return records(2 * coord_size);
+                case Kind::rectangles:
+                    return records(4 * coord_size);
+                case Kind::hsegments:
+                case Kind::vsegments:
+                    return records(3 * coord_size);
+                case Kind::polygon_set: {
+                    const auto offset_slots = available / sizeof(std::uint64_t);
+                    if ((coord_size != 0 && section.num_points > available / (2 * coord_size))
+                        || section.count >= offset_slots) {
+                        return invalid;
+                    }
+                    return padded(section.num_points * 2 * coord_size)
+                           + (section.count + 1) * sizeof(std::uint64_t);
+                }
+            }
+            return invalid;
+        }
+
+        [[noreturn]] inline auto fail(const std::string &what) -> void {
+            throw std::runtime_error("recti::binary: " + what);
+        }
+
+        /**
+         * @brief Check that the offset table of a polygon set section starts at 0, never
+         * decreases and ends at the number of points.
+         */
+        inline auto check_offsets(const SectionHeader &section, const std::byte *payload)
+            -> void {
+            const auto coord_size = std::uint64_t(section.scalar & 0xFFU);
+            const auto *offsets = reinterpret_cast<const std::uint64_t *>(
+                payload + padded(section.num_points * 2 * coord_size));
+            if (offsets[0] != 0 || offsets[section.count] != section.num_points) {
+                fail("corrupt offset table");
+            }
+            for (auto idx = std::uint64_t{0}; idx != section.count; ++idx) {
+                if (offsets[idx + 1] < offsets[idx]) {
+                    fail("corrupt offset table");
+                }
+            }
+        }
+    }  // namespace detail
+
+    /**
+     * @brief A read-only view of the file contents, memory-mapped where supported.
+     */
+    class MappedFile {
+        const std::byte *_data{nullptr};
+        std::size_t _size{0};
+#if defined(RECTI_BINARY_MMAP)
+        void *_mapping{nullptr};
+#else
+        std::vector<std::byte> _buffer;
+#endif
+
+      public:
+        /**
+         * @brief Map the file `path` (throws `std::runtime_error` on failure).
+         *
+         * @param[in] path The file name.
+         */
+        explicit MappedFile(const std::string &path) {
+#if defined(RECTI_BINARY_MMAP)
+            const auto fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                detail::fail("cannot open " + path);
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+                ::close(fd);
+                detail::fail("cannot map " + path);
+            }
+            this->_size = std::size_t(info.st_size);
+            this->_mapping = ::mmap(nullptr, this->_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // the mapping keeps the file alive
+            if (this->_mapping == MAP_FAILED) {
+                detail::fail("cannot map " + path);
+            }
+            this->_data = static_cast<const std::byte *>(this->_mapping);
+#else
+            auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+            if (!file) {
+                detail::fail("cannot open " + path);
+            }
+            this->_buffer.resize(std::size_t(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char *>(this->_buffer.data()),
+                      std::streamsize(this->_buffer.size()));
+            this->_data = this->_buffer.data();
+            this->_size = this->_buffer.size();
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+        ~MappedFile() {
+#if defined(RECTI_BINARY_MMAP)
+            if (this->_mapping != nullptr) {
+                ::munmap(this->_mapping, this->_size);
+            }
+#endif
+        }
+
+        auto data() const noexcept -> const std::byte * { return this->_data; }
+        auto size() const noexcept -> std::size_t { return this->_size; }
+    };
+
+    /**
+     * @brief A polygon set stored in a file: spans into the mapping, in the layout of
+     * `PolygonSet`.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> class PolygonSetView {
+        gsl::span<const Point<T>> _points;
+        gsl::span<const std::uint64_t> _offsets;
+
+      public:
+        PolygonSetView(gsl::span<const Point<T>> points, gsl::span<const std::uint64_t> offsets)
+            : _points{points}, _offsets{offsets} {}
+
+        auto size() const noexcept -> std::size_t { return this->_offsets.size() - 1; }
+        auto empty() const noexcept -> bool { return this->size() == 0; }
+        auto num_points() const noexcept -> std::size_t { return this->_points.size(); }
+
+        /**
+         * @brief The vertices of polygon `idx`.
+         *
+         * @param[in] idx The polygon index.
+         * @return gsl::span<const Point<T>>
+         */
+        auto operator[](std::size_t idx) const -> gsl::span<const Point<T>> {
+            const auto first = std::size_t(this->_offsets[idx]);
+            return this->_points.subspan(first, std::size_t(this->_offsets[idx + 1]) - first);
+        }
+
+        auto points() const noexcept -> gsl::span<const Point<T>> { return this->_points; }
+        auto offsets() const noexcept -> gsl::span<const std::uint64_t> { return this->_offsets; }
+    };
+
+    /**
+     * @brief Streaming writer of binary geometry files.
+     *
+     * Records are appended to the open section as they come; `end_section()` (or the next
+     * `begin_*`, or `close()`) fills in its header. Only the offset table of a polygon set is
+     * kept in memory until then.
+     */
+    class BinaryWriter {
+        std::ofstream _file;
+        std::streamoff _section_pos{-1};  // the header of the open section, if any
+        detail::SectionHeader _section{};
+        std::vector<std::uint64_t> _offsets;  // of the open polygon set
+
+      public:
+        /**
+         * @brief Create (or truncate) the file `path` and write its header.
+         *
+         * @param[in] path The file name.
+         */
+        explicit BinaryWriter(const std::string &path)
+            : _file(path, std::ios::binary | std::ios::trunc) {
+            if (!this->_file) {
+                detail::fail("cannot create " + path);
+            }
+            auto header = detail::FileHeader{};
+            std::memcpy(header.magic, detail::file_magic, sizeof header.magic);
+            header.version = format_version;
+            header.byte_order = detail::byte_order_mark;
+            this->_write_raw(&header, sizeof header);
+        }
+
+        BinaryWriter(const BinaryWriter &) = delete;
+        auto operator=(const BinaryWriter &) -> BinaryWriter & = delete;
+
+        ~BinaryWriter() {
+            try {
+                this->close();
+            } catch (...) {
+                // errors are reported by an explicit `close()`
+            }
+        }
+
+        /**
+         * @brief Open a section of records of type `Rec` (e.g. `Rectangle<int>`).
+         */
+        template <typename Rec> auto begin_section() -> void {
+            using Traits = record_traits<Rec>;
+            static_assert(recti::detail::is_flat_value<Rec>(), "records must be memcpy-able");
+            this->_begin(Traits::kind, detail::scalar_code<typename Traits::coord_type>());
+        }
+
+        /**
+         * @brief Append records to the open section, which must hold records of type `Rec`.
+         *
+         * @param[in] records The records.
+         */
+        template <typename Rec> auto append(gsl::span<const Rec> records) -> void {
+            using Traits = record_traits<Rec>;
+            this->_check(Traits::kind, detail::scalar_code<typename Traits::coord_type>());
+            this->_write_raw(records.data(), records.size_bytes());
+            this->_section.count += records.size();
+            this->_section.payload_size += records.size_bytes();
+        }
+
+        /**
+         * @brief Write a whole section of records.
+         *
+         * @param[in] records The records.
+         */
+        template <typename Rec> auto write(gsl::span<const Rec> records) -> void {
+            this->begin_section<Rec>();
+            this->append(records);
+            this->end_section();
+        }
+
+        /**
+         * @brief Open a section of polygons with coordinates of type `T`.
+         */
+        template <typename T> auto begin_polygon_set() -> void {
+            static_assert(recti::detail::is_flat_value<Point<T>>(), "points must be memcpy-able");
+            this->_begin(Kind::polygon_set, detail::scalar_code<T>());
+            this->_offsets.assign(1, 0);
+        }
+
+        /**
+         * @brief Append a polygon to the open polygon set.
+         *
+         * @param[in] pointset The vertices of the polygon.
+         */
+        template <typename T> auto append_polygon(gsl::span<const Point<T>> pointset) -> void {
+            this->_check(Kind::polygon_set, detail::scalar_code<T>());
+            this->_write_raw(pointset.data(), pointset.size_bytes());
+            this->_section.count += 1;
+            this->_section.num_points += pointset.size();
+            this->_section.payload_size += pointset.size_bytes();
+            this->_offsets.push_back(this->_section.num_points);
+        }
+
+        /**
+         * @brief Write a whole polygon set (e.g. of rectilinear polygons) as one section.
+         *
+         * @param[in] polygons The polygon set.
+         */
+        template <typename T, typename Alloc>
+        auto write(const PolygonSet<T, Alloc> &polygons) -> void {
+            this->begin_polygon_set<T>();
+            const auto points = polygons.points();
+            this->_write_raw(points.data(), points.size_bytes());
+            this->_section.count = polygons.size();
+            this->_section.num_points = polygons.num_points();
+            this->_section.payload_size = points.size_bytes();
+            this->_offsets.assign(polygons.offsets().begin(), polygons.offsets().end());
+            this->end_section();
+        }
+
+        /**
+         * @brief Finish the open section, if any, by padding it and patching its header.
+         */
+        auto end_section() -> void {
+            if (this->_section_pos < 0) {
+                return;
+            }
+            if (this->_section.kind == std::uint32_t(Kind::polygon_set)) {
+                this->_write_padding();  // the offsets start 8-byte aligned
+                const auto bytes = this->_offsets.size() * sizeof(std::uint64_t);
+                this->_write_raw(this->_offsets.data(), bytes);
+                this->_section.payload_size = detail::padded(this->_section.payload_size) + bytes;
+            }
+            this->_write_padding();
+            const auto end = this->_file.tellp();
+            this->_file.seekp(this->_section_pos);
+            this->_write_raw(&this->_section, sizeof this->_section);
+            this->_file.seekp(end);
+            this->_section_pos = -1;
+        }
+
+        /**
+         * @brief Finish the open section and flush the file (throws on an I/O error).
+         */
+        auto close() -> void {
+            if (!this->_file.is_open()) {
+                return;
+            }
+            this->end_section();
+            this->_file.close();
+            if (this->_file.fail()) {
+                detail::fail("write error");
+            }
+        }
+
+      private:
+        auto _begin(Kind kind, std::uint32_t scalar) -> void {
+            this->end_section();
+            this->_section_pos = std::streamoff(this->_file.tellp());
+            this->_section = detail::SectionHeader{std::uint32_t(kind), scalar, 0, 0, 0};
+            this->_write_raw(&this->_section, sizeof this->_section);  // patched at the end
+        }
+
+        auto _check(Kind kind, std::uint32_t scalar) const -> void {
+            if (this->_section_pos < 0 || this->_section.kind != std::uint32_t(kind)
+                || this->_section.scalar != scalar) {
+                detail::fail("no open section of this record type");
+            }
+        }
+
+        auto _write_padding() -> void {
+            static constexpr char zeros[8] = {};
+            const auto size = this->_section.payload_size;
+            this->_write_raw(zeros, std::size_t(detail::padded(size) - size));
+        }
+
+        auto _write_raw(const void *data, std::size_t bytes) -> void {
+            this->_file.write(static_cast<const char *>(data), std::streamsize(bytes));
+            if (!this->_file) {
+                detail::fail("write error");
+            }
+        }
+    };
+
+    /**
+     * @brief Zero-copy reader of binary geometry files.
+     *
+     * The constructor maps the file and checks the header and the section table; the
+     * accessors then return spans into the mapping, valid as long as the reader lives.
+     */
+    class BinaryReader {
+      public:
+        /// The description of a section.
+        struct Section {
+            Kind kind;
+            std::uint32_t scalar;
+            std::uint64_t count;
+            std::uint64_t num_points;
+            const std::byte *payload;
+        };
+
+      private:
+        MappedFile _file;
+        std::vector<Section> _sections;
+
+      public:
+        /**
+         * @brief Map and index the file `path` (throws `std::runtime_error` if it is not a
+         * valid binary geometry file of this format version and byte order).
+         *
+         * @param[in] path The file name.
+         */
+        explicit BinaryReader(const std::string &path) : _file{path} {
+            const auto *base = this->_file.data();
+            const auto size = std::uint64_t(this->_file.size());
+            auto header = detail::FileHeader{};
+            if (size < sizeof header) {
+                detail::fail("truncated file");
+            }
+            std::memcpy(&header, base, sizeof header);
+            if (std::memcmp(header.magic, detail::file_magic, sizeof header.magic) != 0) {
+                detail::fail("not a recti binary file");
+            }
+            if (header.version != format_version) {
+                detail::fail("unsupported format version");
+            }
+            if (header.byte_order != detail::byte_order_mark) {
+                detail::fail("foreign byte order");
+            }
+            auto pos = std::uint64_t(sizeof header);
+            while (pos != size) {
+                auto section = detail::SectionHeader{};
+                if (size - pos < sizeof section) {
+                    detail::fail("truncated section header");
+                }
+                std::memcpy(&section, base + pos, sizeof section);
+                pos += sizeof section;
+                if (section.kind < std::uint32_t(Kind::points)
+                    || section.kind > std::uint32_t(Kind::polygon_set)) {
+                    detail::fail("unknown section kind");
+                }
+                if (section.payload_size > size - pos
+                    || detail::padded(section.payload_size) > size - pos) {
+                    detail::fail("truncated section");
+                }
+                if (section.payload_size != detail::payload_size(section, size - pos)) {
+                    detail::fail("section size does not match its records");
+                }
+                if (section.kind == std::uint32_t(Kind::polygon_set)) {
+                    detail::check_offsets(section, base + pos);
+                }
+                this->_sections.push_back(Section{Kind(section.kind), section.scalar,
+                                                  section.count, section.num_points, base + pos});
+                pos += detail::padded(section.payload_size);
+            }
+        }
+
+        /**
+         * @brief The number of sections.
+         *
+         * @return std::size_t
+         */
+        auto num_sections() const noexcept -> std::size_t { return this->_sections.size(); }
+
+        /**
+         * @brief The description of section `idx`.
+         *
+         * @param[in] idx The section index.
+         * @return const Section&
+         */
+        auto section(std::size_t idx) const -> const Section & { return this->_sections.at(idx); }
+
+        /**
+         * @brief The records of section `idx`, which must hold records of type `Rec`.
+         *
+         * @param[in] idx The section index.
+         * @return gsl::span<const Rec>
+         */
+        template <typename Rec> auto records(std::size_t idx) const -> gsl::span<const Rec> {
+            using Traits = record_traits<Rec>;
+            const auto &section = this->_section_of(
+                idx, Traits::kind, detail::scalar_code<typename Traits::coord_type>());
+            // the packed records have alignment 1, so any offset in the mapping will do
+            return gsl::span<const Rec>(reinterpret_cast<const Rec *>(section.payload),
+                                        std::size_t(section.count));
+        }
+
+        /**
+         * @brief The polygon set of section `idx`, with coordinates of type `T`.
+         *
+         * @param[in] idx The section index.
+         * @return PolygonSetView<T>
+         */
+        template <typename T> auto polygon_set(std::size_t idx) const -> PolygonSetView<T> {
+            const auto &section
+                = this->_section_of(idx, Kind::polygon_set, detail::scalar_code<T>());
+            const auto point_bytes = section.num_points * sizeof(Point<T>);
+            const auto *offsets = reinterpret_cast<const std::uint64_t *>(
+                section.payload + detail::padded(point_bytes));
+            const auto num_points = std::size_t(section.num_points);  // offsets checked on open
+            return PolygonSetView<T>(
+                gsl::span<const Point<T>>(reinterpret_cast<const Point<T> *>(section.payload),
+                                          num_points),
+                gsl::span<const std::uint64_t>(offsets, std::size_t(section.count) + 1));
+        }
+
+      private:
+        auto _section_of(std::size_t idx, Kind kind, std::uint32_t scalar) const
+            -> const Section & {
+            const auto &section = this->section(idx);
+            if (section.kind != kind || section.scalar != scalar) {
+                detail::fail("section holds another record type");
+            }
+            return section;
+        }
+    };
+
+}  // namespace recti::binary
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>  // for std::min
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint8_t, std::uint64_t
+#include <gsl/span>
+#include <type_traits>  // for std::is_integral_v
+#include <vector>
+
+#include "polygon_set.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @name Compressed geometry sequences
+     *
+     * Layouts are mostly regular rows and tracks, so consecutive shapes differ by small
+     * amounts. The containers below store each record as the difference to the previous one,
+     * zigzag-mapped (small negative numbers become small unsigned numbers) and written as a
+     * LEB128 varint: one byte per coordinate for steps below 64 units. The records are cut into
+     * blocks whose first record is coded against zero, so any block decodes on its own: a
+     * sequential decode costs a few shifts per coordinate, and a random access decodes at most
+     * one block.
+     *
+     * Only integral coordinates are supported. The differences are taken modulo 2^64, so every
+     * value of `T` (including the extremes of `std::int64_t`) round-trips exactly.
+     */
+    ///@{
+
+    namespace detail {
+        /// The difference `to - from` as a two's complement 64-bit word.
+        template <typename T> constexpr auto delta_of(T from, T to) noexcept -> std::uint64_t {
+            return std::uint64_t(to) - std::uint64_t(from);
+        }
+
+        /// `from` moved by a difference computed by `delta_of`.
+        template <typename T> constexpr auto apply_delta(T from, std::uint64_t delta) noexcept
+            -> T {
+            return T(std::uint64_t(from) + delta);
+        }
+
+        constexpr auto zigzag_encode(std::uint64_t delta) noexcept -> std::uint64_t {
+            return (delta << 1U) ^ (std::uint64_t{0} - (delta >> 63U));
+        }
+
+        constexpr auto zigzag_decode(std::uint64_t code) noexcept -> std::uint64_t {
+            return (code >> 1U) ^ (std::uint64_t{0} - (code & 1U));
+        }
+
+        inline auto put_varint(std::vector<std::uint8_t> &out, std::uint64_t value) -> void {
+            while (value >= 0x80U) {
+                out.push_back(std::uint8_t((value & 0x7FU) | 0x80U));
+                value >>= 7U;
+            }
+            out.push_back(std::uint8_t(value));
+        }
+
+        inline auto get_varint(const std::uint8_t *&ptr) noexcept -> std::uint64_t {
+            auto value = std::uint64_t{0};
+            auto shift = 0U;
+            for (;; shift += 7U) {
+                const auto byte = *ptr++;
+                value |= std::uint64_t(byte & 0x7FU) << shift;
+                if ((byte & 0x80U) == 0) {
+                    return value;
+                }
+            }
+        }
+
+        template <typename T>
+        inline auto put_delta(std::vector<std::uint8_t> &out, T from, T to) -> void {
+            put_varint(out, zigzag_encode(delta_of(from, to)));
+        }
+
+        template <typename T> inline auto get_delta(const std::uint8_t *&ptr, T from) -> T {
+            return apply_delta(from, zigzag_decode(get_varint(ptr)));
+        }
+    }  // namespace detail
+
+    /**
+     * @brief How a record type is delta coded, for `CompressedSequence`.
+     *
+     * A codec provides `initial()`, the record every block is coded against, and
+     * `encode(prev, rec, out)` / `decode(prev, ptr)`, which write and read `rec` as the
+     * difference to the record `prev` before it. Specialize it to store other record types.
+     */
+    template <typename Rec> struct delta_codec;
+
+    /// Points: the x and y steps.
+    template <typename T> struct delta_codec<Point<T>> {
+        static_assert(std::is_integral_v<T>, "delta coding needs integral coordinates");
+
+        static constexpr auto initial() noexcept -> Point<T> { return Point<T>{T(0), T(0)}; }
+
+        static auto encode(const Point<T> &prev, const Point<T> &pt, std::vector<std::uint8_t> &out)
+            -> void {
+            detail::put_delta(out, prev.xcoord(), pt.xcoord());
+            detail::put_delta(out, prev.ycoord(), pt.ycoord());
+        }
+
+        static auto decode(const Point<T> &prev, const std::uint8_t *&ptr) -> Point<T> {
+            const auto xcoord = detail::get_delta(ptr, prev.xcoord());
+            const auto ycoord = detail::get_delta(ptr, prev.ycoord());
+            return Point<T>{xcoord, ycoord};
+        }
+    };
+
+    /// Rectangles: the steps of the lower-left corner, then the changes of width and height
+    /// (all zero along a row of equal cells).
+    template <typename T> struct delta_codec<Rectangle<T>> {
+        static_assert(std::is_integral_v<T>, "delta coding needs integral coordinates");
+
+        static constexpr auto initial() noexcept -> Rectangle<T> {
+            return Rectangle<T>{Interval<T>{T(0), T(0)}, Interval<T>{T(0), T(0)}};
+        }
+
+        static auto encode(const Rectangle<T> &prev, const Rectangle<T> &rect,
+                           std::vector<std::uint8_t> &out) -> void {
+            detail::put_delta(out, prev.xcoord().lb(), rect.xcoord().lb());
+            detail::put_delta(out, prev.ycoord().lb(), rect.ycoord().lb());
+            detail::put_delta(out, detail::delta_of(prev.xcoord().lb(), prev.xcoord().ub()),
+                              detail::delta_of(rect.xcoord().lb(), rect.xcoord().ub()));
+            detail::put_delta(out, detail::delta_of(prev.ycoord().lb(), prev.ycoord().ub()),
+                              detail::delta_of(rect.ycoord().lb(), rect.ycoord().ub()));
+        }
+
+        static auto decode(const Rectangle<T> &prev, const std::uint8_t *&ptr) -> Rectangle<T> {
+            const auto xlb = detail::get_delta(ptr, prev.xcoord().lb());
+            const auto ylb = detail::get_delta(ptr, prev.ycoord().lb());
+            const auto width
+                = detail::get_delta(ptr, detail::delta_of(prev.xcoord().lb(), prev.xcoord().ub()));
+            const auto height
+                = detail::get_delta(ptr, detail::delta_of(prev.ycoord().lb(), prev.ycoord().ub()));
+            return Rectangle<T>{Interval<T>{xlb, detail::apply_delta(xlb, width)},
+                                Interval<T>{ylb, detail::apply_delta(ylb, height)}};
+        }
+    };
+
+    /**
+     * @brief Compressed Sequence of points or rectangles
+     *
+     * An append-only sequence of records stored as delta-coded varints in blocks of
+     * `block_size()` records (see `delta_codec`). `for_each` and `decode` stream through the
+     * whole sequence; `operator[]` and `decode_block` decode a single block.
+     *
+     * @tparam Rec The record type (`Point<T>` or `Rectangle<T>` with an integral `T`).
+     */
+    template <typename Rec> class CompressedSequence {
+        using Codec = delta_codec<Rec>;
+
+        std::vector<std::uint8_t> _bytes;
+        std::vector<std::size_t> _block_starts;  // byte offset of each block
+        std::size_t _block_size;
+        std::size_t _size{0};
+        Rec _last = Codec::initial();  // the record the next one is coded against
+
+      public:
+        using value_type = Rec;
+
+        /**
+         * @brief Construct an empty sequence.
+         *
+         * @param[in] block_size The number of records per block (the cost of a random access).
+         */
+        explicit CompressedSequence(std::size_t block_size = 64) : _block_size{block_size} {
+            assert(block_size > 0);
+        }
+
+        /**
+         * @brief Construct a sequence holding `records`.
+         *
+         * @param[in] records The records.
+         * @param[in] block_size The number of records per block.
+         */
+        explicit CompressedSequence(gsl::span<const Rec> records, std::size_t block_size = 64)
+            : CompressedSequence(block_size) {
+            for (const auto &rec : records) {
+                this->push_back(rec);
+            }
+        }
+
+        /**
+         * @brief Append a record.
+         *
+         * @param[in] rec The record.
+         */
+        auto push_back(const Rec &rec) -> void {
+            if (this->_size % this->_block_size == 0) {
+                this->_block_starts.push_back(this->_bytes.size());
+                this->_last = Codec::initial();
+            }
+            Codec::encode(this->_last, rec, this->_bytes);
+            this->_last = rec;
+            ++this->_size;
+        }
+
+        /**
+         * @brief Release the spare capacity of the buffers.
+         */
+        auto shrink_to_fit() -> void {
+            this->_bytes.shrink_to_fit();
+            this->_block_starts.shrink_to_fit();
+        }
+
+        auto size() const noexcept -> std::size_t { return this->_size; }
+        auto empty() const noexcept -> bool { return this->_size == 0; }
+        auto block_size() const noexcept -> std::size_t { return this->_block_size; }
+        auto num_blocks() const noexcept -> std::size_t { return this->_block_starts.size(); }
+
+        /**
+         * @brief The size of the encoded data and the block index, in bytes.
+         *
+         * @return std::size_t
+         */
+        auto compressed_bytes() const noexcept -> std::size_t {
+            return this->_bytes.size() + this->_block_starts.size() * sizeof(std::size_t);
+        }
+
+        /**
+         * @brief Record `idx` (decodes its block up to it).
+         *
+         * @param[in] idx The record index.
+         * @return Rec
+         */
+        auto operator[](std::size_t idx) const -> Rec {
+            assert(idx < this->_size);
+            const auto block = idx / this->_block_size;
+            const auto *ptr = this->_bytes.data() + this->_block_starts[block];
+            auto rec = Codec::decode(Codec::initial(), ptr);
+            for (auto pos = block * this->_block_size; pos != idx; ++pos) {
+                rec = Codec::decode(rec, ptr);
+            }
+            return rec;
+        }
+
+        /**
+         * @brief Append the records of one block to `out`.
+         *
+         * @param[in] block The block index.
+         * @param[in,out] out The output records.
+         */
+        auto decode_block(std::size_t block, std::vector<Rec> &out) const -> void {
+            assert(block < this->num_blocks());
+            const auto first = block * this->_block_size;
+            const auto last = std::min(first + this->_block_size, this->_size);
+            const auto *ptr = this->_bytes.data() + this->_block_starts[block];
+            auto rec = Codec::initial();
+            for (auto pos = first; pos != last; ++pos) {
+                rec = Codec::decode(rec, ptr);
+                out.push_back(rec);
+            }
+        }
+
+        /**
+         * @brief Call `fn(rec)` for every record, in order.
+         *
+         * @tparam Fn The callable type.
+         * @param[in] fn The callable.
+         */
+        template <typename Fn> auto for_each(Fn &&fn) const -> void {
+            const auto *ptr = this->_bytes.data();
+            auto rec = Codec::initial();
+            for (auto pos = std::size_t{0}; pos != this->_size; ++pos) {
+                if (pos % this->_block_size == 0) {
+                    rec = Codec::initial();
+                }
+                rec = Codec::decode(rec, ptr);
+                fn(rec);
+            }
+        }
+
+        /**
+         * @brief Decode the whole sequence.
+         *
+         * @return std::vector<Rec>
+         */
+        auto decode() const -> std::vector<Rec> {
+            auto out = std::vector<Rec>{};
+            out.reserve(this->_size);
+            this->for_each([&out](const Rec &rec) { out.push_back(rec); });
+            return out;
+        }
+    };
+
+    /**
+     * @brief Compressed Polygon Set
+     *
+     * The compressed counterpart of `PolygonSet`: each polygon is stored as its vertex count,
+     * the step from the first vertex of the previous polygon to its own first vertex, and the
+     * steps between consecutive vertices, all as zigzag varints. The polygons are cut into
+     * blocks of `block_size()` polygons for random access.
+     *
+     * @tparam T The coordinate type (integral).
+     */
+    template <typename T> class CompressedPolygonSet {
+        static_assert(std::is_integral_v<T>, "CompressedPolygonSet needs integral coordinates");
+
+        using Codec = delta_codec<Point<T>>;
+
+        std::vector<std::uint8_t> _bytes;
+        std::vector<std::size_t> _block_starts;  // byte offset of each block
+        std::size_t _block_size;
+        std::size_t _size{0};
+        std::size_t _num_points{0};
+        Point<T> _last_first = Codec::initial();  // first vertex of the previous polygon
+
+        // decodes one polygon at `ptr`, appending its vertices to `out`
+        static auto _decode(const std::uint8_t *&ptr, Point<T> &first, std::vector<Point<T>> &out)
+            -> void {
+            const auto num = std::size_t(detail::get_varint(ptr));
+            if (num == 0) {
+                return;
+            }
+            first = Codec::decode(first, ptr);
+            auto prev = first;
+            out.push_back(prev);
+            for (auto idx = std::size_t{1}; idx != num; ++idx) {
+                prev = Codec::decode(prev, ptr);
+                out.push_back(prev);
+            }
+        }
+
+      public:
+        /**
+         * @brief Construct an empty set.
+         *
+         * @param[in] block_size The number of polygons per block.
+         */
+        explicit CompressedPolygonSet(std::size_t block_size = 16) : _block_size{block_size} {
+            assert(block_size > 0);
+        }
+
+        /**
+         * @brief Construct a compressed copy of a polygon set.
+         *
+         * @param[in] set The polygon set.
+         * @param[in] block_size The number of polygons per block.
+         */
+        template <typename Alloc>
+        explicit CompressedPolygonSet(const PolygonSet<T, Alloc> &set, std::size_t block_size = 16)
+            : CompressedPolygonSet(block_size) {
+            for (auto idx = std::size_t{0}; idx != set.size(); ++idx) {
+                this->push_back(set[idx]);
+            }
+        }
+
+        /**
+         * @brief Append a polygon given by its vertices.
+         *
+         * @param[in] pointset The vertices of the polygon.
+         */
+        auto push_back(gsl::span<const Point<T>> pointset) -> void {
+            if (this->_size % this->_block_size == 0) {
+                this->_block_starts.push_back(this->_bytes.size());
+                this->_last_first = Codec::initial();
+            }
+            detail::put_varint(this->_bytes, pointset.size());
+            if (!pointset.empty()) {
+                Codec::encode(this->_last_first, pointset.front(), this->_bytes);
+                for (auto idx = std::size_t{1}; idx != pointset.size(); ++idx) {
+                    Codec::encode(pointset[idx - 1], pointset[idx], this->_bytes);
+                }
+                this->_last_first = pointset.front();
+            }
+            ++this->_size;
+            this->_num_points += pointset.size();
+        }
+
+        /**
+         * @brief Release the spare capacity of the buffers.
+         */
+        auto shrink_to_fit() -> void {
+            this->_bytes.shrink_to_fit();
+            this->_block_starts.shrink_to_fit();
+        }
+
+        auto size() const noexcept -> std::size_t { return this->_size; }
+        auto empty() const noexcept -> bool { return this->_size == 0; }
+        auto num_points() const noexcept -> std::size_t { return this->_num_points; }
+        auto block_size() const noexcept -> std::size_t { return this->_block_size; }
+
+        /**
+         * @brief The size of the encoded data and the block index, in bytes.
+         *
+         * @return std::size_t
+         */
+        auto compressed_bytes() const noexcept -> std::size_t {
+            return this->_bytes.size() + this->_block_starts.size() * sizeof(std::size_t);
+        }
+
+        /**
+         * @brief The vertices of polygon `idx` (decodes its block up to it).
+         *
+         * @param[in] idx The polygon index.
+         * @param[out] out The vertices (cleared first, so the buffer can be reused).
+         */
+        auto polygon(std::size_t idx, std::vector<Point<T>> &out) const -> void {
+            assert(idx < this->_size);
+            const auto block = idx / this->_block_size;
+            const auto *ptr = this->_bytes.data() + this->_block_starts[block];
+            auto first = Codec::initial();
+            for (auto pos = block * this->_block_size;; ++pos) {
+                out.clear();
+                _decode(ptr, first, out);
+                if (pos == idx) {
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Call `fn(pointset)` with the vertices (`gsl::span<const Point<T>>`) of every
+         * polygon, in order. The span is only valid during the call.
+         *
+         * @tparam Fn The callable type.
+         * @param[in] fn The callable.
+         */
+        template <typename Fn> auto for_each(Fn &&fn) const -> void {
+            const auto *ptr = this->_bytes.data();
+            auto first = Codec::initial();
+            auto buffer = std::vector<Point<T>>{};
+            for (auto pos = std::size_t{0}; pos != this->_size; ++pos) {
+                if (pos % this->_block_size == 0) {
+                    first = Codec::initial();
+                }
+                buffer.clear();
+                _decode(ptr, first, buffer);
+                fn(gsl::span<const Point<T>>(buffer));
+            }
+        }
+
+        /**
+         * @brief Decode into a normal polygon set.
+         *
+         * @return PolygonSet<T>
+         */
+        auto decode() const -> PolygonSet<T> {
+            auto set = PolygonSet<T>{};
+            set.reserve(this->_size, this->_num_points);
+            this->for_each([&set](gsl::span<const Point<T>> pointset) { set.push_back(pointset); });
+            return set;
+        }
+    };
+
+    ///@}
+
+}  // namespace recti
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::max, std::min
+#include <cmath>      // for std::sqrt, std::ceil
+#include <cstddef>    // for std::size_t
+#include <gsl/span>
+#include <tuple>    // for std::tuple
+#include <utility>  // for std::move
+#include <vector>
+
+#include "dme.hpp"
+#include "instrument.hpp"
+#include "parallel.hpp"
+
+namespace recti {
+
+    namespace detail {
+        /**
+         * @brief Uniform bucket grid over the centers of merging regions (rotated space).
+         *
+         * Built once per matching round by a counting sort; `items()` lists the slots of each
+         * cell contiguously, so a ring search touches only a few cache lines.
+         */
+        template <typename T> class CenterGrid {
+            T _u0{}, _v0{};
+            T _cell{1};
+            std::size_t _cols{1}, _rows{1};
+            std::vector<std::size_t> _starts{};
+            std::vector<std::size_t> _items{};
+
+          public:
+            CenterGrid(gsl::span<const Point<T>> centers) {
+                const auto num = centers.size();
+                auto u_min = centers[0].xcoord(), u_max = u_min;
+                auto v_min = centers[0].ycoord(), v_max = v_min;
+                for (const auto &ctr : centers) {
+                    u_min = std::min(u_min, ctr.xcoord());
+                    u_max = std::max(u_max, ctr.xcoord());
+                    v_min = std::min(v_min, ctr.ycoord());
+                    v_max = std::max(v_max, ctr.ycoord());
+                }
+                // about two centers per cell
+                const auto per_axis = std::size_t(std::ceil(std::sqrt(double(num) / 2.0)));
+                const auto span = std::max(T(u_max - u_min), T(v_max - v_min));
+                this->_u0 = u_min;
+                this->_v0 = v_min;
+                this->_cell = T(span / T(std::max(per_axis, std::size_t{1})) + 1);
+                this->_cols = std::size_t((u_max - u_min) / this->_cell) + 1;
+                this->_rows = std::size_t((v_max - v_min) / this->_cell) + 1;
+                this->_starts.assign(this->_cols * this->_rows + 1, 0);
+                for (const auto &ctr : centers) {
+                    ++this->_starts[this->cell_of(ctr) + 1];
+                }
+                for (auto idx = std::size_t{1}; idx != this->_starts.size(); ++idx) {
+                    this->_starts[idx] += this->_starts[idx - 1];
+                }
+                this->_items.resize(num);
+                auto fill = this->_starts;
+                for (auto slot = std::size_t{0}; slot != num; ++slot) {
+                    this->_items[fill[this->cell_of(centers[slot])]++] = slot;
+                }
+            }
+
+            auto cell(T coord, T origin) const -> std::size_t {
+                return std::size_t((coord - origin) / this->_cell);
+            }
+
+            auto cell_of(const Point<T> &ctr) const -> std::size_t {
+                return this->cell(ctr.ycoord(), this->_v0) * this->_cols
+                       + this->cell(ctr.xcoord(), this->_u0);
+            }
+
+            auto cell_size() const -> T { return this->_cell; }
+            auto cols() const -> std::size_t { return this->_cols; }
+            auto rows() const -> std::size_t { return this->_rows; }
+            auto col_of(const Point<T> &ctr) const { return this->cell(ctr.xcoord(), this->_u0); }
+            auto row_of(const Point<T> &ctr) const { return this->cell(ctr.ycoord(), this->_v0); }
+
+            auto items(std::size_t col, std::size_t row) const -> gsl::span<const std::size_t> {
+                const auto idx = row * this->_cols + col;
+                return gsl::span<const std::size_t>(this->_items)
+                    .subspan(this->_starts[idx], this->_starts[idx + 1] - this->_starts[idx]);
+            }
+        };
+    }  // namespace detail
+
+    /**
+     * @brief Greedy-matching clock tree topology
+     *
+     * Builds a bottom-up topology for zero-skew DME by repeated greedy matching: in every round,
+     * each unmatched subtree finds its nearest neighbour by `MergeObj::min_dist_with` (the
+     * Chebyshev distance in the 45-degree rotated space), the candidate pairs are taken in
+     * increasing order of distance as long as both ends are still free, and each chosen pair
+     * is merged (with `DmeTree<T>::merge`) into a new subtree for the next round.
+     *
+     * The nearest-neighbour queries go through a uniform bucket grid over the region centers,
+     * rebuilt each round in O(n), and stop as soon as the next ring of cells cannot hold a
+     * closer region. A round is therefore close to O(n log n) (dominated by sorting the
+     * candidate pairs) rather than O(n^2). The queries within a round are independent and
+     * run on `num_threads` threads; the result does not depend on the thread count.
+     *
+     * Reference:
+     *  - M. Edahiro, "A clustering-based optimization algorithm in zero-skew routings,"
+     * 30th ACM/IEEE Design Automation Conference, 1993, pp. 612-616.
+     *
+     * @tparam T The coordinate type.
+     * @param[in] sinks The sink locations.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return ClockTopology over the sinks (sink `i` is leaf `i`).
+     */
+    template <typename T>
+    auto greedy_matching_topology(gsl::span<const Point<T>> sinks, unsigned num_threads = 1)
+        -> ClockTopology {
+        RECTI_TIME_SCOPE(cts_topology);
+        using Region = typename DmeTree<T>::Region;
+        constexpr auto npos = ~std::size_t{0};
+
+        auto topo = ClockTopology{sinks.size(), {}};
+        if (sinks.empty()) {
+            return topo;
+        }
+        topo.children.reserve(sinks.size() - 1);
+        auto regions = std::vector<Region>{};
+        auto delays = std::vector<T>(sinks.size(), T(0));
+        regions.reserve(2 * sinks.size() - 1);
+        for (const auto &sink : sinks) {
+            regions.push_back(DmeTree<T>::to_region(sink));
+        }
+
+        auto active = std::vector<std::size_t>(sinks.size());
+        for (auto idx = std::size_t{0}; idx != active.size(); ++idx) {
+            active[idx] = idx;
+        }
+        auto centers = std::vector<Point<T>>{};
+        auto extents = std::vector<T>{};
+        auto nearest = std::vector<std::size_t>{};
+        auto nearest_dist = std::vector<T>{};
+        auto pairs = std::vector<std::tuple<T, std::size_t, std::size_t>>{};
+        auto matched = std::vector<char>{};
+
+        while (active.size() > 1) {
+            const auto num = active.size();
+            centers.clear();
+            extents.clear();
+            auto max_extent = T(0);
+            for (auto node : active) {
+                const auto &reg = regions[node];
+                centers.emplace_back(T((reg.xcoord().lb() + reg.xcoord().ub()) / 2),
+                                     T((reg.ycoord().lb() + reg.ycoord().ub()) / 2));
+                // distance from the center to the farthest point of the region (rounded up)
+                const auto diameter = std::max(reg.xcoord().length(), reg.ycoord().length());
+                extents.push_back(T(diameter / 2 + 1));
+                max_extent = std::max(max_extent, extents.back());
+            }
+            const auto grid = detail::CenterGrid<T>(centers);
+
+            nearest.assign(num, npos);
+            nearest_dist.assign(num, T(0));
+            auto search = [&](std::size_t slot) {
+                const auto &reg = regions[active[slot]];
+                const auto col = grid.col_of(centers[slot]);
+                const auto row = grid.row_of(centers[slot]);
+                const auto slack = T(extents[slot] + max_extent);
+                const auto max_ring = std::max(grid.cols(), grid.rows());
+                auto best = npos;
+                auto best_dist = T(0);
+                auto consider = [&](std::size_t cand) {
+                    if (cand == slot) {
+                        return;
+                    }
+                    const T dist = reg.min_dist_with(regions[active[cand]]);
+                    if (best == npos || dist < best_dist || (dist == best_dist && cand < best)) {
+                        best = cand;
+                        best_dist = dist;
+                    }
+                };
+                for (auto ring = std::size_t{0}; ring <= max_ring; ++ring) {
+                    // every center in this ring is at least (ring - 1) cells away
+                    if (best != npos && ring >= 1
+                        && T(ring - 1) * grid.cell_size() > T(best_dist + slack)) {
+                        break;
+                    }
+                    const auto c_lo = col >= ring ? col - ring : std::size_t{0};
+                    const auto c_hi = std::min(col + ring, grid.cols() - 1);
+                    const auto r_lo = row >= ring ? row - ring : std::size_t{0};
+                    const auto r_hi = std::min(row + ring, grid.rows() - 1);
+                    for (auto r_i = r_lo; r_i <= r_hi; ++r_i) {
+                        const auto on_edge = r_i + ring == row || r_i == row + ring;
+                        for (auto c_i = c_lo; c_i <= c_hi; ++c_i) {
+                            if (!on_edge && c_i + ring != col && c_i != col + ring) {
+                                continue;  // interior of the ring, visited before
+                            }
+                            for (auto cand : grid.items(c_i, r_i)) {
+                                consider(cand);
+                            }
+                        }
+                    }
+                }
+                nearest[slot] = best;
+                nearest_dist[slot] = best_dist;
+            };
+            parallel_for(std::size_t{0}, num, search, num_threads, 512);
+
+            pairs.clear();
+            for (auto slot = std::size_t{0}; slot != num; ++slot) {
+                const auto other = nearest[slot];
+                if (nearest[other] == slot && other < slot) {
+                    continue;  // mutual pair, already listed
+                }
+                pairs.emplace_back(nearest_dist[slot], std::min(slot, other),
+                                   std::max(slot, other));
+            }
+            std::sort(pairs.begin(), pairs.end());
+
+            matched.assign(num, 0);
+            auto next = std::vector<std::size_t>{};
+            next.reserve(num / 2 + 1);
+            for (const auto &[dist, slot_a, slot_b] : pairs) {
+                if (matched[slot_a] != 0 || matched[slot_b] != 0) {
+                    continue;
+                }
+                matched[slot_a] = matched[slot_b] = 1;
+                const auto left = active[slot_a];
+                const auto right = active[slot_b];
+                auto merged = DmeTree<T>::merge(regions[left], delays[left], regions[right],
+                                                delays[right]);
+                regions.push_back(std::move(merged.region));
+                delays.push_back(merged.delay);
+                topo.children.emplace_back(left, right);
+                next.push_back(topo.num_nodes() - 1);
+            }
+            for (auto slot = std::size_t{0}; slot != num; ++slot) {
+                if (matched[slot] == 0) {
+                    next.push_back(active[slot]);
+                }
+            }
+            active = std::move(next);
+        }
+        return topo;
+    }
+
+}  // namespace recti
@@ -0,0 +1,772 @@
+#pragma once
+
+#include <algorithm>  // for std::min, std::max
+#include <charconv>   // for std::from_chars
+#include <cmath>      // for std::llround
+#include <condition_variable>
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint8_t
+#include <cstring>  // for std::memmove
+#include <exception>  // for std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <istream>
+#include <mutex>
+#include <stdexcept>  // for std::runtime_error
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>  // for std::swap, std::as_const
+#include <vector>
+
+#include "polygon_set.hpp"
+#include "recti.hpp"
+
+namespace recti::def {
+
+    /**
+     * @brief Streaming reader of the geometric subset of DEF (and of LEF macro sizes)
+     *
+     * `DefReader` reads the input in fixed-size chunks and turns the DIEAREA, the placed
+     * COMPONENTS (sized by the LEF macros), the PINS and the BLOCKAGES of a DEF file into
+     * batches of `Rectangle<T>` and of rectilinear polygons in the point-list convention of
+     * `RPolygon<T>` (from each point, horizontally then vertically to the next one). A batch
+     * is cleared and refilled by every `read()`, so its buffers are reused. All other
+     * statements and sections (NETS, SPECIALNETS, VIAS, ...) are skipped. Coordinates are in
+     * database units.
+     *
+     * `read_def()` hands the batches to a consumer in turn; `read_def_pipelined()` parses the
+     * next batch on a worker thread while the consumer processes the current one.
+     */
+
+    /// The sizes (in microns) of the LEF macros, by name.
+    using MacroSizes = std::unordered_map<std::string, Vector2<double>>;
+
+    /// What a shape comes from.
+    enum class ShapeKind : std::uint8_t { die_area, component, pin, blockage };
+
+    /**
+     * @brief A batch of shapes.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> struct ShapeBatch {
+        std::vector<Rectangle<T>> rects;
+        std::vector<ShapeKind> rect_kinds;
+        PolygonSet<T> rpolygons;  // point lists of rectilinear polygons, see `RPolygon<T>`
+        std::vector<ShapeKind> rpolygon_kinds;
+
+        /**
+         * @brief The number of shapes.
+         *
+         * @return std::size_t
+         */
+        auto size() const noexcept -> std::size_t {
+            return this->rects.size() + this->rpolygons.size();
+        }
+
+        auto empty() const noexcept -> bool { return this->size() == 0; }
+
+        /**
+         * @brief Remove all shapes (the capacity is kept).
+         */
+        auto clear() noexcept -> void {
+            this->rects.clear();
+            this->rect_kinds.clear();
+            this->rpolygons.clear();
+            this->rpolygon_kinds.clear();
+        }
+    };
+
+    namespace detail {
+        [[noreturn]] inline auto fail(std::size_t line, const std::string &what) -> void {
+            throw std::runtime_error("recti::def: line " + std::to_string(line) + ": " + what);
+        }
+
+        /**
+         * @brief Whitespace-separated tokens of LEF/DEF, read in chunks.
+         *
+         * Comments (`#` to the end of the line) are dropped and a double-quoted string is one
+         * token. A token is a view into the chunk buffer, valid until the next `next()`.
+         */
+        class Tokenizer {
+            std::istream &_input;
+            std::vector<char> _buffer;
+            std::size_t _pos{0};
+            std::size_t _end{0};
+            std::size_t _last{0};  // the start of the last token, for `unget()`
+            std::size_t _line{1};
+
+          public:
+            explicit Tokenizer(std::istream &input, std::size_t chunk_size = std::size_t{1} << 16)
+                : _input{input}, _buffer(chunk_size < 16 ? 16 : chunk_size) {}
+
+            /**
+             * @brief The next token, or an empty view at the end of the input.
+             *
+             * @return std::string_view
+             */
+            auto next() -> std::string_view {
+                for (;;) {  // skip whitespace and comments
+                    if (this->_pos == this->_end && !this->_refill(this->_pos)) {
+                        return {};
+                    }
+                    const auto chr = this->_buffer[this->_pos];
+                    if (chr == '#') {
+                        while (this->_buffer[this->_pos] != '\n') {
+                            if (++this->_pos == this->_end && !this->_refill(this->_pos)) {
+                                return {};
+                            }
+                        }
+                    } else if (_is_space(chr)) {
+                        this->_line += std::size_t(chr == '\n');
+                        ++this->_pos;
+                    } else {
+                        break;
+                    }
+                }
+                auto start = this->_pos;
+                const auto quoted = this->_buffer[start] == '"';
+                auto idx = start + 1;
+                for (;; ++idx) {
+                    if (idx == this->_end) {
+                        const auto shift = start;
+                        const auto more = this->_refill(start);
+                        start -= shift;
+                        idx -= shift;
+                        if (!more) {
+                            break;
+                        }
+                    }
+                    const auto chr = this->_buffer[idx];
+                    if (quoted ? chr == '"' : _is_space(chr)) {
+                        idx += std::size_t(quoted);
+                        break;
+                    }
+                }
+                this->_last = start;
+                this->_pos = idx;
+                return std::string_view(this->_buffer.data() + start, idx - start);
+            }
+
+            /**
+             * @brief Push the last token back, to be returned by the next `next()`.
+             */
+            auto unget() noexcept -> void { this->_pos = this->_last; }
+
+            /**
+             * @brief The current line number, for error messages.
+             *
+             * @return std::size_t
+             */
+            auto line() const noexcept -> std::size_t { return this->_line; }
+
+          private:
+            static constexpr auto _is_space(char chr) -> bool {
+                return chr == ' ' || chr == '\n' || chr == '\t' || chr == '\r' || chr == '\f'
+                       || chr == '\v';
+            }
+
+            // drop the buffer before `keep` and read another chunk behind the rest
+            auto _refill(std::size_t keep) -> bool {
+                std::memmove(this->_buffer.data(), this->_buffer.data() + keep, this->_end - keep);
+                this->_end -= keep;
+                this->_pos -= keep;
+                this->_last = 0;
+                if (this->_end == this->_buffer.size()) {  // a token longer than the buffer
+                    this->_buffer.resize(2 * this->_buffer.size());
+                }
+                this->_input.read(this->_buffer.data() + this->_end,
+                                  std::streamsize(this->_buffer.size() - this->_end));
+                const auto count = std::size_t(this->_input.gcount());
+                this->_end += count;
+                return count != 0;
+            }
+        };
+
+        /**
+         * @brief Append a rectilinear polygon given by all its vertices, in the point-list
+         * convention of `RPolygon<T>` (only the vertices that start a horizontal edge).
+         *
+         * Repeated and collinear vertices are dropped first; the edges must then be axis
+         * parallel.
+         *
+         * @param[out] out The polygon set.
+         * @param[in,out] verts The vertices, used as scratch space.
+         * @return false if the polygon is not rectilinear.
+         */
+        template <typename T>
+        auto append_rpolygon(PolygonSet<T> &out, std::vector<Point<T>> &verts) -> bool {
+            auto num = std::size_t{0};
+            for (const auto &vtx : verts) {
+                if (num == 0 || !(verts[num - 1] == vtx)) {
+                    verts[num++] = vtx;
+                }
+            }
+            while (num > 1 && verts[0] == verts[num - 1]) {
+                --num;
+            }
+            for (auto changed = true; changed && num >= 3;) {
+                changed = false;
+                auto kept = std::size_t{0};
+                for (auto idx = std::size_t{0}; idx != num; ++idx) {
+                    const auto &prev = kept == 0 ? verts[num - 1] : verts[kept - 1];
+                    const auto &vtx = verts[idx];
+                    const auto &next = verts[(idx + 1) % num];
+                    if ((prev.xcoord() == vtx.xcoord() && vtx.xcoord() == next.xcoord())
+                        || (prev.ycoord() == vtx.ycoord() && vtx.ycoord() == next.ycoord())) {
+                        changed = true;
+                        continue;
+                    }
+                    verts[kept++] = vtx;
+                }
+                num = kept;
+            }
+            if (num < 4 || num % 2 != 0) {
+                return false;
+            }
+            auto start = num;
+            for (auto idx = std::size_t{0}; idx != num; ++idx) {
+                const auto &vtx = verts[idx];
+                const auto &next = verts[(idx + 1) % num];
+                const auto horizontal = vtx.ycoord() == next.ycoord();
+                if (!horizontal && vtx.xcoord() != next.xcoord()) {
+                    return false;
+                }
+                if (horizontal && start == num) {
+                    start = idx;
+                }
+            }
+            // the edges alternate, so every other vertex starts a horizontal edge
+            auto kept = std::size_t{0};
+            for (auto idx = start % 2; idx < num; idx += 2) {
+                verts[kept++] = verts[idx];
+            }
+            out.push_back(verts.begin(), verts.begin() + std::ptrdiff_t(kept));
+            return true;
+        }
+    }  // namespace detail
+
+    /// The orientations of DEF placements.
+    enum class Orient : std::uint8_t { N, W, S, E, FN, FW, FS, FE };
+
+    /**
+     * @brief Transform a point by an orientation, about the origin.
+     *
+     * @param[in] orient The orientation.
+     * @param[in] pt The point.
+     * @return Point<T>
+     */
+    template <typename T> constexpr auto orient_point(Orient orient, const Point<T> &pt)
+        -> Point<T> {
+        const auto &x = pt.xcoord();
+        const auto &y = pt.ycoord();
+        switch (orient) {
+            case Orient::N:
+                return Point<T>{x, y};
+            case Orient::W:
+                return Point<T>{T(-y), x};
+            case Orient::S:
+                return Point<T>{T(-x), T(-y)};
+            case Orient::E:
+                return Point<T>{y, T(-x)};
+            case Orient::FN:
+                return Point<T>{T(-x), y};
+            case Orient::FW:
+                return Point<T>{T(-y), T(-x)};
+            case Orient::FS:
+                return Point<T>{x, T(-y)};
+            case Orient::FE:
+                return Point<T>{y, x};
+        }
+        return pt;
+    }
+
+    /**
+     * @brief Read the macro sizes (`MACRO name ... SIZE w BY h ; ... END name`) of a LEF file.
+     *
+     * @param[in] input The LEF input.
+     * @return MacroSizes The sizes in microns.
+     */
+    inline auto read_lef_macro_sizes(std::istream &input) -> MacroSizes {
+        auto tokens = detail::Tokenizer(input);
+        auto number = [&tokens](std::string_view tok) {
+            auto val = 0.0;
+            const auto res = std::from_chars(tok.data(), tok.data() + tok.size(), val);
+            if (res.ec != std::errc{} || res.ptr != tok.data() + tok.size()) {
+                detail::fail(tokens.line(), "number expected, got '" + std::string(tok) + "'");
+            }
+            return val;
+        };
+        auto sizes = MacroSizes{};
+        for (auto tok = tokens.next(); !tok.empty(); tok = tokens.next()) {
+            if (tok != "MACRO") {
+                continue;
+            }
+            const auto name = std::string(tokens.next());
+            for (tok = tokens.next(); !tok.empty(); tok = tokens.next()) {
+                if (tok == "SIZE") {
+                    const auto width = number(tokens.next());
+                    if (tokens.next() != "BY") {
+                        detail::fail(tokens.line(), "SIZE w BY h expected");
+                    }
+                    const auto height = number(tokens.next());
+                    sizes.insert_or_assign(name, Vector2<double>{width, height});
+                } else if (tok == "END") {
+                    // `END name` closes the macro; a bare `END` closes an OBS or PORT block
+                    if (tokens.next() == name) {
+                        break;
+                    }
+                    tokens.unget();
+                }
+            }
+        }
+        return sizes;
+    }
+
+    /**
+     * @brief Streaming reader of the geometric subset of a DEF file (see above).
+     *
+     * @tparam T The (integral) coordinate type.
+     */
+    template <typename T> class DefReader {
+        enum class Section : std::uint8_t { top, components, pins, blockages };
+
+        detail::Tokenizer _tokens;
+        const MacroSizes *_macros;
+        Section _section{Section::top};
+        bool _done{false};
+        long long _dbu{0};
+        std::string _name;  // scratch for the macro lookup
+        std::vector<Point<T>> _verts;
+        ShapeBatch<T> _port;  // the shapes of the current pin port, before placement
+
+      public:
+        /**
+         * @brief Construct a reader of `input`.
+         *
+         * @param[in] input The DEF input, which must outlive the reader.
+         * @param[in] macros The LEF macro sizes for the components (none if null).
+         * @param[in] chunk_size The number of bytes read at a time.
+         */
+        explicit DefReader(std::istream &input, const MacroSizes *macros = nullptr,
+                           std::size_t chunk_size = std::size_t{1} << 16)
+            : _tokens{input, chunk_size}, _macros{macros} {}
+
+        /**
+         * @brief The database units per micron (`UNITS DISTANCE MICRONS`), 0 if not read yet.
+         *
+         * @return long long
+         */
+        auto dbu() const noexcept -> long long { return this->_dbu; }
+
+        /**
+         * @brief Clear `batch` and fill it with the next shapes.
+         *
+         * Whole statements are read until the batch holds at least `max_shapes` shapes or
+         * the input ends. Throws `std::runtime_error` on malformed input.
+         *
+         * @param[out] batch The batch.
+         * @param[in] max_shapes The batch size.
+         * @return false if there are no shapes left.
+         */
+        auto read(ShapeBatch<T> &batch, std::size_t max_shapes = 4096) -> bool {
+            batch.clear();
+            while (batch.size() < max_shapes && !this->_done) {
+                this->_done = !this->_statement(batch);
+            }
+            return !batch.empty();
+        }
+
+      private:
+        [[noreturn]] auto _fail(const std::string &what) const -> void {
+            detail::fail(this->_tokens.line(), what);
+        }
+
+        auto _expect(std::string_view expected) -> void {
+            const auto tok = this->_tokens.next();
+            if (tok != expected) {
+                this->_fail("'" + std::string(expected) + "' expected, got '" + std::string(tok)
+                            + "'");
+            }
+        }
+
+        auto _coord(std::string_view tok) const -> T {
+            const auto *last = tok.data() + tok.size();
+            auto val = T{};
+            auto res = std::from_chars(tok.data(), last, val);
+            if (res.ec == std::errc{} && res.ptr == last) {
+                return val;
+            }
+            auto real = 0.0;  // e.g. `1000.0`
+            res = std::from_chars(tok.data(), last, real);
+            if (res.ec != std::errc{} || res.ptr != last) {
+                this->_fail("number expected, got '" + std::string(tok) + "'");
+            }
+            return T(std::llround(real));
+        }
+
+        // `( x y )` after the opening parenthesis, where `*` repeats the previous value
+        auto _point(const Point<T> *prev) -> Point<T> {
+            auto coord = [this, prev](bool is_x) {
+                const auto tok = this->_tokens.next();
+                if (tok == "*" && prev != nullptr) {
+                    return is_x ? prev->xcoord() : prev->ycoord();
+                }
+                return this->_coord(tok);
+            };
+            const auto x = coord(true);
+            const auto y = coord(false);
+            this->_expect(")");
+            return Point<T>{x, y};
+        }
+
+        // the points `( x y ) ( x y ) ...` into `_verts`, stopping before any other token
+        auto _points() -> void {
+            this->_verts.clear();
+            for (auto tok = this->_tokens.next(); tok == "("; tok = this->_tokens.next()) {
+                this->_verts.push_back(
+                    this->_point(this->_verts.empty() ? nullptr : &this->_verts.back()));
+            }
+            this->_tokens.unget();
+        }
+
+        // skip layer options (`MASK n`, `SPACING d`, ...) up to the first point
+        auto _skip_to_points() -> void {
+            for (auto tok = this->_tokens.next(); tok != "("; tok = this->_tokens.next()) {
+                if (tok.empty() || tok == ";") {
+                    this->_fail("points expected");
+                }
+            }
+            this->_tokens.unget();
+        }
+
+        auto _orient() -> Orient {
+            static constexpr std::string_view names[] = {"N", "W", "S", "E",
+                                                         "FN", "FW", "FS", "FE"};
+            const auto tok = this->_tokens.next();
+            for (auto idx = 0U; idx != 8U; ++idx) {
+                if (tok == names[idx]) {
+                    return Orient(idx);
+                }
+            }
+            this->_fail("orientation expected, got '" + std::string(tok) + "'");
+        }
+
+        auto _rect_of(const Point<T> &pt1, const Point<T> &pt2) const -> Rectangle<T> {
+            return Rectangle<T>{Interval<T>{std::min(pt1.xcoord(), pt2.xcoord()),
+                                            std::max(pt1.xcoord(), pt2.xcoord())},
+                                Interval<T>{std::min(pt1.ycoord(), pt2.ycoord()),
+                                            std::max(pt1.ycoord(), pt2.ycoord())}};
+        }
+
+        auto _emit_rect(ShapeBatch<T> &batch, const Rectangle<T> &rect, ShapeKind kind) -> void {
+            batch.rects.push_back(rect);
+            batch.rect_kinds.push_back(kind);
+        }
+
+        // `_verts` (all vertices) as a rectangle if it has two points, else as a polygon
+        auto _emit_verts(ShapeBatch<T> &batch, ShapeKind kind) -> void {
+            if (this->_verts.size() == 2) {
+                this->_emit_rect(batch, this->_rect_of(this->_verts[0], this->_verts[1]), kind);
+                return;
+            }
+            if (!detail::append_rpolygon(batch.rpolygons, this->_verts)) {
+                this->_fail("polygon is not rectilinear");
+            }
+            batch.rpolygon_kinds.push_back(kind);
+        }
+
+        auto _skip_statement() -> void {
+            for (auto tok = this->_tokens.next(); tok != ";"; tok = this->_tokens.next()) {
+                if (tok.empty()) {
+                    this->_fail("unexpected end of input");
+                }
+            }
+        }
+
+        auto _skip_section(std::string_view name) -> void {
+            const auto section = std::string(name);
+            for (auto tok = this->_tokens.next(); !tok.empty(); tok = this->_tokens.next()) {
+                if (tok == "END" && this->_tokens.next() == section) {
+                    return;
+                }
+            }
+            this->_fail("END " + section + " expected");
+        }
+
+        // one statement (or one item of a section); false at the end of the design
+        auto _statement(ShapeBatch<T> &batch) -> bool {
+            const auto tok = this->_tokens.next();
+            if (tok.empty()) {
+                return false;
+            }
+            if (this->_section != Section::top) {
+                if (tok == "END") {
+                    this->_tokens.next();  // the section name
+                    this->_section = Section::top;
+                } else if (tok != "-") {
+                    this->_fail("'-' or END expected, got '" + std::string(tok) + "'");
+                } else if (this->_section == Section::components) {
+                    this->_component(batch);
+                } else if (this->_section == Section::pins) {
+                    this->_pin(batch);
+                } else {
+                    this->_blockage(batch);
+                }
+                return true;
+            }
+            if (tok == "END") {
+                return this->_tokens.next() != "DESIGN";
+            }
+            if (tok == "UNITS") {
+                this->_expect("DISTANCE");
+                this->_expect("MICRONS");
+                this->_dbu = (long long)(this->_coord(this->_tokens.next()));
+                this->_expect(";");
+            } else if (tok == "DIEAREA") {
+                this->_points();
+                this->_expect(";");
+                this->_emit_verts(batch, ShapeKind::die_area);
+            } else if (tok == "COMPONENTS" || tok == "PINS" || tok == "BLOCKAGES") {
+                this->_section = tok == "COMPONENTS" ? Section::components
+                                 : tok == "PINS"     ? Section::pins
+                                                     : Section::blockages;
+                this->_skip_statement();  // the count
+            } else if (tok == "NETS" || tok == "SPECIALNETS" || tok == "VIAS"
+                       || tok == "NONDEFAULTRULES" || tok == "REGIONS" || tok == "GROUPS"
+                       || tok == "FILLS" || tok == "SCANCHAINS" || tok == "STYLES"
+                       || tok == "SLOTS" || tok == "PROPERTYDEFINITIONS"
+                       || tok == "PINPROPERTIES") {
+                this->_skip_section(tok);
+            } else if (tok == "BEGINEXT") {
+                for (auto ext = this->_tokens.next(); ext != "ENDEXT"; ext = this->_tokens.next()) {
+                    if (ext.empty()) {
+                        this->_fail("ENDEXT expected");
+                    }
+                }
+            } else {
+                this->_skip_statement();  // VERSION, DESIGN, ROW, TRACKS, ...
+            }
+            return true;
+        }
+
+        // `- name model [+ PLACED|FIXED|COVER ( x y ) orient] ... ;`
+        auto _component(ShapeBatch<T> &batch) -> void {
+            this->_tokens.next();  // the instance name
+            this->_name.assign(this->_tokens.next());
+            auto placed = false;
+            auto location = Point<T>{T(0), T(0)};
+            auto orient = Orient::N;
+            for (auto tok = this->_tokens.next(); tok != ";"; tok = this->_tokens.next()) {
+                if (tok.empty()) {
+                    this->_fail("unexpected end of input");
+                }
+                if (tok == "PLACED" || tok == "FIXED" || tok == "COVER") {
+                    this->_expect("(");
+                    location = this->_point(nullptr);
+                    orient = this->_orient();
+                    placed = true;
+                }
+            }
+            if (!placed || this->_macros == nullptr) {
+                return;
+            }
+            const auto macro = this->_macros->find(this->_name);
+            if (macro == this->_macros->end()) {
+                return;
+            }
+            if (this->_dbu == 0) {
+                this->_fail("UNITS DISTANCE MICRONS expected before COMPONENTS");
+            }
+            auto width = T(std::llround(macro->second.x() * double(this->_dbu)));
+            auto height = T(std::llround(macro->second.y() * double(this->_dbu)));
+            if (orient == Orient::W || orient == Orient::E || orient == Orient::FW
+                || orient == Orient::FE) {
+                std::swap(width, height);
+            }
+            // the location is the lower left corner of the oriented macro
+            const auto &x = location.xcoord();
+            const auto &y = location.ycoord();
+            const auto rect
+                = Rectangle<T>{Interval<T>{x, T(x + width)}, Interval<T>{y, T(y + height)}};
+            this->_emit_rect(batch, rect, ShapeKind::component);
+        }
+
+        // the shapes of `_port`, oriented and moved to the placement of the pin
+        auto _emit_port(ShapeBatch<T> &batch, const Point<T> &location, Orient orient) -> void {
+            auto place = [&location, orient](const Point<T> &pt) {
+                const auto moved = orient_point(orient, pt);
+                return Point<T>{T(moved.xcoord() + location.xcoord()),
+                                T(moved.ycoord() + location.ycoord())};
+            };
+            for (const auto &rect : this->_port.rects) {
+                this->_emit_rect(batch, this->_rect_of(place(rect.ll()), place(rect.ur())),
+                                 ShapeKind::pin);
+            }
+            for (auto idx = std::size_t{0}; idx != this->_port.rpolygons.size(); ++idx) {
+                // expand the point list back to all vertices, then transform those
+                this->_verts.clear();
+                const auto pts = this->_port.rpolygons[idx];
+                for (auto pos = std::size_t{0}; pos != pts.size(); ++pos) {
+                    const auto &next = pts[(pos + 1) % pts.size()];
+                    this->_verts.push_back(place(pts[pos]));
+                    this->_verts.push_back(place(Point<T>{next.xcoord(), pts[pos].ycoord()}));
+                }
+                this->_emit_verts(batch, ShapeKind::pin);
+            }
+            this->_port.clear();
+        }
+
+        // `- name + NET net ... [+ LAYER l ( x y ) ( x y )] [+ POLYGON l ( x y ) ...]
+        //  [+ PLACED|FIXED|COVER ( x y ) orient] [+ PORT ...] ;`
+        auto _pin(ShapeBatch<T> &batch) -> void {
+            this->_tokens.next();  // the pin name
+            this->_port.clear();
+            auto placed = false;
+            auto location = Point<T>{T(0), T(0)};
+            auto orient = Orient::N;
+            auto flush = [&]() {
+                if (placed) {
+                    this->_emit_port(batch, location, orient);
+                }
+                this->_port.clear();
+                placed = false;
+            };
+            for (auto tok = this->_tokens.next(); tok != ";"; tok = this->_tokens.next()) {
+                if (tok.empty()) {
+                    this->_fail("unexpected end of input");
+                }
+                if (tok == "LAYER" || tok == "POLYGON") {
+                    const auto is_rect = tok == "LAYER";
+                    this->_tokens.next();  // the layer name
+                    this->_skip_to_points();
+                    this->_points();
+                    if (is_rect && this->_verts.size() != 2) {
+                        this->_fail("two points expected");
+                    }
+                    this->_emit_verts(this->_port, ShapeKind::pin);
+                } else if (tok == "PLACED" || tok == "FIXED" || tok == "COVER") {
+                    this->_expect("(");
+                    location = this->_point(nullptr);
+                    orient = this->_orient();
+                    placed = true;
+                } else if (tok == "PORT") {
+                    flush();
+                }
+            }
+            flush();
+        }
+
+        // `- LAYER l | - PLACEMENT [+ ...] RECT ( x y ) ( x y ) | POLYGON ( x y ) ... ;`
+        auto _blockage(ShapeBatch<T> &batch) -> void {
+            for (auto tok = this->_tokens.next(); tok != ";"; tok = this->_tokens.next()) {
+                if (tok.empty()) {
+                    this->_fail("unexpected end of input");
+                }
+                if (tok == "RECT" || tok == "POLYGON") {
+                    const auto is_rect = tok == "RECT";
+                    this->_points();
+                    if (is_rect && this->_verts.size() != 2) {
+                        this->_fail("two points expected");
+                    }
+                    this->_emit_verts(batch, ShapeKind::blockage);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Read all shapes and hand them to `consume` batch by batch.
+     *
+     * @param[in,out] reader The reader.
+     * @param[in] consume Called with each (non-empty) `const ShapeBatch<T>&`.
+     * @param[in] batch_size The number of shapes per batch.
+     */
+    template <typename T, typename Consumer>
+    auto read_def(DefReader<T> &reader, Consumer &&consume, std::size_t batch_size = 4096)
+        -> void {
+        auto batch = ShapeBatch<T>{};
+        while (reader.read(batch, batch_size)) {
+            consume(std::as_const(batch));
+        }
+    }
+
+    /**
+     * @brief Read all shapes on a worker thread while `consume` processes them.
+     *
+     * Two batches alternate: while `consume` runs on the calling thread with one, the worker
+     * parses the next into the other. An exception from either side stops both and is
+     * rethrown here.
+     *
+     * @param[in,out] reader The reader.
+     * @param[in] consume Called with each (non-empty) `const ShapeBatch<T>&`, in order.
+     * @param[in] batch_size The number of shapes per batch.
+     */
+    template <typename T, typename Consumer>
+    auto read_def_pipelined(DefReader<T> &reader, Consumer &&consume,
+                            std::size_t batch_size = 4096) -> void {
+        ShapeBatch<T> batches[2];
+        bool full[2] = {false, false};
+        auto done = false;       // the worker has no more batches
+        auto cancelled = false;  // the consumer failed
+        auto error = std::exception_ptr{};
+        auto mutex = std::mutex{};
+        auto ready = std::condition_variable{};
+
+        auto worker = std::thread([&]() {
+            try {
+                for (auto idx = 0U;; idx ^= 1U) {
+                    {
+                        auto lock = std::unique_lock<std::mutex>(mutex);
+                        ready.wait(lock, [&]() { return !full[idx] || cancelled; });
+                        if (cancelled) {
+                            break;
+                        }
+                    }
+                    // the consumer does not touch `batches[idx]` until it is marked full
+                    if (!reader.read(batches[idx], batch_size)) {
+                        break;
+                    }
+                    auto lock = std::lock_guard<std::mutex>(mutex);
+                    full[idx] = true;
+                    ready.notify_all();
+                }
+            } catch (...) {
+                auto lock = std::lock_guard<std::mutex>(mutex);
+                error = std::current_exception();
+            }
+            auto lock = std::lock_guard<std::mutex>(mutex);
+            done = true;
+            ready.notify_all();
+        });
+
+        try {
+            for (auto idx = 0U;; idx ^= 1U) {
+                {
+                    auto lock = std::unique_lock<std::mutex>(mutex);
+                    ready.wait(lock, [&]() { return full[idx] || done; });
+                    if (!full[idx]) {
+                        break;
+                    }
+                }
+                consume(std::as_const(batches[idx]));
+                auto lock = std::lock_guard<std::mutex>(mutex);
+                full[idx] = false;
+                ready.notify_all();
+            }
+        } catch (...) {
+            {
+                auto lock = std::lock_guard<std::mutex>(mutex);
+                cancelled = true;
+                ready.notify_all();
+            }
+            worker.join();
+            throw;
+        }
+        worker.join();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+}  // namespace recti::def
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>    // for std::max, std::min
+#include <cmath>        // for std::sqrt, std::lround
+#include <type_traits>  // for std::is_integral_v
+#include <utility>      // for std::pair
+
+namespace recti {
+
+    /**
+     * @brief Linear (path length) delay model for `DmeTree`
+     *
+     * The delay of a wire is its length and the loads are ignored, so the tapping point
+     * splits the distance between two subtrees by their delay difference. This is the model
+     * of the original DME papers and the default of `DmeTree`.
+     *
+     * A delay model provides:
+     *  - `delay_type` and `load_type`;
+     *  - `sink_load()`: the load of a sink;
+     *  - `wire_delay(length, load)`: the delay of a wire driving `load`;
+     *  - `wire_load(length)`: the load of the wire itself;
+     *  - `split(alpha, t_l, c_l, t_r, c_r)`: the wire lengths `(e_l, e_r)` from the tapping
+     *    point to two subtrees at distance `alpha` with delays `t_l`, `t_r` and loads `c_l`,
+     *    `c_r`, balancing the delays (`e_l + e_r == alpha` unless a branch is elongated).
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> struct LinearDelay {
+        using delay_type = T;
+        using load_type = T;
+        static constexpr bool is_linear = true;
+
+        constexpr auto sink_load() const noexcept -> load_type { return T(0); }
+
+        constexpr auto wire_delay(T length, load_type /* load */) const noexcept -> delay_type {
+            return length;
+        }
+
+        constexpr auto wire_load(T /* length */) const noexcept -> load_type { return T(0); }
+
+        constexpr auto split(T alpha, delay_type t_l, load_type /* c_l */, delay_type t_r,
+                             load_type /* c_r */) const noexcept -> std::pair<T, T> {
+            if (t_l > t_r + alpha) {  // the right branch must be elongated
+                return {T(0), T(t_l - t_r)};
+            }
+            if (t_r > t_l + alpha) {  // the left branch must be elongated
+                return {T(t_r - t_l), T(0)};
+            }
+            const auto e_l = T((alpha + t_r - t_l) / 2);
+            return {e_l, T(alpha - e_l)};
+        }
+    };
+
+    /**
+     * @brief Elmore (RC) delay model for `DmeTree`
+     *
+     * A wire of length `l` has the resistance `unit_res * l` and the capacitance
+     * `unit_cap * l`; driving a load `C`, its delay is `unit_res * l * (unit_cap * l / 2 + C)`.
+     * The tapping point follows from Tsay's formula with the downstream capacitance and delay
+     * of each subtree, which `DmeTree` caches in every node, so the whole tree is balanced in
+     * one bottom-up pass. When the formula falls outside the segment between the subtrees,
+     * the faster branch is elongated to the length solving the quadratic delay equation.
+     *
+     * With integer coordinates the wire lengths are rounded to the nearest unit, which leaves
+     * a small residual skew.
+     *
+     * Reference:
+     *  - R.-S. Tsay, "Exact zero skew," IEEE International Conference on Computer-Aided
+     * Design, 1991, pp. 336-339.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> struct ElmoreDelay {
+        using delay_type = double;
+        using load_type = double;
+        static constexpr bool is_linear = false;
+
+        double unit_res{1.0};  //!< resistance per unit of length
+        double unit_cap{1.0};  //!< capacitance per unit of length
+        double sink_cap{1.0};  //!< load of every sink
+
+        constexpr auto sink_load() const noexcept -> load_type { return this->sink_cap; }
+
+        constexpr auto wire_delay(T length, load_type load) const noexcept -> delay_type {
+            const auto len = double(length);
+            return this->unit_res * len * (this->unit_cap * len / 2 + load);
+        }
+
+        constexpr auto wire_load(T length) const noexcept -> load_type {
+            return this->unit_cap * double(length);
+        }
+
+        auto split(T alpha, delay_type t_l, load_type c_l, delay_type t_r, load_type c_r) const
+            -> std::pair<T, T> {
+            const auto len = double(alpha);
+            const auto x_l = (t_r - t_l + this->unit_res * len * (c_r + this->unit_cap * len / 2))
+                             / (this->unit_res * (c_l + c_r + this->unit_cap * len));
+            if (x_l < 0) {  // the right branch must be elongated
+                return {T(0), std::max(alpha, this->_elongation(t_l - t_r, c_r))};
+            }
+            if (x_l > len) {  // the left branch must be elongated
+                return {std::max(alpha, this->_elongation(t_r - t_l, c_l)), T(0)};
+            }
+            const auto e_l = std::min(alpha, _round(x_l));
+            return {e_l, T(alpha - e_l)};
+        }
+
+      private:
+        static auto _round(double value) -> T {
+            if constexpr (std::is_integral_v<T>) {
+                return T(std::lround(value));
+            } else {
+                return T(value);
+            }
+        }
+
+        // the length of a wire driving `load` whose delay is `delta`
+        auto _elongation(delay_type delta, load_type load) const -> T {
+            const auto res_load = this->unit_res * load;
+            if (this->unit_cap == 0.0) {
+                return _round(delta / res_load);
+            }
+            const auto res_cap = this->unit_res * this->unit_cap;
+            return _round((std::sqrt(res_load * res_load + 2 * res_cap * delta) - res_load)
+                          / res_cap);
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>  // for std::min, std::max
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <gsl/span>
+#include <vector>
+
+#include "parallel.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Density grid (bins of equal size) accumulating shape areas, lengths and counts
+     *
+     * A rectangle adds `weight` times its overlap area with each bin it touches, an
+     * `HSegment`/`VSegment` adds `weight` times its overlap length with each bin of its row or
+     * column, and a point adds `weight` to its bin. Only the bins inside the bounding box of
+     * a shape are visited, and the overlap with a bin is the product of the two interval
+     * overlaps (`intersect_with`), so shape clipping costs O(1) per touched bin. Shapes are
+     * clipped to the grid.
+     *
+     * The batch functions split the shapes over per-thread copies of the bins (shards), which
+     * are summed at the end in a fixed order, so every run with the same number of threads
+     * gives the same result (and exactly the serial one for integral values).
+     * `build_prefix_sums()` then turns the bins into a summed-area table for O(1) window sums.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Acc The accumulator type of the bins.
+     */
+    template <typename T, typename Acc = double> class DensityGrid {
+        Point<T> _origin;
+        T _bin_width;
+        T _bin_height;
+        std::size_t _num_x;
+        std::size_t _num_y;
+        Rectangle<T> _region;
+        std::vector<Acc> _bins;  // row-major: bin (ix, iy) is `_bins[iy * _num_x + ix]`
+        std::vector<Acc> _prefix;  // (num_x + 1) * (num_y + 1) sums, empty when stale
+
+      public:
+        /**
+         * @brief Construct an empty grid.
+         *
+         * @param[in] origin The lower-left corner of bin (0, 0).
+         * @param[in] bin_width The width of each bin.
+         * @param[in] bin_height The height of each bin.
+         * @param[in] num_x The number of columns.
+         * @param[in] num_y The number of rows.
+         */
+        DensityGrid(const Point<T> &origin, T bin_width, T bin_height, std::size_t num_x,
+                    std::size_t num_y)
+            : _origin{origin},
+              _bin_width{bin_width},
+              _bin_height{bin_height},
+              _num_x{num_x},
+              _num_y{num_y},
+              _region{Interval<T>{origin.xcoord(), T(origin.xcoord() + T(num_x) * bin_width)},
+                      Interval<T>{origin.ycoord(), T(origin.ycoord() + T(num_y) * bin_height)}},
+              _bins(num_x * num_y, Acc(0)) {
+            assert(bin_width > T(0) && bin_height > T(0) && num_x > 0 && num_y > 0);
+        }
+
+        auto num_x() const noexcept -> std::size_t { return this->_num_x; }
+        auto num_y() const noexcept -> std::size_t { return this->_num_y; }
+
+        /**
+         * @brief The region covered by the grid.
+         *
+         * @return const Rectangle<T>&
+         */
+        auto region() const noexcept -> const Rectangle<T> & { return this->_region; }
+
+        /**
+         * @brief The region of bin (ix, iy).
+         *
+         * @return Rectangle<T>
+         */
+        auto bin_rect(std::size_t ix, std::size_t iy) const -> Rectangle<T> {
+            return Rectangle<T>{this->_column(ix), this->_row(iy)};
+        }
+
+        /**
+         * @brief The value of bin (ix, iy).
+         *
+         * @return Acc
+         */
+        auto bin(std::size_t ix, std::size_t iy) const -> Acc {
+            return this->_bins[iy * this->_num_x + ix];
+        }
+
+        /**
+         * @brief All bins, row by row.
+         *
+         * @return gsl::span<const Acc>
+         */
+        auto bins() const noexcept -> gsl::span<const Acc> { return this->_bins; }
+
+        /**
+         * @brief Reset all bins to 0.
+         */
+        auto clear() -> void {
+            std::fill(this->_bins.begin(), this->_bins.end(), Acc(0));
+            this->_prefix.clear();
+        }
+
+        /**
+         * @brief Add `weight` times the overlap area of a rectangle with each bin.
+         */
+        auto add(const Rectangle<T> &rect, Acc weight = Acc(1)) -> void {
+            this->_prefix.clear();
+            this->_rasterize(this->_bins.data(), rect, weight);
+        }
+
+        /**
+         * @brief Add `weight` times the overlap length of a horizontal segment with each bin.
+         */
+        auto add(const HSegment<T> &seg, Acc weight = Acc(1)) -> void {
+            this->_prefix.clear();
+            this->_rasterize(this->_bins.data(), seg, weight);
+        }
+
+        /**
+         * @brief Add `weight` times the overlap length of a vertical segment with each bin.
+         */
+        auto add(const VSegment<T> &seg, Acc weight = Acc(1)) -> void {
+            this->_prefix.clear();
+            this->_rasterize(this->_bins.data(), seg, weight);
+        }
+
+        /**
+         * @brief Add `weight` to the bin of a point (e.g. a pin).
+         */
+        auto add(const Point<T> &pt, Acc weight = Acc(1)) -> void {
+            this->_prefix.clear();
+            this->_rasterize(this->_bins.data(), pt, weight);
+        }
+
+        /**
+         * @brief Add many shapes (rectangles, segments or points), sharded over threads.
+         *
+         * @param[in] shapes The shapes.
+         * @param[in] weight The weight of each shape.
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        template <typename Shape>
+        auto add_all(gsl::span<const Shape> shapes, Acc weight = Acc(1), unsigned num_threads = 1)
+            -> void {
+            constexpr auto shard_grain = std::size_t{4096};  // shapes per shard at least
+            this->_prefix.clear();
+            if (num_threads == 0) {
+                num_threads = hardware_threads();
+            }
+            const auto num_shards = std::min<std::size_t>(
+                num_threads, (shapes.size() + shard_grain - 1) / shard_grain);
+            if (num_shards <= 1) {
+                for (const auto &shape : shapes) {
+                    this->_rasterize(this->_bins.data(), shape, weight);
+                }
+                return;
+            }
+            const auto num_bins = this->_bins.size();
+            auto shards = std::vector<Acc>((num_shards - 1) * num_bins, Acc(0));
+            const auto step = (shapes.size() + num_shards - 1) / num_shards;
+            auto fill = [&](std::size_t shard) {
+                auto *bins = shard == 0 ? this->_bins.data() : &shards[(shard - 1) * num_bins];
+                const auto last = std::min(shapes.size(), (shard + 1) * step);
+                for (auto idx = shard * step; idx < last; ++idx) {
+                    this->_rasterize(bins, shapes[idx], weight);
+                }
+            };
+            parallel_for(std::size_t{0}, num_shards, fill, num_threads);
+            auto reduce = [&](std::size_t row) {
+                auto *bins = &this->_bins[row * this->_num_x];
+                for (auto shard = std::size_t{0}; shard + 1 != num_shards; ++shard) {
+                    const auto *part = &shards[shard * num_bins + row * this->_num_x];
+                    for (auto ix = std::size_t{0}; ix != this->_num_x; ++ix) {
+                        bins[ix] += part[ix];
+                    }
+                }
+            };
+            parallel_for(std::size_t{0}, this->_num_y, reduce, num_threads, 16);
+        }
+
+        /**
+         * @brief Build the summed-area table of the bins, for `window_sum()`.
+         *
+         * Adding shapes afterwards discards it.
+         */
+        auto build_prefix_sums() -> void {
+            const auto stride = this->_num_x + 1;
+            this->_prefix.assign(stride * (this->_num_y + 1), Acc(0));
+            for (auto iy = std::size_t{0}; iy != this->_num_y; ++iy) {
+                auto row_sum = Acc(0);
+                for (auto ix = std::size_t{0}; ix != this->_num_x; ++ix) {
+                    row_sum += this->_bins[iy * this->_num_x + ix];
+                    this->_prefix[(iy + 1) * stride + ix + 1]
+                        = this->_prefix[iy * stride + ix + 1] + row_sum;
+                }
+            }
+        }
+
+        /**
+         * @brief Whether the summed-area table is up to date.
+         */
+        auto has_prefix_sums() const noexcept -> bool { return !this->_prefix.empty(); }
+
+        /**
+         * @brief The sum of the bins `[ix0, ix1) x [iy0, iy1)`, in O(1).
+         *
+         * `build_prefix_sums()` must have been called since the last change.
+         *
+         * @return Acc
+         */
+        auto window_sum(std::size_t ix0, std::size_t iy0, std::size_t ix1, std::size_t iy1) const
+            -> Acc {
+            assert(this->has_prefix_sums());
+            assert(ix0 <= ix1 && ix1 <= this->_num_x && iy0 <= iy1 && iy1 <= this->_num_y);
+            const auto stride = this->_num_x + 1;
+            const auto *sat = this->_prefix.data();
+            return sat[iy1 * stride + ix1] - sat[iy0 * stride + ix1] - sat[iy1 * stride + ix0]
+                   + sat[iy0 * stride + ix0];
+        }
+
+      private:
+        auto _column(std::size_t ix) const -> Interval<T> {
+            const auto lower = T(this->_origin.xcoord() + T(ix) * this->_bin_width);
+            return Interval<T>{lower, T(lower + this->_bin_width)};
+        }
+
+        auto _row(std::size_t iy) const -> Interval<T> {
+            const auto lower = T(this->_origin.ycoord() + T(iy) * this->_bin_height);
+            return Interval<T>{lower, T(lower + this->_bin_height)};
+        }
+
+        // the bin index of a coordinate inside the grid along one axis (the last bin owns
+        // the upper boundary)
+        static auto _index(T coord, T origin, T size, std::size_t num) -> std::size_t {
+            return std::min(std::size_t((coord - origin) / size), num - 1);
+        }
+
+        auto _rasterize(Acc *bins, const Rectangle<T> &rect, Acc weight) const -> void {
+            const auto &region = this->_region;
+            if (!region.overlaps(rect)) {
+                return;
+            }
+            const auto clip = rect.intersect_with(region);
+            const auto &xrange = clip.xcoord();
+            const auto &yrange = clip.ycoord();
+            const auto ix0 = _index(xrange.lb(), this->_origin.xcoord(), this->_bin_width,
+                                    this->_num_x);
+            const auto ix1 = _index(xrange.ub(), this->_origin.xcoord(), this->_bin_width,
+                                    this->_num_x);
+            const auto iy0 = _index(yrange.lb(), this->_origin.ycoord(), this->_bin_height,
+                                    this->_num_y);
+            const auto iy1 = _index(yrange.ub(), this->_origin.ycoord(), this->_bin_height,
+                                    this->_num_y);
+            for (auto iy = iy0; iy <= iy1; ++iy) {
+                const auto height = Acc(this->_row(iy).intersect_with(yrange).length()) * weight;
+                auto *row = bins + iy * this->_num_x;
+                for (auto ix = ix0; ix <= ix1; ++ix) {
+                    row[ix] += Acc(this->_column(ix).intersect_with(xrange).length()) * height;
+                }
+            }
+        }
+
+        auto _rasterize(Acc *bins, const HSegment<T> &seg, Acc weight) const -> void {
+            const auto &region = this->_region;
+            if (!region.overlaps(seg)) {
+                return;
+            }
+            const auto xrange = seg.xcoord().intersect_with(region.xcoord());
+            const auto iy = _index(seg.ycoord(), this->_origin.ycoord(), this->_bin_height,
+                                   this->_num_y);
+            const auto ix0 = _index(xrange.lb(), this->_origin.xcoord(), this->_bin_width,
+                                    this->_num_x);
+            const auto ix1 = _index(xrange.ub(), this->_origin.xcoord(), this->_bin_width,
+                                    this->_num_x);
+            auto *row = bins + iy * this->_num_x;
+            for (auto ix = ix0; ix <= ix1; ++ix) {
+                row[ix] += Acc(this->_column(ix).intersect_with(xrange).length()) * weight;
+            }
+        }
+
+        auto _rasterize(Acc *bins, const VSegment<T> &seg, Acc weight) const -> void {
+            const auto &region = this->_region;
+            if (!region.overlaps(seg)) {
+                return;
+            }
+            const auto yrange = seg.ycoord().intersect_with(region.ycoord());
+            const auto ix = _index(seg.xcoord(), this->_origin.xcoord(), this->_bin_width,
+                                   this->_num_x);
+            const auto iy0 = _index(yrange.lb(), this->_origin.ycoord(), this->_bin_height,
+                                    this->_num_y);
+            const auto iy1 = _index(yrange.ub(), this->_origin.ycoord(), this->_bin_height,
+                                    this->_num_y);
+            for (auto iy = iy0; iy <= iy1; ++iy) {
+                bins[iy * this->_num_x + ix]
+                    += Acc(this->_row(iy).intersect_with(yrange).length()) * weight;
+            }
+        }
+
+        auto _rasterize(Acc *bins, const Point<T> &pt, Acc weight) const -> void {
+            if (!this->_region.contains(pt)) {
+                return;
+            }
+            const auto ix = _index(pt.xcoord(), this->_origin.xcoord(), this->_bin_width,
+                                   this->_num_x);
+            const auto iy = _index(pt.ycoord(), this->_origin.ycoord(), this->_bin_height,
+                                   this->_num_y);
+            bins[iy * this->_num_x + ix] += weight;
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,667 @@
+#pragma once
+
+#include <algorithm>  // for std::max, std::clamp
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint8_t
+#include <gsl/span>
+#include <type_traits>  // for std::is_integral_v
+#include <utility>  // for std::pair, std::move
+#include <vector>
+
+#include "delay_model.hpp"
+#include "instrument.hpp"
+#include "merge_obj.hpp"
+#include "parallel.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Clock Tree Topology
+     *
+     * A full binary tree over `num_sinks` sinks. Nodes `[0, num_sinks)` are the sinks (leaves)
+     * and node `num_sinks + k` is the internal node whose two children are `children[k]`.
+     * Children must have smaller indices than their parent, so the root is the last node and
+     * increasing index order is a valid bottom-up order.
+     */
+    struct ClockTopology {
+        std::size_t num_sinks{0};
+        std::vector<std::pair<std::size_t, std::size_t>> children{};
+
+        /**
+         * @brief The total number of nodes.
+         *
+         * @return std::size_t
+         */
+        auto num_nodes() const noexcept -> std::size_t {
+            return this->num_sinks + this->children.size();
+        }
+
+        /**
+         * @brief The root node.
+         *
+         * @return std::size_t
+         */
+        auto root() const noexcept -> std::size_t { return this->num_nodes() - 1; }
+
+        /**
+         * @brief Whether `node` is a sink.
+         *
+         * @param[in] node The node index.
+         * @return true if it is a leaf.
+         */
+        auto is_sink(std::size_t node) const noexcept -> bool { return node < this->num_sinks; }
+    };
+
+    /**
+     * @brief Zero-skew clock tree by Deferred-Merge Embedding (DME)
+     *
+     * `DmeTree` builds a zero-skew clock tree under the linear delay model over a given
+     * topology. The bottom-up pass computes the merging segment of every internal node with
+     * `MergeObj` (regions are tilted rectangles, i.e. rectangles in the 45-degree rotated
+     * space), choosing the tapping point so that both subtrees have the same delay; when the
+     * delay difference exceeds the distance between the children, the shorter branch is
+     * elongated (detour wiring). The top-down pass then embeds every node at the point of its
+     * merging segment nearest to its parent's location.
+     *
+     * Both passes are processed level by level: all nodes of the same height (bottom-up) are
+     * independent of each other and are merged concurrently by `parallel_for`, so the work is
+     * spread over the threads without any locking.
+     *
+     * With a positive skew bound, the tree is built by bounded-skew DME instead: every node
+     * keeps the interval `[min_delay, delay]` of its sink delays, and a merge may place the
+     * tapping point anywhere that keeps the spread within the bound (`merge_bounded()`). The
+     * slack is spent first on avoiding detour wiring and then on widening the merging region
+     * from a segment to a tilted rectangle, which leaves more freedom to the levels above.
+     *
+     * After some sinks move (e.g. an ECO placement), `move_sinks()` re-merges only the nodes
+     * on their paths to the root and re-embeds only the nodes whose location changes.
+     *
+     * With integer coordinates, halving the distance is rounded down, which may leave a skew
+     * of one unit per level, and a node may be shifted by one unit inside its merging region
+     * so that it maps back to an integer point of the original space.
+     *
+     * The delay model is a policy: `LinearDelay` (the default) or `ElmoreDelay`, for which the
+     * tree caches the downstream capacitance of every node next to its delay, so each merge
+     * only looks at its two children. Bounded skew requires the linear model.
+     *
+     * Reference (bounded skew):
+     *  - J. Cong, A. B. Kahng, C.-K. Koh and C.-W. A. Tsao, "Bounded-skew clock and Steiner
+     * routing," ACM Transactions on Design Automation of Electronic Systems, vol. 3, no. 3,
+     * pp. 341-388, 1998.
+     *
+     * Reference:
+     *  - Ting-Hai Chao, Yu-Chin Hsu, Jan-Ming Ho and A. B. Kahng, "Zero skew clock routing
+     * with minimum wirelength," in IEEE Transactions on Circuits and Systems II: Analog and
+     * Digital Signal Processing, vol. 39, no. 11, pp. 799-814, Nov. 1992.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Delay The delay model.
+     */
+    template <typename T, typename Delay = LinearDelay<T>> class DmeTree {
+      public:
+        using Region = MergeObj<Interval<T>, Interval<T>>;
+        using delay_type = typename Delay::delay_type;
+        using load_type = typename Delay::load_type;
+
+      private:
+        ClockTopology _topo;
+        std::vector<Region> _regions{};
+        std::vector<delay_type> _delays{};      // the longest sink-to-node delay
+        std::vector<delay_type> _min_delays{};  // the shortest sink-to-node delay
+        std::vector<load_type> _loads{};        // downstream capacitance
+        std::vector<T> _min_wires{};      // wire length planned by the merge of the parent
+        std::vector<T> _wires{};          // wire length from the parent to the node
+        std::vector<Point<T>> _places{};  // embedded location in the rotated space
+        std::vector<std::size_t> _parents{};
+        std::vector<std::size_t> _order{};         // nodes sorted by height
+        std::vector<std::size_t> _level_starts{};  // start of each height in `_order`
+        std::vector<std::uint8_t> _dirty{};        // re-merged by `move_sinks()`
+        T _skew_bound;
+        Delay _model;
+
+      public:
+        static constexpr std::size_t npos = ~std::size_t{0};
+
+        /**
+         * @brief Construct a new DmeTree object
+         *
+         * @param[in] sinks The sink locations, one per leaf of `topo`.
+         * @param[in] topo The tree topology.
+         * @param[in] skew_bound The largest allowed skew (0 for a zero-skew tree).
+         * @param[in] model The delay model.
+         */
+        DmeTree(gsl::span<const Point<T>> sinks, ClockTopology topo, T skew_bound = T(0),
+                Delay model = Delay{})
+            : _topo{std::move(topo)}, _skew_bound{skew_bound}, _model{std::move(model)} {
+            assert(!(skew_bound < T(0)));
+            assert(Delay::is_linear || skew_bound == T(0));
+            assert(sinks.size() == this->_topo.num_sinks);
+            assert(this->_topo.num_sinks == 0
+                   || this->_topo.children.size() + 1 == this->_topo.num_sinks);
+            const auto num_nodes = this->_topo.num_nodes();
+            this->_regions.reserve(num_nodes);
+            for (const auto &sink : sinks) {
+                this->_regions.push_back(to_region(sink));
+            }
+            this->_regions.resize(num_nodes, Region{Interval<T>{T(0)}, Interval<T>{T(0)}});
+            this->_delays.assign(num_nodes, delay_type(0));
+            this->_min_delays.assign(num_nodes, delay_type(0));
+            this->_loads.assign(num_nodes, this->_model.sink_load());
+            this->_min_wires.assign(num_nodes, T(0));
+            this->_wires.assign(num_nodes, T(0));
+            this->_dirty.assign(num_nodes, 0);
+            this->_places.assign(num_nodes, Point<T>{T(0), T(0)});
+            this->_parents.assign(num_nodes, npos);
+            this->_schedule();
+        }
+
+        /**
+         * @brief Construct a new zero-skew DmeTree object under the given delay model.
+         *
+         * @param[in] sinks The sink locations, one per leaf of `topo`.
+         * @param[in] topo The tree topology.
+         * @param[in] model The delay model.
+         */
+        DmeTree(gsl::span<const Point<T>> sinks, ClockTopology topo, Delay model)
+            : DmeTree(sinks, std::move(topo), T(0), std::move(model)) {}
+
+        /**
+         * @brief Convert a point into a (single point) merging region.
+         *
+         * @param[in] pt The point in the original space.
+         * @return Region
+         */
+        static constexpr auto to_region(const Point<T> &pt) -> Region {
+            return Region{Interval<T>{T(pt.xcoord() + pt.ycoord())},
+                          Interval<T>{T(pt.xcoord() - pt.ycoord())}};
+        }
+
+        /**
+         * @brief The outcome of merging two subtrees.
+         */
+        struct Merged {
+            Region region;  //!< merging region of the parent
+            T delay;        //!< delay from the parent down to the sinks
+            T wire_left;    //!< wire length from the parent to the left child
+            T wire_right;   //!< wire length from the parent to the right child
+        };
+
+        /**
+         * @brief Zero-skew merge of two subtrees (a single DME bottom-up step).
+         *
+         * The tapping point splits the distance between the two regions so that both
+         * branches reach the same (linear) delay. If one subtree is slower by more than the
+         * distance, the other branch is elongated instead and the parent region is the slow
+         * subtree's region intersected with the enlarged fast one.
+         *
+         * @param[in] reg_l The merging region of the left subtree.
+         * @param[in] t_l The delay of the left subtree.
+         * @param[in] reg_r The merging region of the right subtree.
+         * @param[in] t_r The delay of the right subtree.
+         * @return Merged
+         */
+        static auto merge(const Region &reg_l, T t_l, const Region &reg_r, T t_r) -> Merged {
+            const T alpha = reg_l.min_dist_with(reg_r);
+            const auto [e_l, e_r] = LinearDelay<T>{}.split(alpha, t_l, T(0), t_r, T(0));
+            return Merged{intersection(enlarge(reg_l, e_l), enlarge(reg_r, e_r)),
+                          std::max(T(t_l + e_l), T(t_r + e_r)), e_l, e_r};
+        }
+
+        /**
+         * @brief The outcome of a bounded-skew merge of two subtrees.
+         */
+        struct BoundedMerged {
+            Region region;     //!< merging region of the parent
+            T min_delay;       //!< shortest delay from any point of the region to the sinks
+            T delay;           //!< longest delay from any point of the region to the sinks
+            T min_wire_left;   //!< shortest wire from the region to the left child
+            T min_wire_right;  //!< shortest wire from the region to the right child
+        };
+
+        /**
+         * @brief Bounded-skew merge of two subtrees (a single bottom-up step).
+         *
+         * A tapping point at distance `e` from the left region and `alpha - e` from the right
+         * one (`alpha` being their distance) keeps the sink delays within `[lo, hi]` for a
+         * range of `e`. Detour wiring is only needed when that range misses `[0, alpha]`, and it
+         * is shortened by the bound. Otherwise the slack left after centring the split widens
+         * `e` into `[e_a, e_b]`; the parent region is the largest tilted rectangle among the
+         * points reached that way, checked at its corners (distances are convex). The delay
+         * interval returned holds for every point of the region, so any later embedding keeps
+         * the skew within the bound.
+         *
+         * @param[in] reg_l The merging region of the left subtree.
+         * @param[in] tmin_l The shortest delay of the left subtree.
+         * @param[in] tmax_l The longest delay of the left subtree.
+         * @param[in] reg_r The merging region of the right subtree.
+         * @param[in] tmin_r The shortest delay of the right subtree.
+         * @param[in] tmax_r The longest delay of the right subtree.
+         * @param[in] bound The skew bound (at least the skew of each subtree).
+         * @return BoundedMerged
+         */
+        static auto merge_bounded(const Region &reg_l, T tmin_l, T tmax_l, const Region &reg_r,
+                                  T tmin_r, T tmax_r, T bound) -> BoundedMerged {
+            const T alpha = reg_l.min_dist_with(reg_r);
+            // the splits `e` keeping the spread within the bound
+            auto e_lo = _ceil_half(T(tmax_r + alpha - tmin_l - bound));
+            const auto e_hi = _floor_half(T(bound + tmin_r + alpha - tmax_l));
+            if (alpha < e_lo) {  // the left branch must be elongated
+                const auto e_l = std::max(alpha, T(tmax_r - tmin_l - bound));
+                return BoundedMerged{intersection(enlarge(reg_l, e_l), reg_r),
+                                     std::min(T(tmin_l + e_l), tmin_r),
+                                     std::max(T(tmax_l + e_l), tmax_r), e_l, T(0)};
+            }
+            if (e_hi < T(0)) {  // the right branch must be elongated
+                const auto e_r = std::max(alpha, T(tmax_l - tmin_r - bound));
+                return BoundedMerged{intersection(reg_l, enlarge(reg_r, e_r)),
+                                     std::min(tmin_l, T(tmin_r + e_r)),
+                                     std::max(tmax_l, T(tmax_r + e_r)), T(0), e_r};
+            }
+            e_lo = std::min(std::max(e_lo, T(0)), e_hi);  // rounding may cross them
+            const auto lo = e_lo;
+            const auto hi = std::min(e_hi, alpha);
+            const auto center = _floor_half(T(lo + hi));
+            auto spread = [&](T e_a, T e_b) {
+                return T(std::max(T(tmax_l + e_b), T(tmax_r + alpha - e_a))
+                         - std::min(T(tmin_l + e_a), T(tmin_r + alpha - e_b)));
+            };
+            const auto widen = std::max(T(0), _floor_half(T(bound - spread(center, center))));
+            const auto e_a = std::max(lo, T(center - widen));
+            const auto e_b = std::min(hi, T(center + widen));
+            auto cut = [&](T e_l) {
+                return intersection(enlarge(reg_l, e_l), enlarge(reg_r, T(alpha - e_l)));
+            };
+            auto region = cut(center);
+            auto reach_a = center;
+            auto reach_b = center;
+            if (e_a < e_b) {
+                const auto cut_a = cut(e_a);
+                const auto cut_b = cut(e_b);
+                // every corner of `cand` must lie between the two cuts
+                auto valid = [&](const Region &cand) {
+                    for (const auto u_c : {cand.xcoord().lb(), cand.xcoord().ub()}) {
+                        for (const auto v_c : {cand.ycoord().lb(), cand.ycoord().ub()}) {
+                            const auto corner = MergeObj<T, T>{T(u_c), T(v_c)};
+                            const T d_l = reg_l.min_dist_with(corner);
+                            const T d_r = reg_r.min_dist_with(corner);
+                            if (d_l + d_r != alpha || d_l < e_a || e_b < d_l) {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                };
+                auto best_size = region.xcoord().length() + region.ycoord().length();
+                for (const auto x_hull : {false, true}) {
+                    for (const auto y_hull : {false, true}) {
+                        const auto &x_a = cut_a.xcoord();
+                        const auto &x_b = cut_b.xcoord();
+                        const auto &y_a = cut_a.ycoord();
+                        const auto &y_b = cut_b.ycoord();
+                        if ((!x_hull && !overlap(x_a, x_b)) || (!y_hull && !overlap(y_a, y_b))) {
+                            continue;
+                        }
+                        auto cand = Region{x_hull ? x_a.hull_with(x_b) : x_a.intersect_with(x_b),
+                                           y_hull ? y_a.hull_with(y_b) : y_a.intersect_with(y_b)};
+                        const auto size = cand.xcoord().length() + cand.ycoord().length();
+                        if (best_size < size && valid(cand)) {
+                            region = std::move(cand);
+                            best_size = size;
+                            reach_a = e_a;
+                            reach_b = e_b;
+                        }
+                    }
+                }
+            }
+            return BoundedMerged{std::move(region),
+                                 std::min(T(tmin_l + reach_a), T(tmin_r + alpha - reach_b)),
+                                 std::max(T(tmax_l + reach_b), T(tmax_r + alpha - reach_a)),
+                                 reach_a, T(alpha - reach_b)};
+        }
+
+        /**
+         * @brief Build the tree: bottom-up merging followed by top-down embedding.
+         *
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        auto build(unsigned num_threads = 1) -> void {
+            this->merge_bottom_up(num_threads);
+            this->embed_top_down(num_threads);
+        }
+
+        /**
+         * @brief Bottom-up pass: compute the merging region and delay of every node.
+         *
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        auto merge_bottom_up(unsigned num_threads = 1) -> void {
+            RECTI_TIME_SCOPE(dme_merge);
+            for (auto level = std::size_t{1}; level + 1 < this->_level_starts.size(); ++level) {
+                this->_for_level(level, num_threads,
+                                 [this](std::size_t node) { this->_merge_node(node); });
+            }
+        }
+
+        /**
+         * @brief Top-down pass: embed every node inside its merging region.
+         *
+         * The root is placed at the lower corner of its region (in the rotated space); every
+         * other node at the point of its region closest to the location of its parent.
+         *
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        auto embed_top_down(unsigned num_threads = 1) -> void {
+            RECTI_TIME_SCOPE(dme_embed);
+            if (this->_topo.num_nodes() == 0) {
+                return;
+            }
+            const auto &root = this->_regions[this->_topo.root()];
+            this->_places[this->_topo.root()]
+                = Point<T>{root.xcoord().lb(), root.ycoord().lb()};
+            for (auto level = this->_level_starts.size() - 1; level-- > 0;) {
+                this->_for_level(level, num_threads, [this](std::size_t node) {
+                    if (!this->_topo.is_sink(node)) {
+                        const auto [left, right] = this->_children(node);
+                        this->_embed_child(node, left);
+                        this->_embed_child(node, right);
+                    }
+                });
+            }
+        }
+
+        /**
+         * @brief Move some sinks and update the tree incrementally.
+         *
+         * Only the nodes on the paths from the moved sinks to the root are merged again, in
+         * increasing index order (children before parents). The embedding is then redone from
+         * the root down, descending only into the subtrees whose root was re-merged or moved.
+         * The result is the same as rebuilding the tree for the new sink locations.
+         *
+         * @param[in] sinks The indices of the moved sinks.
+         * @param[in] positions Their new locations.
+         * @return std::size_t The number of nodes merged again.
+         */
+        auto move_sinks(gsl::span<const std::size_t> sinks, gsl::span<const Point<T>> positions)
+            -> std::size_t {
+            RECTI_TIME_SCOPE(dme_move_sinks);
+            assert(sinks.size() == positions.size());
+            auto stale = std::vector<std::size_t>{};
+            for (auto idx = std::size_t{0}; idx != sinks.size(); ++idx) {
+                const auto sink = sinks[idx];
+                assert(this->_topo.is_sink(sink));
+                this->_regions[sink] = to_region(positions[idx]);
+                this->_dirty[sink] = 1;
+                for (auto node = this->_parents[sink];
+                     node != npos && this->_dirty[node] == 0; node = this->_parents[node]) {
+                    this->_dirty[node] = 1;
+                    stale.push_back(node);
+                }
+            }
+            std::sort(stale.begin(), stale.end());
+            for (const auto node : stale) {
+                this->_merge_node(node);
+            }
+
+            if (!stale.empty()) {
+                const auto root = this->_topo.root();
+                const auto &reg = this->_regions[root];
+                this->_places[root] = Point<T>{reg.xcoord().lb(), reg.ycoord().lb()};
+                auto pending = std::vector<std::size_t>{root};
+                while (!pending.empty()) {
+                    const auto node = pending.back();
+                    pending.pop_back();
+                    const auto [left, right] = this->_children(node);
+                    for (const auto child : {left, right}) {
+                        const auto old_place = this->_places[child];
+                        this->_embed_child(node, child);
+                        if (!this->_topo.is_sink(child)
+                            && (this->_dirty[child] != 0 || this->_places[child] != old_place)) {
+                            pending.push_back(child);
+                        }
+                    }
+                }
+            }
+            for (const auto sink : sinks) {
+                this->_dirty[sink] = 0;
+            }
+            for (const auto node : stale) {
+                this->_dirty[node] = 0;
+            }
+            return stale.size();
+        }
+
+        /** @name Results
+         */
+        ///@{
+
+        /**
+         * @brief The topology the tree was built on.
+         *
+         * @return const ClockTopology&
+         */
+        auto topology() const noexcept -> const ClockTopology & { return this->_topo; }
+
+        /**
+         * @brief The merging region of a node.
+         *
+         * @param[in] node The node index.
+         * @return const Region&
+         */
+        auto region(std::size_t node) const -> const Region & { return this->_regions[node]; }
+
+        /**
+         * @brief The (longest) delay from a node down to its sinks.
+         *
+         * @param[in] node The node index.
+         * @return delay_type
+         */
+        auto delay(std::size_t node) const -> delay_type { return this->_delays[node]; }
+
+        /**
+         * @brief The shortest delay from a node down to its sinks.
+         *
+         * @param[in] node The node index.
+         * @return delay_type
+         */
+        auto min_delay(std::size_t node) const -> delay_type { return this->_min_delays[node]; }
+
+        /**
+         * @brief The downstream capacitance of a node (its subtree, wires and sinks).
+         *
+         * @param[in] node The node index.
+         * @return load_type
+         */
+        auto load(std::size_t node) const -> load_type { return this->_loads[node]; }
+
+        /**
+         * @brief The delay model.
+         *
+         * @return const Delay&
+         */
+        auto delay_model() const noexcept -> const Delay & { return this->_model; }
+
+        /**
+         * @brief The skew bound the tree is built with (0 for zero skew).
+         *
+         * @return T
+         */
+        auto skew_bound() const noexcept -> T { return this->_skew_bound; }
+
+        /**
+         * @brief The length of the wire from the parent of a node to the node.
+         *
+         * This may exceed the distance between the two embedded locations when the branch is
+         * elongated to balance the delay.
+         *
+         * @param[in] node The node index.
+         * @return T
+         */
+        auto wire_length(std::size_t node) const -> T { return this->_wires[node]; }
+
+        /**
+         * @brief The parent of a node (`npos` for the root).
+         *
+         * @param[in] node The node index.
+         * @return std::size_t
+         */
+        auto parent(std::size_t node) const -> std::size_t { return this->_parents[node]; }
+
+        /**
+         * @brief The embedded location of a node in the original space.
+         *
+         * @param[in] node The node index.
+         * @return Point<T>
+         */
+        auto position(std::size_t node) const -> Point<T> {
+            const auto &place = this->_places[node];
+            return Point<T>{T((place.xcoord() + place.ycoord()) / 2),
+                            T((place.xcoord() - place.ycoord()) / 2)};
+        }
+
+        /**
+         * @brief The total wire length of the tree.
+         *
+         * @return T
+         */
+        auto total_wire_length() const -> T {
+            auto total = T(0);
+            for (const auto &wire : this->_wires) {
+                total += wire;
+            }
+            return total;
+        }
+
+        ///@}
+
+      private:
+        auto _children(std::size_t node) const -> std::pair<std::size_t, std::size_t> {
+            return this->_topo.children[node - this->_topo.num_sinks];
+        }
+
+        /**
+         * @brief Bucket the nodes by height so that each bucket can be processed in parallel.
+         */
+        auto _schedule() -> void {
+            const auto num_nodes = this->_topo.num_nodes();
+            auto heights = std::vector<std::size_t>(num_nodes, 0);
+            auto max_height = std::size_t{0};
+            for (auto node = this->_topo.num_sinks; node != num_nodes; ++node) {
+                const auto [left, right] = this->_children(node);
+                assert(left < node && right < node);
+                this->_parents[left] = node;
+                this->_parents[right] = node;
+                heights[node] = std::max(heights[left], heights[right]) + 1;
+                max_height = std::max(max_height, heights[node]);
+            }
+            this->_level_starts.assign(max_height + 2, 0);
+            for (auto node = std::size_t{0}; node != num_nodes; ++node) {
+                ++this->_level_starts[heights[node] + 1];
+            }
+            for (auto level = std::size_t{1}; level != this->_level_starts.size(); ++level) {
+                this->_level_starts[level] += this->_level_starts[level - 1];
+            }
+            this->_order.resize(num_nodes);
+            auto fill = this->_level_starts;
+            for (auto node = std::size_t{0}; node != num_nodes; ++node) {
+                this->_order[fill[heights[node]]++] = node;
+            }
+        }
+
+        template <typename Fn>
+        auto _for_level(std::size_t level, unsigned num_threads, Fn &&fn) -> void {
+            const auto first = this->_level_starts[level];
+            const auto last = this->_level_starts[level + 1];
+            // keep small levels on the calling thread: spawning costs more than merging
+            const auto grain = std::size_t{256};
+            parallel_for(
+                first, last, [this, &fn](std::size_t idx) { fn(this->_order[idx]); },
+                last - first < 2 * grain ? 1U : num_threads, grain);
+        }
+
+        auto _merge_node(std::size_t node) -> void {
+            const auto [left, right] = this->_children(node);
+            if constexpr (Delay::is_linear) {
+                if (this->_skew_bound > T(0)) {
+                    auto merged = merge_bounded(this->_regions[left], this->_min_delays[left],
+                                                this->_delays[left], this->_regions[right],
+                                                this->_min_delays[right], this->_delays[right],
+                                                this->_skew_bound);
+                    this->_regions[node] = std::move(merged.region);
+                    this->_delays[node] = merged.delay;
+                    this->_min_delays[node] = merged.min_delay;
+                    this->_min_wires[left] = this->_wires[left] = merged.min_wire_left;
+                    this->_min_wires[right] = this->_wires[right] = merged.min_wire_right;
+                    return;
+                }
+            }
+            const auto &reg_l = this->_regions[left];
+            const auto &reg_r = this->_regions[right];
+            const auto &load_l = this->_loads[left];
+            const auto &load_r = this->_loads[right];
+            const T alpha = reg_l.min_dist_with(reg_r);
+            const auto [e_l, e_r] = this->_model.split(alpha, this->_delays[left], load_l,
+                                                       this->_delays[right], load_r);
+            const auto d_l = this->_model.wire_delay(e_l, load_l);
+            const auto d_r = this->_model.wire_delay(e_r, load_r);
+            this->_regions[node] = intersection(enlarge(reg_l, e_l), enlarge(reg_r, e_r));
+            this->_delays[node] = std::max(delay_type(this->_delays[left] + d_l),
+                                           delay_type(this->_delays[right] + d_r));
+            this->_min_delays[node] = std::min(delay_type(this->_min_delays[left] + d_l),
+                                               delay_type(this->_min_delays[right] + d_r));
+            this->_loads[node] = load_type(load_l + load_r + this->_model.wire_load(e_l)
+                                           + this->_model.wire_load(e_r));
+            this->_min_wires[left] = this->_wires[left] = e_l;
+            this->_min_wires[right] = this->_wires[right] = e_r;
+        }
+
+        static auto _floor_half(T value) -> T {
+            if constexpr (std::is_integral_v<T>) {
+                return value < T(0) ? T(-((1 - value) / 2)) : T(value / 2);
+            } else {
+                return value / 2;
+            }
+        }
+
+        static auto _ceil_half(T value) -> T { return T(-_floor_half(T(-value))); }
+
+        auto _embed_child(std::size_t node, std::size_t child) -> void {
+            const auto &place = this->_places[node];
+            const auto &reg = this->_regions[child];
+            auto u_c = std::clamp(place.xcoord(), reg.xcoord().lb(), reg.xcoord().ub());
+            auto v_c = std::clamp(place.ycoord(), reg.ycoord().lb(), reg.ycoord().ub());
+            if constexpr (std::is_integral_v<T>) {
+                // Only points with `u + v` even map back to integer points (x, y). Step to the
+                // neighbour inside the region that stays closest to the parent; stepping the
+                // coordinate with the smaller gap never lengthens the connection.
+                if (((u_c + v_c) & 1) != 0) {
+                    auto best = Point<T>{u_c, v_c};
+                    auto best_dist = T(-1);
+                    const T steps[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+                    for (const auto &step : steps) {
+                        const auto cand = Point<T>{T(u_c + step[0]), T(v_c + step[1])};
+                        if (!reg.xcoord().contains(cand.xcoord())
+                            || !reg.ycoord().contains(cand.ycoord())) {
+                            continue;
+                        }
+                        const T dist = std::max(min_dist(cand.xcoord(), place.xcoord()),
+                                                min_dist(cand.ycoord(), place.ycoord()));
+                        if (best_dist < 0 || dist < best_dist) {
+                            best = cand;
+                            best_dist = dist;
+                        }
+                    }
+                    u_c = best.xcoord();
+                    v_c = best.ycoord();
+                }
+            }
+            this->_places[child] = Point<T>{u_c, v_c};
+            if (this->_skew_bound > T(0)) {  // the region may leave more than the planned wire
+                const T dist = std::max(min_dist(u_c, place.xcoord()),
+                                        min_dist(v_c, place.ycoord()));
+                this->_wires[child] = std::max(this->_min_wires[child], dist);
+            }
+        }
+    };
+
+}  // namespace recti
@@ -2,9 +2,23 @@
 
 // #include <algorithm> // import std::min, std::max
 #include <cassert>
-#include <cmath>  // for abs
+#include <cmath>        // for abs
+#include <type_traits>  // for std::is_arithmetic_v, std::is_same_v
+
+#include "instrument.hpp"  // for RECTI_COUNT
 
 namespace recti {
+    namespace detail {
+        /**
+         * @brief Whether `U1` and `U2` are the same built-in arithmetic type.
+         *
+         * For such pairs the dispatchers below skip the member-function probing and reduce to
+         * one comparison or subtraction, which cannot throw.
+         */
+        template <typename U1, typename U2> inline constexpr bool same_scalar_v
+            = std::is_arithmetic_v<U1> && std::is_same_v<U1, U2>;
+    }  // namespace detail
+
     /**
      * @brief Checks if two objects overlap.
      *
@@ -30,8 +44,14 @@ namespace recti {
      * @return `true` if the two objects overlap, `false` otherwise.
      */
     template <typename U1, typename U2>  //
-    constexpr auto overlap(const U1 &lhs, const U2 &rhs) -> bool {
-        if constexpr (requires { lhs.overlaps(rhs); }) {
+    constexpr auto overlap(const U1 &lhs, const U2 &rhs) noexcept(detail::same_scalar_v<U1, U2>)
+        -> bool {
+        if constexpr (!detail::same_scalar_v<U1, U2>) {
+            RECTI_COUNT(overlap);  // the scalar comparisons underneath are not counted
+        }
+        if constexpr (detail::same_scalar_v<U1, U2>) {
+            return lhs == rhs;
+        } else if constexpr (requires { lhs.overlaps(rhs); }) {
             return lhs.overlaps(rhs);
         } else if constexpr (requires { rhs.overlaps(lhs); }) {
             return rhs.overlaps(lhs);
@@ -64,8 +84,14 @@ namespace recti {
      * @return `true` if the first object contains the second object, `false` otherwise.
      */
     template <typename U1, typename U2>  //
-    constexpr auto contain(const U1 &lhs, const U2 &rhs) -> bool {
-        if constexpr (requires { lhs.contains(rhs); }) {
+    constexpr auto contain(const U1 &lhs, const U2 &rhs) noexcept(detail::same_scalar_v<U1, U2>)
+        -> bool {
+        if constexpr (!detail::same_scalar_v<U1, U2>) {
+            RECTI_COUNT(contain);  // the scalar comparisons underneath are not counted
+        }
+        if constexpr (detail::same_scalar_v<U1, U2>) {
+            return lhs == rhs;
+        } else if constexpr (requires { lhs.contains(rhs); }) {
             return lhs.contains(rhs);
         } else if constexpr (requires { rhs.contains(lhs); }) {
             return false;
@@ -101,8 +127,15 @@ namespace recti {
      * @return The intersection of `lhs` and `rhs`.
      */
     template <typename U1, typename U2>  //
-    constexpr auto intersection(const U1 &lhs, const U2 &rhs) {
-        if constexpr (requires { lhs.intersect_with(rhs); }) {
+    constexpr auto intersection(const U1 &lhs, const U2 &rhs) noexcept(
+        detail::same_scalar_v<U1, U2>) {
+        if constexpr (!detail::same_scalar_v<U1, U2>) {
+            RECTI_COUNT(intersection);  // the scalar comparisons underneath are not counted
+        }
+        if constexpr (detail::same_scalar_v<U1, U2>) {
+            assert(lhs == rhs);
+            return lhs;
+        } else if constexpr (requires { lhs.intersect_with(rhs); }) {
             return lhs.intersect_with(rhs);
         } else if constexpr (requires { rhs.intersect_with(lhs); }) {
             return rhs.intersect_with(lhs);
@@ -137,8 +170,13 @@ namespace recti {
      * @return The minimum distance between `lhs` and `rhs`.
      */
     template <typename U1, typename U2>  //
-    constexpr auto min_dist(const U1 &lhs, const U2 &rhs) {
-        if constexpr (requires { lhs.min_dist_with(rhs); }) {
+    constexpr auto min_dist(const U1 &lhs, const U2 &rhs) noexcept(detail::same_scalar_v<U1, U2>) {
+        if constexpr (!detail::same_scalar_v<U1, U2>) {
+            RECTI_COUNT(min_dist);  // the scalar comparisons underneath are not counted
+        }
+        if constexpr (detail::same_scalar_v<U1, U2>) {
+            return lhs < rhs ? rhs - lhs : lhs - rhs;  // a conditional move; also for unsigned
+        } else if constexpr (requires { lhs.min_dist_with(rhs); }) {
             return lhs.min_dist_with(rhs);
         } else if constexpr (requires { rhs.min_dist_with(lhs); }) {
             return rhs.min_dist_with(lhs);
@@ -166,8 +204,10 @@ namespace recti {
      * the objects.
      */
     template <typename U1, typename U2>  //
-    constexpr auto min_dist_change(U1 &lhs, U2 &rhs) {
-        if constexpr (requires { lhs.min_dist_change_with(rhs); }) {
+    constexpr auto min_dist_change(U1 &lhs, U2 &rhs) noexcept(detail::same_scalar_v<U1, U2>) {
+        if constexpr (detail::same_scalar_v<U1, U2>) {
+            return lhs < rhs ? rhs - lhs : lhs - rhs;
+        } else if constexpr (requires { lhs.min_dist_change_with(rhs); }) {
             return lhs.min_dist_change_with(rhs);
         } else if constexpr (requires { rhs.min_dist_change_with(lhs); }) {
             return rhs.min_dist_change_with(lhs);
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <array>    // for std::array
+#include <bit>      // for std::countr_zero
+#include <cassert>  // for assert
 #include <cmath>
+#include <cstdint>  // for std::uint32_t
+#include <gsl/span>
 #include <vector>
 
+#include "recti.hpp"
+
 namespace recti {
 
     /**
@@ -100,4 +107,236 @@ namespace recti {
         }
     };
 
+    namespace detail {
+        /**
+         * @brief Reverse the bits of a 32-bit word.
+         *
+         * @param[in] word
+         * @return std::uint32_t
+         */
+        constexpr auto reverse_bits(std::uint32_t word) noexcept -> std::uint32_t {
+            word = ((word >> 1) & 0x55555555U) | ((word & 0x55555555U) << 1);
+            word = ((word >> 2) & 0x33333333U) | ((word & 0x33333333U) << 2);
+            word = ((word >> 4) & 0x0F0F0F0FU) | ((word & 0x0F0F0F0FU) << 4);
+            word = ((word >> 8) & 0x00FF00FFU) | ((word & 0x00FF00FFU) << 8);
+            return (word >> 16) | (word << 16);
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Table-driven van der Corput sequence generator
+     *
+     * Produces exactly the same sequence as `Vdcorput(base, scale)`, without `std::pow` or
+     * per-sample division loops:
+     *
+     *  - `operator()` updates the previous value incrementally. The base-`b` digits of the
+     *    counter are kept as an odometer with a table of per-digit factors, so a step costs
+     *    O(1) amortized. For base 2 the step is branch-free: going from `n - 1` to `n` flips
+     *    the `countr_zero(n) + 1` lowest bits of the counter, i.e. XORs a mask of reversed bits
+     *    into the value (the binary-reflected Gray code trick).
+     *  - `at(num)` evaluates any index directly from a digit-reversal table covering several
+     *    digits at once (bit reversal for base 2), so `reseed` can jump ahead in O(log num)
+     *    and each thread can generate its own disjoint subsequence.
+     *
+     * As for `Vdcorput`, `base` to the power of `scale` must fit in `unsigned`.
+     */
+    class VdcorputTable {
+      private:
+        static constexpr std::size_t max_digits = 32;
+
+        unsigned _base;
+        unsigned _scale;
+        unsigned _count{0};
+        unsigned _value{0};
+        std::array<unsigned, max_digits> _factors{};  // base^(scale-1-i), 0 past the scale
+        std::array<unsigned, max_digits> _digits{};   // the counter in base `base`
+        // digit-reversal table for `_chunk_digits` digits at a time
+        unsigned _chunk_digits{1};
+        unsigned _chunk_base{2};
+        std::vector<unsigned> _reversed{};
+        std::vector<unsigned> _chunk_mul{};
+        std::vector<unsigned> _chunk_div{};
+
+      public:
+        /**
+         * @brief Construct a new VdcorputTable object
+         *
+         * @param[in] base
+         * @param[in] scale
+         */
+        explicit VdcorputTable(unsigned base = 2, unsigned scale = 10)
+            : _base{base}, _scale{scale} {
+            assert(base >= 2 && scale >= 1 && scale <= max_digits);
+            auto factor = 1U;
+            for (auto pos = scale; pos-- != 0;) {
+                this->_factors[pos] = factor;
+                factor *= base;
+            }
+            if (base == 2) {
+                return;  // bit reversal, no tables needed
+            }
+            // as many digits per table entry as fit in 256 entries
+            this->_chunk_base = base;
+            while (std::size_t(this->_chunk_base) * base <= 256) {
+                this->_chunk_base *= base;
+                ++this->_chunk_digits;
+            }
+            this->_reversed.resize(this->_chunk_base);
+            for (auto idx = 0U; idx != this->_chunk_base; ++idx) {
+                auto rev = 0U;
+                auto num = idx;
+                for (auto i = 0U; i != this->_chunk_digits; ++i) {
+                    rev = rev * base + num % base;
+                    num /= base;
+                }
+                this->_reversed[idx] = rev;
+            }
+            for (auto pos = 0U; pos < scale; pos += this->_chunk_digits) {
+                const auto end = pos + this->_chunk_digits;
+                auto mul = 1U;
+                auto div = 1U;
+                for (auto i = end; i < scale; ++i) {
+                    mul *= base;
+                }
+                for (auto i = scale; i < end; ++i) {
+                    div *= base;
+                }
+                this->_chunk_mul.push_back(mul);
+                this->_chunk_div.push_back(div);
+            }
+        }
+
+        /**
+         * @brief The value of the sequence at index `num` (`vdc(num, base, scale)`).
+         *
+         * @param[in] num
+         * @return unsigned
+         */
+        auto at(unsigned num) const noexcept -> unsigned {
+            if (this->_base == 2) {
+                return detail::reverse_bits(num) >> (32 - this->_scale);
+            }
+            auto res = 0U;
+            for (auto chunk = std::size_t{0}; chunk != this->_chunk_mul.size() && num != 0;
+                 ++chunk) {
+                const auto rev = this->_reversed[num % this->_chunk_base];
+                num /= this->_chunk_base;
+                res += rev * this->_chunk_mul[chunk] / this->_chunk_div[chunk];
+            }
+            return res;
+        }
+
+        /**
+         * @brief The next value of the sequence.
+         *
+         * @return unsigned
+         */
+        auto operator()() noexcept -> unsigned {
+            ++this->_count;
+            if (this->_base == 2) {
+                const auto flips = unsigned(std::countr_zero(this->_count));
+                const auto mask = flips >= 31 ? ~0U : (2U << flips) - 1;
+                this->_value ^= detail::reverse_bits(mask) >> (32 - this->_scale);
+                return this->_value;
+            }
+            auto pos = std::size_t{0};
+            while (this->_digits[pos] + 1 == this->_base) {
+                this->_value -= this->_digits[pos] * this->_factors[pos];
+                this->_digits[pos] = 0;
+                ++pos;
+            }
+            ++this->_digits[pos];
+            this->_value += this->_factors[pos];
+            return this->_value;
+        }
+
+        /**
+         * @brief Fill a span with the next `out.size()` values of the sequence.
+         *
+         * @param[out] out
+         */
+        auto fill(gsl::span<unsigned> out) noexcept -> void {
+            for (auto &val : out) {
+                val = (*this)();
+            }
+        }
+
+        /**
+         * @brief Jump to index `seed`; the next call returns `at(seed + 1)`.
+         *
+         * @param[in] seed
+         */
+        auto reseed(unsigned seed) noexcept -> void {
+            this->_count = seed;
+            this->_value = this->at(seed);
+            for (auto &digit : this->_digits) {
+                digit = seed % this->_base;
+                seed /= this->_base;
+            }
+        }
+    };
+
+    /**
+     * @brief Table-driven Halton sequence generator
+     *
+     * The same sequence as `halton`, returned as `Point<unsigned>` instead of a freshly
+     * allocated `std::vector<unsigned>` per sample. See `VdcorputTable`.
+     */
+    class HaltonTable {
+      private:
+        VdcorputTable _vdc0;
+        VdcorputTable _vdc1;
+
+      public:
+        /**
+         * @brief Construct a new HaltonTable object
+         *
+         * @param[in] base
+         * @param[in] scale
+         */
+        HaltonTable(const unsigned base[], const unsigned scale[])
+            : _vdc0(base[0], scale[0]), _vdc1(base[1], scale[1]) {}
+
+        /**
+         * @brief The next point of the sequence.
+         *
+         * @return Point<unsigned>
+         */
+        auto operator()() noexcept -> Point<unsigned> {
+            const auto xcoord = this->_vdc0();
+            return {xcoord, this->_vdc1()};
+        }
+
+        /**
+         * @brief The point of the sequence at index `num`.
+         *
+         * @param[in] num
+         * @return Point<unsigned>
+         */
+        auto at(unsigned num) const noexcept -> Point<unsigned> {
+            return {this->_vdc0.at(num), this->_vdc1.at(num)};
+        }
+
+        /**
+         * @brief Fill a span with the next `out.size()` points of the sequence.
+         *
+         * @param[out] out
+         */
+        auto fill(gsl::span<Point<unsigned>> out) noexcept -> void {
+            for (auto &pt : out) {
+                pt = (*this)();
+            }
+        }
+
+        /**
+         * @brief Jump to index `seed`; the next call returns `at(seed + 1)`.
+         *
+         * @param[in] seed
+         */
+        auto reseed(unsigned seed) noexcept -> void {
+            this->_vdc0.reseed(seed);
+            this->_vdc1.reseed(seed);
+        }
+    };
+
 }  // namespace recti
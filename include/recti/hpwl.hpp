@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>  // for std::min, std::max
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t
+#include <gsl/span>
+#include <vector>
+
+#include "instrument.hpp"
+#include "parallel.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Netlist-level half-perimeter wirelength (HPWL) with incremental updates
+     *
+     * The pins are stored as a structure of arrays (x-coordinates, y-coordinates, owning cell
+     * and offset within it), grouped by net, so the bounding box of a net is a min/max
+     * reduction over two contiguous arrays, a loop the compiler vectorizes. `update_all()`
+     * reduces every net, in parallel over the nets.
+     *
+     * For each net, the bounding box is kept together with the number of pins on each of its
+     * four sides. `move_cells()` then walks only the pins of the moved cells: a pin moving
+     * outwards pushes the side, a pin joining or leaving a side changes its count, and only a
+     * net whose side count drops to zero is reduced again. The total HPWL is kept up to date.
+     *
+     * Net `i` has the pins `pin_offsets[i] .. pin_offsets[i + 1]` of the flat pin arrays given
+     * to the constructor (the `PolygonSet::offsets()` layout).
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> class HpwlNetlist {
+        // the four sides of a net bounding box
+        struct NetBox {
+            T x_lo, x_hi, y_lo, y_hi;
+            std::uint32_t n_x_lo, n_x_hi, n_y_lo, n_y_hi;
+        };
+
+        std::vector<std::size_t> _net_starts;  // net `i` owns pins `[_net_starts[i], ..[i+1])`
+        std::vector<T> _pin_x, _pin_y;         // absolute pin positions (SoA)
+        std::vector<T> _pin_dx, _pin_dy;       // pin offsets within their cells
+        std::vector<std::size_t> _pin_net;
+        std::vector<std::size_t> _cell_starts;  // cell `c` owns `_cell_pins[_cell_starts[c] ..]`
+        std::vector<std::size_t> _cell_pins;
+        std::vector<Point<T>> _cells;
+        std::vector<NetBox> _boxes;
+        std::vector<std::size_t> _stamp;  // last `move_cells` call that touched the net
+        std::vector<std::size_t> _touched;  // scratch list of the nets of one `move_cells`
+        std::size_t _epoch{0};
+        accumulator_t<T> _total{};
+
+      public:
+        /**
+         * @brief Build the netlist and compute every net bounding box.
+         *
+         * @param[in] net_offsets The offset table of the nets (`num_nets + 1` entries, from 0).
+         * @param[in] pin_cells The cell of each pin.
+         * @param[in] pin_offsets The offset of each pin from the position of its cell.
+         * @param[in] cells The initial cell positions.
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        HpwlNetlist(gsl::span<const std::size_t> net_offsets,
+                    gsl::span<const std::size_t> pin_cells,
+                    gsl::span<const Vector2<T>> pin_offsets, gsl::span<const Point<T>> cells,
+                    unsigned num_threads = 1)
+            : _net_starts(net_offsets.begin(), net_offsets.end()),
+              _pin_x(pin_cells.size()),
+              _pin_y(pin_cells.size()),
+              _pin_net(pin_cells.size()),
+              _cell_starts(cells.size() + 1, 0),
+              _cell_pins(pin_cells.size()),
+              _cells(cells.begin(), cells.end()),
+              _boxes(net_offsets.size() - 1),
+              _stamp(net_offsets.size() - 1, 0) {
+            assert(!net_offsets.empty() && net_offsets.back() == pin_cells.size());
+            assert(pin_offsets.size() == pin_cells.size());
+            this->_pin_dx.reserve(pin_offsets.size());
+            this->_pin_dy.reserve(pin_offsets.size());
+            for (const auto &offset : pin_offsets) {
+                this->_pin_dx.push_back(offset.x());
+                this->_pin_dy.push_back(offset.y());
+            }
+            for (auto net = std::size_t{0}; net != this->num_nets(); ++net) {
+                for (auto pin = net_offsets[net]; pin != net_offsets[net + 1]; ++pin) {
+                    this->_pin_net[pin] = net;
+                }
+            }
+            // cell -> pins, by a counting sort
+            for (const auto cell : pin_cells) {
+                ++this->_cell_starts[cell + 1];
+            }
+            for (auto cell = std::size_t{0}; cell != cells.size(); ++cell) {
+                this->_cell_starts[cell + 1] += this->_cell_starts[cell];
+            }
+            auto fill = this->_cell_starts;
+            for (auto pin = std::size_t{0}; pin != pin_cells.size(); ++pin) {
+                this->_cell_pins[fill[pin_cells[pin]]++] = pin;
+            }
+            this->update_all(num_threads);
+        }
+
+        /**
+         * @brief The number of nets.
+         *
+         * @return std::size_t
+         */
+        auto num_nets() const noexcept -> std::size_t { return this->_boxes.size(); }
+
+        /**
+         * @brief The number of cells.
+         *
+         * @return std::size_t
+         */
+        auto num_cells() const noexcept -> std::size_t { return this->_cells.size(); }
+
+        /**
+         * @brief The position of a cell.
+         *
+         * @param[in] cell The cell index.
+         * @return const Point<T>&
+         */
+        auto cell(std::size_t cell) const -> const Point<T> & { return this->_cells[cell]; }
+
+        /**
+         * @brief The total HPWL of all nets.
+         *
+         * @return accumulator_t<T>
+         */
+        auto total() const noexcept -> accumulator_t<T> { return this->_total; }
+
+        /**
+         * @brief The HPWL of one net (0 for a net without pins).
+         *
+         * @param[in] net The net index.
+         * @return T
+         */
+        auto hpwl(std::size_t net) const -> T {
+            const auto &box = this->_boxes[net];
+            return this->_is_empty(net) ? T(0) : (box.x_hi - box.x_lo) + (box.y_hi - box.y_lo);
+        }
+
+        /**
+         * @brief The bounding box of the pins of a net (which must have pins).
+         *
+         * @param[in] net The net index.
+         * @return Rectangle<T>
+         */
+        auto bounding_box(std::size_t net) const -> Rectangle<T> {
+            assert(!this->_is_empty(net));
+            const auto &box = this->_boxes[net];
+            return Rectangle<T>{Interval<T>{box.x_lo, box.x_hi}, Interval<T>{box.y_lo, box.y_hi}};
+        }
+
+        /**
+         * @brief Recompute all pin positions and net bounding boxes from the cell positions.
+         *
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        auto update_all(unsigned num_threads = 1) -> void {
+            RECTI_TIME_SCOPE(hpwl_update);
+            auto place = [this](std::size_t cell) {
+                for (auto idx = this->_cell_starts[cell]; idx != this->_cell_starts[cell + 1];
+                     ++idx) {
+                    this->_place_pin(this->_cell_pins[idx], this->_cells[cell]);
+                }
+            };
+            parallel_for(std::size_t{0}, this->num_cells(), place, num_threads, 1024);
+            auto reduce = [this](std::size_t net) { this->_reduce(net); };
+            parallel_for(std::size_t{0}, this->num_nets(), reduce, num_threads, 256);
+            this->_total = accumulator_t<T>(0);
+            for (auto net = std::size_t{0}; net != this->num_nets(); ++net) {
+                this->_total += widen(this->hpwl(net));
+            }
+        }
+
+        /**
+         * @brief Move some cells and update the nets they touch incrementally.
+         *
+         * @param[in] cells The cells to move (each at most once).
+         * @param[in] positions Their new positions.
+         * @return accumulator_t<T> The change of the total HPWL.
+         */
+        auto move_cells(gsl::span<const std::size_t> cells, gsl::span<const Point<T>> positions)
+            -> accumulator_t<T> {
+            RECTI_COUNT(hpwl_move_cells);
+            assert(cells.size() == positions.size());
+            ++this->_epoch;
+            auto delta = accumulator_t<T>(0);
+            // the old HPWL of every touched net is subtracted once, the new one added at the end
+            auto &touched = this->_touched;
+            touched.clear();
+            for (auto idx = std::size_t{0}; idx != cells.size(); ++idx) {
+                const auto cell = cells[idx];
+                for (auto pos = this->_cell_starts[cell]; pos != this->_cell_starts[cell + 1];
+                     ++pos) {
+                    const auto net = this->_pin_net[this->_cell_pins[pos]];
+                    if (this->_stamp[net] != this->_epoch) {
+                        this->_stamp[net] = this->_epoch;
+                        touched.push_back(net);
+                        delta -= widen(this->hpwl(net));
+                    }
+                }
+            }
+            for (auto idx = std::size_t{0}; idx != cells.size(); ++idx) {
+                const auto cell = cells[idx];
+                this->_cells[cell] = positions[idx];
+                for (auto pos = this->_cell_starts[cell]; pos != this->_cell_starts[cell + 1];
+                     ++pos) {
+                    const auto pin = this->_cell_pins[pos];
+                    const auto old_x = this->_pin_x[pin];
+                    const auto old_y = this->_pin_y[pin];
+                    this->_place_pin(pin, positions[idx]);
+                    auto &box = this->_boxes[this->_pin_net[pin]];
+                    auto stale = false;
+                    stale |= _move_low(box.x_lo, box.n_x_lo, old_x, this->_pin_x[pin]);
+                    stale |= _move_high(box.x_hi, box.n_x_hi, old_x, this->_pin_x[pin]);
+                    stale |= _move_low(box.y_lo, box.n_y_lo, old_y, this->_pin_y[pin]);
+                    stale |= _move_high(box.y_hi, box.n_y_hi, old_y, this->_pin_y[pin]);
+                    if (stale) {  // a side lost its last pin: reduce the net again
+                        this->_reduce(this->_pin_net[pin]);
+                    }
+                }
+            }
+            for (const auto net : touched) {
+                delta += widen(this->hpwl(net));
+            }
+            this->_total += delta;
+            return delta;
+        }
+
+      private:
+        auto _is_empty(std::size_t net) const -> bool {
+            return this->_net_starts[net] == this->_net_starts[net + 1];
+        }
+
+        auto _place_pin(std::size_t pin, const Point<T> &cell) -> void {
+            this->_pin_x[pin] = cell.xcoord() + this->_pin_dx[pin];
+            this->_pin_y[pin] = cell.ycoord() + this->_pin_dy[pin];
+        }
+
+        // a pin of the net moved from `old_val` to `new_val`; returns true if the side is stale
+        static auto _move_low(T &side, std::uint32_t &count, const T &old_val, const T &new_val)
+            -> bool {
+            if (new_val < side) {
+                side = new_val;
+                count = 1;
+            } else if (new_val == side) {
+                count += std::uint32_t(old_val != side);
+            } else if (old_val == side) {
+                return --count == 0;
+            }
+            return false;
+        }
+
+        static auto _move_high(T &side, std::uint32_t &count, const T &old_val, const T &new_val)
+            -> bool {
+            if (side < new_val) {
+                side = new_val;
+                count = 1;
+            } else if (new_val == side) {
+                count += std::uint32_t(old_val != side);
+            } else if (old_val == side) {
+                return --count == 0;
+            }
+            return false;
+        }
+
+        // min/max over the contiguous pins of the net, then the pins on each side
+        auto _reduce(std::size_t net) -> void {
+            auto &box = this->_boxes[net];
+            const auto first = this->_net_starts[net];
+            const auto last = this->_net_starts[net + 1];
+            if (first == last) {
+                box = NetBox{T(0), T(0), T(0), T(0), 0, 0, 0, 0};
+                return;
+            }
+            const auto *xs = this->_pin_x.data();
+            const auto *ys = this->_pin_y.data();
+            auto x_lo = xs[first], x_hi = xs[first];
+            auto y_lo = ys[first], y_hi = ys[first];
+            for (auto pin = first + 1; pin < last; ++pin) {
+                x_lo = std::min(x_lo, xs[pin]);
+                x_hi = std::max(x_hi, xs[pin]);
+                y_lo = std::min(y_lo, ys[pin]);
+                y_hi = std::max(y_hi, ys[pin]);
+            }
+            auto n_x_lo = std::uint32_t{0}, n_x_hi = std::uint32_t{0};
+            auto n_y_lo = std::uint32_t{0}, n_y_hi = std::uint32_t{0};
+            for (auto pin = first; pin < last; ++pin) {
+                n_x_lo += std::uint32_t(xs[pin] == x_lo);
+                n_x_hi += std::uint32_t(xs[pin] == x_hi);
+                n_y_lo += std::uint32_t(ys[pin] == y_lo);
+                n_y_hi += std::uint32_t(ys[pin] == y_hi);
+            }
+            box = NetBox{x_lo, x_hi, y_lo, y_hi, n_x_lo, n_x_hi, n_y_lo, n_y_hi};
+        }
+    };
+
+}  // namespace recti
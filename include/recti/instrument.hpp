@@ -0,0 +1,295 @@
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint8_t
+
+/**
+ * @file instrument.hpp
+ * @brief Opt-in call counters and timers for the geometry kernels and batch engines
+ *
+ * Compile with `RECTI_INSTRUMENT` defined to enable them. The kernels then count their calls
+ * (`RECTI_COUNT`) and the batch engines time themselves (`RECTI_TIME_SCOPE`); otherwise both
+ * macros expand to nothing and this header only declares the `Probe` names, so an
+ * uninstrumented build is unchanged.
+ *
+ * Every thread updates its own counters (relaxed atomics written by that thread only), which
+ * `instrument::summary()` adds up on demand. With `instrument::set_tracing(true)` each timed
+ * scope is also recorded as an event, and `write_chrome_trace` writes them in the Chrome trace
+ * event format (for `chrome://tracing` or Perfetto); `write_json` writes the totals.
+ */
+
+namespace recti::instrument {
+
+    /// The instrumented kernels (counted) and engines (counted and timed).
+    enum class Probe : std::uint8_t {
+        overlap,
+        contain,
+        intersection,
+        min_dist,
+        merge_with,
+        rtree_build,
+        rtree_query,
+        overlap_sweep,
+        segment_crossings,
+        rpolygon_boolean,
+        cts_topology,
+        dme_merge,
+        dme_embed,
+        dme_move_sinks,
+        maze_route,
+        hpwl_update,
+        hpwl_move_cells,
+    };
+
+    inline constexpr std::size_t num_probes = std::size_t(Probe::hpwl_move_cells) + 1;
+
+    inline constexpr const char *probe_names[num_probes] = {
+        "overlap",           "contain",          "intersection", "min_dist",
+        "merge_with",        "rtree_build",      "rtree_query",  "overlap_sweep",
+        "segment_crossings", "rpolygon_boolean", "cts_topology", "dme_merge",
+        "dme_embed",         "dme_move_sinks",   "maze_route",   "hpwl_update",
+        "hpwl_move_cells",
+    };
+
+    /**
+     * @brief The name of a probe (as used in the JSON and trace output).
+     *
+     * @param[in] probe The probe.
+     * @return const char*
+     */
+    constexpr auto name_of(Probe probe) noexcept -> const char * {
+        return probe_names[std::size_t(probe)];
+    }
+
+#ifdef RECTI_INSTRUMENT
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+
+}  // namespace recti::instrument
+
+#ifdef RECTI_INSTRUMENT
+
+#    include <array>        // for std::array
+#    include <atomic>       // for std::atomic
+#    include <chrono>       // for std::chrono::steady_clock
+#    include <memory>       // for std::unique_ptr
+#    include <mutex>        // for std::mutex, std::lock_guard
+#    include <ostream>      // for std::ostream
+#    include <type_traits>  // for std::is_constant_evaluated
+#    include <vector>
+
+namespace recti::instrument {
+
+    /// One timed scope, in nanoseconds since the start of the registry.
+    struct TraceEvent {
+        Probe probe;
+        std::uint64_t start_ns;
+        std::uint64_t duration_ns;
+    };
+
+    /// The totals of all threads.
+    struct Summary {
+        std::array<std::uint64_t, num_probes> calls{};
+        std::array<std::uint64_t, num_probes> nanos{};
+    };
+
+    namespace detail {
+        inline constexpr std::size_t max_events_per_thread = std::size_t{1} << 20U;
+
+        using Clock = std::chrono::steady_clock;
+
+        struct ThreadLog {
+            std::array<std::atomic<std::uint64_t>, num_probes> calls{};
+            std::array<std::atomic<std::uint64_t>, num_probes> nanos{};
+            std::mutex mutex;  // guards `events` against a concurrent dump
+            std::vector<TraceEvent> events;
+            std::size_t tid{0};
+        };
+
+        // single writer: a load and a store, not a locked read-modify-write
+        inline auto bump(std::atomic<std::uint64_t> &cell, std::uint64_t value) noexcept
+            -> void {
+            cell.store(cell.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        class Registry {
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<ThreadLog>> _logs;  // kept after their thread exits
+
+          public:
+            const Clock::time_point epoch = Clock::now();
+            std::atomic<bool> tracing{false};
+
+            static auto instance() -> Registry & {
+                static auto registry = Registry{};
+                return registry;
+            }
+
+            auto add_thread() -> ThreadLog * {
+                const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+                this->_logs.push_back(std::make_unique<ThreadLog>());
+                this->_logs.back()->tid = this->_logs.size();
+                return this->_logs.back().get();
+            }
+
+            template <typename Fn> auto for_each_log(Fn &&fn) -> void {
+                const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+                for (auto &log : this->_logs) {
+                    fn(*log);
+                }
+            }
+        };
+
+        inline auto local_log() -> ThreadLog & {
+            thread_local auto *const log = Registry::instance().add_thread();
+            return *log;
+        }
+
+        inline auto nanoseconds(Clock::duration elapsed) -> std::uint64_t {
+            return std::uint64_t(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Count one call of `probe` on this thread (nothing during constant evaluation, so
+     * that the constexpr kernels can count).
+     *
+     * @param[in] probe The probe.
+     */
+    constexpr auto count(Probe probe) noexcept -> void {
+        if (!std::is_constant_evaluated()) {
+            detail::bump(detail::local_log().calls[std::size_t(probe)], 1);
+        }
+    }
+
+    /**
+     * @brief Scoped timer: counts one call of `probe` and adds the time until its destruction
+     * (and records a trace event when tracing is on).
+     */
+    class ScopedTimer {
+        Probe _probe;
+        detail::Clock::time_point _start;
+
+      public:
+        explicit ScopedTimer(Probe probe) noexcept
+            : _probe{probe}, _start{detail::Clock::now()} {}
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        auto operator=(const ScopedTimer &) -> ScopedTimer & = delete;
+
+        ~ScopedTimer() {
+            const auto nanos = detail::nanoseconds(detail::Clock::now() - this->_start);
+            auto &log = detail::local_log();
+            detail::bump(log.calls[std::size_t(this->_probe)], 1);
+            detail::bump(log.nanos[std::size_t(this->_probe)], nanos);
+            auto &registry = detail::Registry::instance();
+            if (registry.tracing.load(std::memory_order_relaxed)) {
+                const auto start = detail::nanoseconds(this->_start - registry.epoch);
+                const auto lock = std::lock_guard<std::mutex>{log.mutex};
+                if (log.events.size() < detail::max_events_per_thread) {
+                    log.events.push_back({this->_probe, start, nanos});
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Turn the recording of trace events on or off (off by default).
+     *
+     * @param[in] on Whether to record.
+     */
+    inline auto set_tracing(bool on) noexcept -> void {
+        detail::Registry::instance().tracing.store(on, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The totals of all threads so far.
+     *
+     * @return Summary
+     */
+    inline auto summary() -> Summary {
+        auto result = Summary{};
+        detail::Registry::instance().for_each_log([&result](detail::ThreadLog &log) {
+            for (auto idx = std::size_t{0}; idx != num_probes; ++idx) {
+                result.calls[idx] += log.calls[idx].load(std::memory_order_relaxed);
+                result.nanos[idx] += log.nanos[idx].load(std::memory_order_relaxed);
+            }
+        });
+        return result;
+    }
+
+    /**
+     * @brief Clear the counters and the trace events of all threads.
+     *
+     * Meant for quiet points of a flow: a thread counting concurrently may lose its update.
+     */
+    inline auto reset() -> void {
+        detail::Registry::instance().for_each_log([](detail::ThreadLog &log) {
+            for (auto idx = std::size_t{0}; idx != num_probes; ++idx) {
+                log.calls[idx].store(0, std::memory_order_relaxed);
+                log.nanos[idx].store(0, std::memory_order_relaxed);
+            }
+            const auto lock = std::lock_guard<std::mutex>{log.mutex};
+            log.events.clear();
+        });
+    }
+
+    /**
+     * @brief Write the totals as JSON: `{"<probe>": {"calls": n, "total_ns": t}, ...}`.
+     *
+     * @param[out] out The output stream.
+     */
+    inline auto write_json(std::ostream &out) -> void {
+        const auto totals = summary();
+        out << "{";
+        for (auto idx = std::size_t{0}; idx != num_probes; ++idx) {
+            out << (idx == 0 ? "\n" : ",\n") << "  \"" << probe_names[idx] << "\": {\"calls\": "
+                << totals.calls[idx] << ", \"total_ns\": " << totals.nanos[idx] << "}";
+        }
+        out << "\n}\n";
+    }
+
+    /**
+     * @brief Write the recorded events in the Chrome trace event format (complete events,
+     * one track per thread, times in microseconds).
+     *
+     * @param[out] out The output stream.
+     */
+    inline auto write_chrome_trace(std::ostream &out) -> void {
+        auto first = true;
+        out << "{\"traceEvents\": [";
+        detail::Registry::instance().for_each_log([&out, &first](detail::ThreadLog &log) {
+            const auto lock = std::lock_guard<std::mutex>{log.mutex};
+            for (const auto &event : log.events) {
+                out << (first ? "\n" : ",\n") << "  {\"name\": \"" << name_of(event.probe)
+                    << "\", \"cat\": \"recti\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << log.tid
+                    << ", \"ts\": " << double(event.start_ns) / 1000.0
+                    << ", \"dur\": " << double(event.duration_ns) / 1000.0 << "}";
+                first = false;
+            }
+        });
+        out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+    }
+
+}  // namespace recti::instrument
+
+#    define RECTI_INSTRUMENT_CAT2(a, b) a##b
+#    define RECTI_INSTRUMENT_CAT(a, b) RECTI_INSTRUMENT_CAT2(a, b)
+
+/// Count a call of `probe`.
+#    define RECTI_COUNT(probe) ::recti::instrument::count(::recti::instrument::Probe::probe)
+
+/// Count and time the rest of the enclosing scope as `probe`.
+#    define RECTI_TIME_SCOPE(probe)                                 \
+        const ::recti::instrument::ScopedTimer RECTI_INSTRUMENT_CAT( \
+            recti_timer_, __LINE__)(::recti::instrument::Probe::probe)
+
+#else
+
+#    define RECTI_COUNT(probe) static_cast<void>(0)
+#    define RECTI_TIME_SCOPE(probe) static_cast<void>(0)
+
+#endif
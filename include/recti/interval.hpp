@@ -1,7 +1,8 @@
 #pragma once
 
-// #include <algorithm> // import std::min, std::max
-#include <utility>  // import std::move
+#include <algorithm>    // import std::min, std::max
+#include <type_traits>  // import std::is_arithmetic_v, std::is_same_v
+#include <utility>      // import std::move
 
 #include "generic.hpp"
 
@@ -22,6 +23,14 @@ namespace recti {
         T _lb;  //> lower bound
         T _ub;  //> upper bound
 
+        // `other` is an `Interval<T>` or a `T` of arithmetic type: the fast paths below apply
+        template <typename U> static constexpr bool _is_fast_interval
+            = std::is_arithmetic_v<T> && std::is_same_v<U, Interval<T>>;
+        template <typename U> static constexpr bool _is_fast_scalar
+            = std::is_arithmetic_v<T> && std::is_same_v<U, T>;
+        template <typename U> static constexpr bool _is_fast
+            = _is_fast_interval<U> || _is_fast_scalar<U>;
+
       public:
         using value_type = T;
 
@@ -83,7 +92,7 @@ namespace recti {
          *
          * @return a reference to a constant object of type T.
          */
-        constexpr auto lb() const -> const T & { return this->_lb; }
+        constexpr auto lb() const noexcept -> const T & { return this->_lb; }
 
         /**
          * @brief upper bound
@@ -92,7 +101,7 @@ namespace recti {
          *
          * @return a reference to a constant object of type T.
          */
-        constexpr auto ub() const -> const T & { return this->_ub; }
+        constexpr auto ub() const noexcept -> const T & { return this->_ub; }
 
         /**
          * @brief length
@@ -326,8 +335,14 @@ namespace recti {
          * @return `true` if the intervals overlap, `false` otherwise.
          */
         template <typename U>  // cppcheck-suppress internalAstError
-        constexpr auto overlaps(const U &other) const -> bool {
-            return !(*this < other || other < *this);
+        constexpr auto overlaps(const U &other) const noexcept(_is_fast<U>) -> bool {
+            if constexpr (_is_fast_interval<U>) {  // both tests, no short-circuit branch
+                return (other._lb <= this->_ub) & (this->_lb <= other._ub);
+            } else if constexpr (_is_fast_scalar<U>) {
+                return (this->_lb <= other) & (other <= this->_ub);
+            } else /* constexpr */ {
+                return !(*this < other || other < *this);
+            }
         }
 
         /**
@@ -349,8 +364,12 @@ namespace recti {
          * scalar value, `false` otherwise.
          */
         template <typename U>  // cppcheck-suppress internalAstError
-        constexpr auto contains(const U &other) const -> bool {
-            if constexpr (requires { other.lb(); }) {
+        constexpr auto contains(const U &other) const noexcept(_is_fast<U>) -> bool {
+            if constexpr (_is_fast_interval<U>) {
+                return (this->_lb <= other._lb) & (other._ub <= this->_ub);
+            } else if constexpr (_is_fast_scalar<U>) {
+                return (this->_lb <= other) & (other <= this->_ub);
+            } else if constexpr (requires { other.lb(); }) {
                 return this->lb() <= other.lb() && other.ub() <= this->ub();
             } else /* constexpr */ {  // assume scalar
                 return this->lb() <= other && other <= this->ub();
@@ -374,8 +393,12 @@ namespace recti {
          * value.
          */
         template <typename U>  //
-        constexpr auto intersect_with(const U &other) const {
-            if constexpr (requires { other.lb(); }) {
+        constexpr auto intersect_with(const U &other) const noexcept(_is_fast<U>) {
+            if constexpr (_is_fast_interval<U>) {  // min/max, which compile to cmov or pmin/pmax
+                return Interval<T>{std::max(this->_lb, other._lb), std::min(this->_ub, other._ub)};
+            } else if constexpr (_is_fast_scalar<U>) {
+                return Interval<T>{std::max(this->_lb, other), std::min(this->_ub, other)};
+            } else if constexpr (requires { other.lb(); }) {
                 return Interval<T>{this->lb() > other.lb() ? this->lb() : T(other.lb()),
                                    this->ub() < other.ub() ? this->ub() : T(other.ub())};
             } else /* constexpr */ {  // assume scalar
@@ -401,8 +424,12 @@ namespace recti {
          * value.
          */
         template <typename U>  //
-        constexpr auto hull_with(const U &other) const {
-            if constexpr (requires { other.lb(); }) {
+        constexpr auto hull_with(const U &other) const noexcept(_is_fast<U>) {
+            if constexpr (_is_fast_interval<U>) {
+                return Interval<T>{std::min(this->_lb, other._lb), std::max(this->_ub, other._ub)};
+            } else if constexpr (_is_fast_scalar<U>) {
+                return Interval<T>{std::min(this->_lb, other), std::max(this->_ub, other)};
+            } else if constexpr (requires { other.lb(); }) {
                 return Interval<T>{this->lb() < other.lb() ? this->lb() : T(other.lb()),
                                    this->ub() > other.ub() ? this->ub() : T(other.ub())};
             } else /* constexpr */ {  // assume scalar
@@ -428,14 +455,26 @@ namespace recti {
          * @return The minimum distance between the current interval and the `other` interval or
          * scalar value.
          */
-        template <typename U> constexpr auto min_dist_with(const U &other) const -> T {
-            if (*this < other) {
-                return min_dist(this->_ub, other);
-            }
-            if (other < *this) {
-                return min_dist(this->_lb, other);
+        template <typename U>
+        constexpr auto min_dist_with(const U &other) const noexcept(_is_fast<U>) -> T {
+            if constexpr (_is_fast<U> && std::is_signed_v<T>) {
+                // the gap on either side, or a non-positive value when they overlap (explicit
+                // `T`, as the differences of short coordinates are promoted to int)
+                if constexpr (_is_fast_interval<U>) {
+                    return std::max<T>(std::max<T>(other._lb - this->_ub, this->_lb - other._ub),
+                                       T(0));
+                } else {
+                    return std::max<T>(std::max<T>(other - this->_ub, this->_lb - other), T(0));
+                }
+            } else /* constexpr */ {
+                if (*this < other) {
+                    return min_dist(this->_ub, other);
+                }
+                if (other < *this) {
+                    return min_dist(this->_lb, other);
+                }
+                return T(0);
             }
-            return T(0);
         }
 
         /**
@@ -540,7 +579,8 @@ namespace recti {
      */
     template <typename U1, typename U2>  //
     constexpr auto enlarge(const U1 &lhs, const U2 &rhs) {
-        if constexpr (requires { lhs.enlarge_with(rhs); }) {
+        // note: `enlarge_with` modifies its object, so probe it on a non-const copy
+        if constexpr (requires(U1 res) { res.enlarge_with(rhs); }) {
             auto res{lhs};
             res.enlarge_with(rhs);
             return res;
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t
+#include <tuple>    // for std::tie
+#include <utility>  // for std::move
+#include <vector>
+
+#include "interval.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Interval Tree
+     *
+     * `IntervalTree` is a dynamic collection of `Interval<T>` objects (each with an attached
+     * value, e.g. a track or a cell index) that supports insertion, erasure, stabbing queries
+     * and overlap enumeration. It is implemented as a treap ordered by `(lb, ub, value)` in
+     * which every node is augmented with the maximum upper bound of its subtree, so whole
+     * subtrees that end before the query are pruned.
+     *
+     * All nodes live in one contiguous pool and are linked by 32-bit indices; erased nodes are
+     * recycled through a free list, so steady-state insert/erase does not touch the heap.
+     *
+     * As in `Interval`, the bounds are closed: `[1, 3]` and `[3, 5]` overlap.
+     *
+     * @tparam T The coordinate type.
+     * @tparam V The type of the value attached to each interval.
+     */
+    template <typename T, typename V = std::size_t> class IntervalTree {
+        using Index = std::uint32_t;
+        static constexpr Index nil = ~Index{0};
+
+        struct Node {
+            Interval<T> ivl;
+            V value;
+            T max_ub;
+            std::uint32_t prio;
+            Index left;
+            Index right;
+        };
+
+        std::vector<Node> _pool{};
+        std::vector<Index> _free{};
+        Index _root{nil};
+        std::size_t _size{0};
+        std::uint32_t _seed{2463534242U};
+
+      public:
+        /**
+         * @brief Construct an empty interval tree.
+         */
+        IntervalTree() = default;
+
+        /**
+         * @brief The number of intervals in the tree.
+         *
+         * @return std::size_t
+         */
+        auto size() const noexcept -> std::size_t { return this->_size; }
+
+        /**
+         * @brief Whether the tree is empty.
+         *
+         * @return true if there is no interval.
+         */
+        auto empty() const noexcept -> bool { return this->_size == 0; }
+
+        /**
+         * @brief Reserve node storage for `num` intervals.
+         *
+         * @param[in] num The number of intervals.
+         */
+        auto reserve(std::size_t num) -> void { this->_pool.reserve(num); }
+
+        /**
+         * @brief Remove all intervals (the node storage is kept).
+         */
+        auto clear() noexcept -> void {
+            this->_pool.clear();
+            this->_free.clear();
+            this->_root = nil;
+            this->_size = 0;
+        }
+
+        /**
+         * @brief Insert an interval with its value.
+         *
+         * Duplicates are allowed. The expected cost is O(log n).
+         *
+         * @param[in] ivl The interval.
+         * @param[in] value The attached value.
+         */
+        auto insert(const Interval<T> &ivl, V value) -> void {
+            const auto node = this->_new_node(ivl, std::move(value));
+            auto [left, right] = this->_split(this->_root, this->_pool[node]);
+            this->_root = this->_merge(this->_merge(left, node), right);
+            ++this->_size;
+        }
+
+        /**
+         * @brief Erase one occurrence of an interval with the given value.
+         *
+         * @param[in] ivl The interval.
+         * @param[in] value The attached value.
+         * @return true if an entry was found and erased.
+         */
+        auto erase(const Interval<T> &ivl, const V &value) -> bool {
+            auto erased = false;
+            this->_root = this->_erase(this->_root, ivl, value, erased);
+            if (erased) {
+                --this->_size;
+            }
+            return erased;
+        }
+
+        /**
+         * @brief Stabbing query: visit every interval containing the point `alpha`.
+         *
+         * The callback is invoked as `fn(interval, value)` in increasing `(lb, ub, value)`
+         * order.
+         *
+         * @tparam Fn The callback type.
+         * @param[in] alpha The query point.
+         * @param[in] fn The callback.
+         */
+        template <typename Fn> auto stab(const T &alpha, Fn &&fn) const -> void {
+            this->_query(this->_root, Interval<T>{alpha, alpha}, fn);
+        }
+
+        /**
+         * @brief Overlap enumeration: visit every interval overlapping `query`.
+         *
+         * The callback is invoked as `fn(interval, value)` in increasing `(lb, ub, value)`
+         * order.
+         *
+         * @tparam Fn The callback type.
+         * @param[in] query The query interval.
+         * @param[in] fn The callback.
+         */
+        template <typename Fn> auto overlapping(const Interval<T> &query, Fn &&fn) const -> void {
+            this->_query(this->_root, query, fn);
+        }
+
+        /**
+         * @brief Collect the values of all intervals overlapping `query`.
+         *
+         * @param[in] query The query interval.
+         * @return std::vector<V>
+         */
+        auto overlapping(const Interval<T> &query) const -> std::vector<V> {
+            auto result = std::vector<V>{};
+            auto collect = [&result](const Interval<T> &, const V &value) {
+                result.push_back(value);
+            };
+            this->_query(this->_root, query, collect);
+            return result;
+        }
+
+        /**
+         * @brief Whether any interval overlaps `query`.
+         *
+         * @param[in] query The query interval.
+         * @return true if at least one interval overlaps.
+         */
+        auto overlaps(const Interval<T> &query) const -> bool {
+            auto node = this->_root;
+            while (node != nil) {
+                const auto &cur = this->_pool[node];
+                if (cur.ivl.overlaps(query)) {
+                    return true;
+                }
+                // If the left subtree reaches the query but holds no overlap, then its
+                // interval with the largest `ub` starts after the query ends, and so does
+                // everything in the right subtree. Either way one branch suffices.
+                const auto left = cur.left;
+                if (left != nil && !(this->_pool[left].max_ub < query.lb())) {
+                    node = left;
+                } else {
+                    node = cur.right;
+                }
+            }
+            return false;
+        }
+
+      private:
+        auto _random() noexcept -> std::uint32_t {  // xorshift32
+            this->_seed ^= this->_seed << 13;
+            this->_seed ^= this->_seed >> 17;
+            this->_seed ^= this->_seed << 5;
+            return this->_seed;
+        }
+
+        auto _new_node(const Interval<T> &ivl, V &&value) -> Index {
+            auto node = Node{ivl, std::move(value), ivl.ub(), this->_random(), nil, nil};
+            if (!this->_free.empty()) {
+                const auto idx = this->_free.back();
+                this->_free.pop_back();
+                this->_pool[idx] = std::move(node);
+                return idx;
+            }
+            this->_pool.push_back(std::move(node));
+            return Index(this->_pool.size() - 1);
+        }
+
+        static auto _less(const Interval<T> &ivl1, const V &val1, const Interval<T> &ivl2,
+                          const V &val2) -> bool {
+            return std::tie(ivl1.lb(), ivl1.ub(), val1) < std::tie(ivl2.lb(), ivl2.ub(), val2);
+        }
+
+        auto _update(Index node) -> void {
+            auto &cur = this->_pool[node];
+            cur.max_ub = cur.ivl.ub();
+            if (cur.left != nil && cur.max_ub < this->_pool[cur.left].max_ub) {
+                cur.max_ub = this->_pool[cur.left].max_ub;
+            }
+            if (cur.right != nil && cur.max_ub < this->_pool[cur.right].max_ub) {
+                cur.max_ub = this->_pool[cur.right].max_ub;
+            }
+        }
+
+        // split into (keys < key, keys >= key)
+        auto _split(Index node, const Node &key) -> std::pair<Index, Index> {
+            if (node == nil) {
+                return {nil, nil};
+            }
+            auto &cur = this->_pool[node];
+            if (_less(cur.ivl, cur.value, key.ivl, key.value)) {
+                auto [left, right] = this->_split(cur.right, key);
+                this->_pool[node].right = left;
+                this->_update(node);
+                return {node, right};
+            }
+            auto [left, right] = this->_split(cur.left, key);
+            this->_pool[node].left = right;
+            this->_update(node);
+            return {left, node};
+        }
+
+        auto _merge(Index left, Index right) -> Index {
+            if (left == nil) {
+                return right;
+            }
+            if (right == nil) {
+                return left;
+            }
+            if (this->_pool[left].prio > this->_pool[right].prio) {
+                this->_pool[left].right = this->_merge(this->_pool[left].right, right);
+                this->_update(left);
+                return left;
+            }
+            this->_pool[right].left = this->_merge(left, this->_pool[right].left);
+            this->_update(right);
+            return right;
+        }
+
+        auto _erase(Index node, const Interval<T> &ivl, const V &value, bool &erased) -> Index {
+            if (node == nil) {
+                return nil;
+            }
+            auto &cur = this->_pool[node];
+            if (_less(ivl, value, cur.ivl, cur.value)) {
+                const auto left = this->_erase(cur.left, ivl, value, erased);
+                this->_pool[node].left = left;
+            } else if (_less(cur.ivl, cur.value, ivl, value)) {
+                const auto right = this->_erase(cur.right, ivl, value, erased);
+                this->_pool[node].right = right;
+            } else {
+                erased = true;
+                this->_free.push_back(node);
+                return this->_merge(cur.left, cur.right);
+            }
+            this->_update(node);
+            return node;
+        }
+
+        template <typename Fn>
+        auto _query(Index node, const Interval<T> &query, Fn &fn) const -> void {
+            while (node != nil) {
+                const auto &cur = this->_pool[node];
+                if (cur.max_ub < query.lb()) {
+                    return;  // everything in this subtree ends before the query
+                }
+                this->_query(cur.left, query, fn);
+                if (query.ub() < cur.ivl.lb()) {
+                    return;  // this node and its right subtree start after the query
+                }
+                if (!(cur.ivl.ub() < query.lb())) {
+                    fn(cur.ivl, cur.value);
+                }
+                node = cur.right;
+            }
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>  // for std::min, std::max
+#include <cstddef>    // for std::size_t
+#include <gsl/span>
+#include <iterator>  // for std::back_inserter
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "polygon.hpp"
+#include "recti.hpp"
+#include "rpolygon.hpp"
+
+namespace recti {
+
+    /// The output formats of `LayoutWriter`.
+    enum class LayoutFormat { svg, tikz };
+
+    /**
+     * @brief Buffered SVG/TikZ writer for large sets of shapes
+     *
+     * The shapes are formatted with `fmt` into one memory buffer that is written to the
+     * stream in chunks, so the cost per shape is a few integer or float conversions.
+     *
+     * Only the part of the layout inside the viewport is drawn: a shape whose bounding box
+     * does not overlap the viewport is skipped, and the picture is clipped to it (by the SVG
+     * `viewBox`, by a `\clip` in TikZ). Shapes whose bounding box is smaller than `min_size`
+     * output units in both directions are skipped as well (level-of-detail culling), which
+     * keeps a million-shape layout drawable at low zoom.
+     *
+     * Output coordinates are `(coord - viewport corner) * scale`; SVG puts the y-axis
+     * downwards, so y-coordinates are flipped there.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> class LayoutWriter {
+        std::ostream &_out;
+        LayoutFormat _format;
+        Rectangle<T> _viewport;
+        double _scale;
+        double _min_size;
+        std::size_t _chunk_size;
+        fmt::memory_buffer _buffer;
+        std::string _style;
+        std::vector<Point<T>> _verts;  // scratch for `Polygon`/`RPolygon` vertices
+        std::size_t _num_drawn{0};
+        std::size_t _num_culled{0};
+        bool _closed{false};
+
+      public:
+        /**
+         * @brief Start a picture of the `viewport` part of the layout.
+         *
+         * @param[in] out The output stream, which must outlive the writer.
+         * @param[in] format The output format.
+         * @param[in] viewport The region of the layout to draw.
+         * @param[in] scale The output units per layout unit.
+         * @param[in] min_size The size (in output units) below which shapes are skipped.
+         * @param[in] chunk_size The number of bytes buffered before writing to `out`.
+         */
+        LayoutWriter(std::ostream &out, LayoutFormat format, const Rectangle<T> &viewport,
+                     double scale = 1.0, double min_size = 0.0,
+                     std::size_t chunk_size = std::size_t{1} << 20)
+            : _out{out},
+              _format{format},
+              _viewport{viewport},
+              _scale{scale},
+              _min_size{min_size},
+              _chunk_size{chunk_size} {
+            const auto width = double(viewport.xcoord().length()) * scale;
+            const auto height = double(viewport.ycoord().length()) * scale;
+            if (format == LayoutFormat::svg) {
+                fmt::format_to(std::back_inserter(this->_buffer),
+                               "<svg viewBox='0 0 {} {}' xmlns='http://www.w3.org/2000/svg'>\n",
+                               width, height);
+                this->style("#88C0D0", "black");
+            } else {
+                fmt::format_to(std::back_inserter(this->_buffer),
+                               "\\begin{{tikzpicture}}\n\\clip (0,0) rectangle ({},{});\n", width,
+                               height);
+                this->style("cyan!30", "black");
+            }
+        }
+
+        LayoutWriter(const LayoutWriter &) = delete;
+        auto operator=(const LayoutWriter &) -> LayoutWriter & = delete;
+
+        ~LayoutWriter() { this->close(); }
+
+        /**
+         * @brief Set the fill and stroke colors of the shapes drawn next (SVG colors; for
+         * TikZ, any color expressions of `xcolor`).
+         *
+         * @param[in] fill The fill color, or "none".
+         * @param[in] stroke The stroke color, or "none".
+         */
+        auto style(std::string_view fill, std::string_view stroke) -> void {
+            this->_style.clear();
+            if (this->_format == LayoutFormat::svg) {
+                fmt::format_to(std::back_inserter(this->_style), " fill='{}' stroke='{}'", fill,
+                               stroke);
+                return;
+            }
+            const auto has_fill = fill != "none";
+            const auto has_stroke = stroke != "none";
+            if (has_fill) {
+                fmt::format_to(std::back_inserter(this->_style), "fill={}", fill);
+            }
+            if (has_stroke) {
+                fmt::format_to(std::back_inserter(this->_style), "{}draw={}",
+                               has_fill ? "," : "", stroke);
+            }
+        }
+
+        /**
+         * @brief Draw a rectangle.
+         *
+         * @param[in] rect The rectangle.
+         * @return true if it was drawn (not culled).
+         */
+        auto rectangle(const Rectangle<T> &rect) -> bool {
+            if (!this->_visible(rect)) {
+                return false;
+            }
+            auto out = std::back_inserter(this->_buffer);
+            const auto x1 = this->_x(rect.xcoord().lb());
+            const auto x2 = this->_x(rect.xcoord().ub());
+            if (this->_format == LayoutFormat::svg) {
+                const auto y2 = this->_y(rect.ycoord().ub());
+                fmt::format_to(out, "<rect x='{}' y='{}' width='{}' height='{}'{} />\n", x1, y2,
+                               x2 - x1, this->_y(rect.ycoord().lb()) - y2, this->_style);
+            } else {
+                fmt::format_to(out, "\\path[{}] ({},{}) rectangle ({},{});\n", this->_style, x1,
+                               this->_y(rect.ycoord().lb()), x2, this->_y(rect.ycoord().ub()));
+            }
+            this->_drawn();
+            return true;
+        }
+
+        /**
+         * @brief Draw rectangles.
+         *
+         * @param[in] rects The rectangles.
+         * @return std::size_t The number drawn.
+         */
+        auto rectangles(gsl::span<const Rectangle<T>> rects) -> std::size_t {
+            auto count = std::size_t{0};
+            for (const auto &rect : rects) {
+                count += std::size_t(this->rectangle(rect));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Draw a polygon given by its vertices.
+         *
+         * @param[in] pointset The vertices.
+         * @return true if it was drawn (not culled).
+         */
+        auto polygon(gsl::span<const Point<T>> pointset) -> bool {
+            return this->_polygon(pointset, false);
+        }
+
+        /**
+         * @brief Draw a rectilinear polygon given by its point list (from each point,
+         * horizontally then vertically to the next one, as for `RPolygon`).
+         *
+         * @param[in] pointset The point list.
+         * @return true if it was drawn (not culled).
+         */
+        auto rpolygon(gsl::span<const Point<T>> pointset) -> bool {
+            return this->_polygon(pointset, true);
+        }
+
+        /**
+         * @brief Draw a `Polygon`.
+         *
+         * @param[in] poly The polygon.
+         * @return true if it was drawn (not culled).
+         */
+        template <typename Alloc> auto draw(const Polygon<T, Alloc> &poly) -> bool {
+            if (!this->_visible(poly.bounding_box())) {
+                return false;
+            }
+            this->_vertices_of(poly);
+            this->_emit(this->_verts, false);
+            return true;
+        }
+
+        /**
+         * @brief Draw an `RPolygon`.
+         *
+         * @param[in] poly The rectilinear polygon.
+         * @return true if it was drawn (not culled).
+         */
+        template <typename Alloc> auto draw(const RPolygon<T, Alloc> &poly) -> bool {
+            if (!this->_visible(poly.bounding_box())) {
+                return false;
+            }
+            this->_vertices_of(poly);
+            this->_emit(this->_verts, true);
+            return true;
+        }
+
+        /**
+         * @brief Draw a point as a dot (never culled by size).
+         *
+         * @param[in] pt The point.
+         * @param[in] radius The radius in output units.
+         * @return true if it was drawn (inside the viewport).
+         */
+        auto point(const Point<T> &pt, double radius) -> bool {
+            if (!this->_viewport.contains(pt)) {
+                ++this->_num_culled;
+                return false;
+            }
+            auto out = std::back_inserter(this->_buffer);
+            if (this->_format == LayoutFormat::svg) {
+                fmt::format_to(out, "<circle cx='{}' cy='{}' r='{}'{} />\n",
+                               this->_x(pt.xcoord()), this->_y(pt.ycoord()), radius, this->_style);
+            } else {
+                fmt::format_to(out, "\\path[{}] ({},{}) circle ({});\n", this->_style,
+                               this->_x(pt.xcoord()), this->_y(pt.ycoord()), radius);
+            }
+            this->_drawn();
+            return true;
+        }
+
+        /**
+         * @brief The number of shapes drawn so far.
+         *
+         * @return std::size_t
+         */
+        auto num_drawn() const noexcept -> std::size_t { return this->_num_drawn; }
+
+        /**
+         * @brief The number of shapes skipped so far (outside the viewport or too small).
+         *
+         * @return std::size_t
+         */
+        auto num_culled() const noexcept -> std::size_t { return this->_num_culled; }
+
+        /**
+         * @brief End the picture and write out the buffer (also done by the destructor).
+         */
+        auto close() -> void {
+            if (this->_closed) {
+                return;
+            }
+            this->_closed = true;
+            fmt::format_to(std::back_inserter(this->_buffer), "{}",
+                           this->_format == LayoutFormat::svg ? "</svg>\n"
+                                                              : "\\end{tikzpicture}\n");
+            this->_flush();
+            this->_out.flush();
+        }
+
+      private:
+        auto _x(const T &xcoord) const -> double {
+            return double(xcoord - this->_viewport.xcoord().lb()) * this->_scale;
+        }
+
+        auto _y(const T &ycoord) const -> double {
+            return this->_format == LayoutFormat::svg
+                       ? double(this->_viewport.ycoord().ub() - ycoord) * this->_scale
+                       : double(ycoord - this->_viewport.ycoord().lb()) * this->_scale;
+        }
+
+        auto _visible(const Rectangle<T> &bbox) -> bool {
+            const auto tiny = double(bbox.xcoord().length()) * this->_scale < this->_min_size
+                              && double(bbox.ycoord().length()) * this->_scale < this->_min_size;
+            if (tiny || !this->_viewport.overlaps(bbox)) {
+                ++this->_num_culled;
+                return false;
+            }
+            return true;
+        }
+
+        template <typename Poly> auto _vertices_of(const Poly &poly) -> void {
+            this->_verts.clear();
+            for (auto idx = std::size_t{0}; idx != poly.num_vertices(); ++idx) {
+                this->_verts.push_back(poly.vertex(idx));
+            }
+        }
+
+        auto _bounding_box(gsl::span<const Point<T>> pointset) const -> Rectangle<T> {
+            auto x_lo = pointset[0].xcoord(), x_hi = x_lo;
+            auto y_lo = pointset[0].ycoord(), y_hi = y_lo;
+            for (const auto &pt : pointset) {
+                x_lo = std::min(x_lo, pt.xcoord());
+                x_hi = std::max(x_hi, pt.xcoord());
+                y_lo = std::min(y_lo, pt.ycoord());
+                y_hi = std::max(y_hi, pt.ycoord());
+            }
+            return Rectangle<T>{Interval<T>{x_lo, x_hi}, Interval<T>{y_lo, y_hi}};
+        }
+
+        auto _polygon(gsl::span<const Point<T>> pointset, bool rectilinear) -> bool {
+            if (pointset.empty() || !this->_visible(this->_bounding_box(pointset))) {
+                return false;
+            }
+            this->_emit(pointset, rectilinear);
+            return true;
+        }
+
+        // the vertices, with the implied corners of a rectilinear point list
+        auto _emit(gsl::span<const Point<T>> pointset, bool rectilinear) -> void {
+            const auto svg = this->_format == LayoutFormat::svg;
+            auto out = std::back_inserter(this->_buffer);
+            if (svg) {
+                fmt::format_to(out, "<polygon points='");
+            } else {
+                fmt::format_to(out, "\\path[{}] ", this->_style);
+            }
+            const auto *sep = "";
+            auto vertex = [&](const T &xcoord, const T &ycoord) {
+                if (svg) {
+                    fmt::format_to(out, "{}{},{}", sep, this->_x(xcoord), this->_y(ycoord));
+                } else {
+                    fmt::format_to(out, "{}({},{})", sep, this->_x(xcoord), this->_y(ycoord));
+                }
+                sep = svg ? " " : " -- ";
+            };
+            for (auto idx = std::size_t{0}; idx != pointset.size(); ++idx) {
+                const auto &pt = pointset[idx];
+                vertex(pt.xcoord(), pt.ycoord());
+                if (rectilinear) {
+                    const auto &next = pointset[idx + 1 == pointset.size() ? 0 : idx + 1];
+                    vertex(next.xcoord(), pt.ycoord());
+                }
+            }
+            if (svg) {
+                fmt::format_to(out, "'{} />\n", this->_style);
+            } else {
+                fmt::format_to(out, " -- cycle;\n");
+            }
+            this->_drawn();
+        }
+
+        auto _drawn() -> void {
+            ++this->_num_drawn;
+            if (this->_buffer.size() >= this->_chunk_size) {
+                this->_flush();
+            }
+        }
+
+        auto _flush() -> void {
+            this->_out.write(this->_buffer.data(), std::streamsize(this->_buffer.size()));
+            this->_buffer.clear();
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>  // for std::push_heap, std::pop_heap, std::min, std::max
+#include <atomic>     // for std::atomic
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint8_t, std::uint32_t, std::uint64_t
+#include <functional>  // for std::greater
+#include <gsl/span>
+#include <type_traits>
+#include <utility>  // for std::pair
+#include <vector>
+
+#include "instrument.hpp"
+#include "parallel.hpp"
+#include "recti.hpp"
+#include "rtree.hpp"
+
+namespace recti {
+
+    /**
+     * @brief The result of routing one net: coalesced horizontal and vertical segments.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> struct RouteResult {
+        std::vector<HSegment<T>> hsegments;
+        std::vector<VSegment<T>> vsegments;
+        bool routed{false};  // all pins connected
+
+        /**
+         * @brief The total length of the segments.
+         *
+         * @return T
+         */
+        auto wirelength() const -> T {
+            auto total = T(0);
+            for (const auto &seg : this->hsegments) {
+                total += seg.xcoord().length();
+            }
+            for (const auto &seg : this->vsegments) {
+                total += seg.ycoord().length();
+            }
+            return total;
+        }
+
+        auto clear() noexcept -> void {
+            this->hsegments.clear();
+            this->vsegments.clear();
+            this->routed = false;
+        }
+    };
+
+    /**
+     * @brief Gridded A* maze router around rectangular obstacles
+     *
+     * The routing region is covered by a uniform grid of tracks with spacing `pitch`; a wire
+     * runs along the tracks between neighbouring crossings (nodes). The nodes covered by
+     * an obstacle (boundary included) are found once, row by row, with window queries on a
+     * `StaticRTree` over the obstacles, and kept in a bitmap for O(1) lookups. Pins are
+     * snapped to the nearest node; the pin nodes are usable even when covered.
+     *
+     * A net is routed by connecting one pin after the other (the nearest first) to the tree
+     * built so far: each connection is an A* search from the pin to any tree node, ordered
+     * by the path length plus the Manhattan `min_dist` from the node to the bounding box of
+     * the tree (an admissible estimate), so the paths are shortest. The paths are emitted as
+     * maximal `HSegment`/`VSegment` runs.
+     *
+     * All search state lives in a `Scratch` object, sized once for the grid and reset
+     * lazily by an epoch counter, so a query allocates nothing. `route_nets()` routes
+     * independent nets concurrently with one scratch per worker.
+     *
+     * @tparam T The (integral) coordinate type.
+     */
+    template <typename T> class MazeRouter {
+        static_assert(std::is_integral_v<T>, "the router works on integer coordinates");
+
+        static constexpr std::uint8_t _step_none = 4;
+
+      public:
+        /**
+         * @brief Search buffers of one thread.
+         */
+        class Scratch {
+            friend class MazeRouter;
+
+            std::vector<std::uint32_t> _cost;   // path length, valid if `_seen == _epoch`
+            std::vector<std::uint32_t> _seen;
+            std::vector<std::uint32_t> _tree;   // on the net tree if `_tree == _net_epoch`
+            std::vector<std::uint8_t> _step;    // the move that reached the node
+            std::vector<std::pair<std::uint64_t, std::uint32_t>> _heap;
+            std::vector<std::size_t> _pin_nodes;
+            std::vector<bool> _connected;
+            std::uint32_t _epoch{0};
+            std::uint32_t _net_epoch{0};
+
+            explicit Scratch(std::size_t num_nodes)
+                : _cost(num_nodes), _seen(num_nodes, 0), _tree(num_nodes, 0),
+                  _step(num_nodes, _step_none) {}
+
+          public:
+            Scratch() = default;
+        };
+
+      private:
+        Point<T> _origin;
+        T _pitch;
+        std::size_t _num_x;
+        std::size_t _num_y;
+        std::vector<std::uint64_t> _blocked;  // bit `node % 64` of word `node / 64`
+
+      public:
+        /**
+         * @brief Set up the grid over `region` and mark the nodes covered by `obstacles`.
+         *
+         * @param[in] region The routing region; its lower-left corner is a node.
+         * @param[in] pitch The track spacing.
+         * @param[in] obstacles The obstacles.
+         */
+        MazeRouter(const Rectangle<T> &region, T pitch, gsl::span<const Rectangle<T>> obstacles)
+            : _origin{region.ll()},
+              _pitch{pitch},
+              _num_x{std::size_t(region.xcoord().length() / pitch) + 1},
+              _num_y{std::size_t(region.ycoord().length() / pitch) + 1},
+              _blocked((_num_x * _num_y + 63) / 64, 0) {
+            assert(pitch > T(0));
+            assert(this->_num_x * this->_num_y < (std::size_t{1} << 32U));
+            const auto tree = StaticRTree<T>(obstacles);
+            const auto xrange = Interval<T>{this->_origin.xcoord(), this->_x(this->_num_x - 1)};
+            for (auto iy = std::size_t{0}; iy != this->_num_y; ++iy) {
+                const auto ycoord = this->_y(iy);
+                const auto row = Rectangle<T>{xrange, Interval<T>{ycoord, ycoord}};
+                auto mark = [&](std::size_t idx) {
+                    const auto &obstacle = obstacles[idx].xcoord();
+                    const auto ix0 = this->_ceil_index(obstacle.lb(), this->_origin.xcoord());
+                    const auto ix1 = this->_floor_index(obstacle.ub(), this->_origin.xcoord(),
+                                                        this->_num_x);
+                    for (auto ix = ix0; ix <= ix1 && ix < this->_num_x; ++ix) {
+                        const auto node = iy * this->_num_x + ix;
+                        this->_blocked[node / 64] |= std::uint64_t{1} << (node % 64);
+                    }
+                };
+                tree.visit_overlapping(row, mark);
+            }
+        }
+
+        auto num_x() const noexcept -> std::size_t { return this->_num_x; }
+        auto num_y() const noexcept -> std::size_t { return this->_num_y; }
+
+        /**
+         * @brief Whether the node nearest to `pt` is covered by an obstacle.
+         *
+         * @param[in] pt The point (inside the region).
+         * @return bool
+         */
+        auto is_blocked(const Point<T> &pt) const -> bool {
+            return this->_is_blocked(this->_snap(pt));
+        }
+
+        /**
+         * @brief Search buffers for this grid, to be reused across queries.
+         *
+         * @return Scratch
+         */
+        auto make_scratch() const -> Scratch { return Scratch(this->_num_x * this->_num_y); }
+
+        /**
+         * @brief Route a net (its pins are snapped to the nearest nodes).
+         *
+         * @param[in] pins The pins, inside the region.
+         * @param[in,out] scratch The search buffers (from `make_scratch()`).
+         * @param[out] result The segments; `routed` tells whether all pins are connected.
+         */
+        auto route(gsl::span<const Point<T>> pins, Scratch &scratch, RouteResult<T> &result) const
+            -> void {
+            RECTI_TIME_SCOPE(maze_route);
+            result.clear();
+            if (pins.empty()) {
+                result.routed = true;
+                return;
+            }
+            this->_next_epoch(scratch._net_epoch, scratch._tree);
+            scratch._pin_nodes.clear();
+            for (const auto &pin : pins) {
+                scratch._pin_nodes.push_back(this->_snap(pin));
+            }
+            scratch._connected.assign(pins.size(), false);
+            scratch._connected[0] = true;
+            const auto first = scratch._pin_nodes[0];
+            scratch._tree[first] = scratch._net_epoch;
+            auto tree_box = Rectangle<int>{this->_point(first).hull_with(this->_point(first))};
+            result.routed = true;
+            for (auto count = std::size_t{1}; count != pins.size(); ++count) {
+                // the unconnected pin nearest to the tree
+                auto best = pins.size();
+                auto best_dist = ~std::uint32_t{0};
+                for (auto idx = std::size_t{0}; idx != pins.size(); ++idx) {
+                    if (scratch._connected[idx]) {
+                        continue;
+                    }
+                    const auto dist = std::uint32_t(
+                        min_dist(tree_box, this->_point(scratch._pin_nodes[idx])));
+                    if (dist < best_dist) {
+                        best = idx;
+                        best_dist = dist;
+                    }
+                }
+                scratch._connected[best] = true;
+                const auto source = scratch._pin_nodes[best];
+                if (scratch._tree[source] == scratch._net_epoch) {
+                    continue;
+                }
+                const auto reached = this->_search(source, tree_box, scratch);
+                if (reached == ~std::size_t{0}) {
+                    result.routed = false;
+                    continue;
+                }
+                this->_emit_path(reached, source, scratch, result, tree_box);
+            }
+        }
+
+        /**
+         * @brief Route a two-pin connection.
+         *
+         * @return true if the pins are connected.
+         */
+        auto route(const Point<T> &source, const Point<T> &target, Scratch &scratch,
+                   RouteResult<T> &result) const -> bool {
+            const Point<T> pins[] = {source, target};
+            this->route(pins, scratch, result);
+            return result.routed;
+        }
+
+        /**
+         * @brief Route independent nets concurrently.
+         *
+         * Net `i` has the pins `pins[offsets[i] .. offsets[i + 1])` (the `PolygonSet` layout).
+         *
+         * @param[in] pins The pins of all nets.
+         * @param[in] offsets The offset table (`num_nets + 1` entries, from 0).
+         * @param[out] results One result per net (resized).
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        auto route_nets(gsl::span<const Point<T>> pins, gsl::span<const std::size_t> offsets,
+                        std::vector<RouteResult<T>> &results, unsigned num_threads = 1) const
+            -> void {
+            const auto num_nets = offsets.size() - 1;
+            results.resize(num_nets);
+            if (num_threads == 0) {
+                num_threads = hardware_threads();
+            }
+            const auto num_workers = std::max<std::size_t>(
+                1, std::min<std::size_t>(num_threads, num_nets / 8));
+            auto next = std::atomic<std::size_t>{0};
+            auto work = [&](std::size_t) {
+                auto scratch = this->make_scratch();  // one per worker, reused for its nets
+                for (auto net = next.fetch_add(1); net < num_nets; net = next.fetch_add(1)) {
+                    const auto first = offsets[net];
+                    this->route(pins.subspan(first, offsets[net + 1] - first), scratch,
+                                results[net]);
+                }
+            };
+            parallel_for(std::size_t{0}, num_workers, work, unsigned(num_workers));
+        }
+
+      private:
+        auto _x(std::size_t ix) const -> T {
+            return T(this->_origin.xcoord() + T(ix) * this->_pitch);
+        }
+
+        auto _y(std::size_t iy) const -> T {
+            return T(this->_origin.ycoord() + T(iy) * this->_pitch);
+        }
+
+        // grid coordinates of a node
+        auto _point(std::size_t node) const -> Point<int> {
+            return Point<int>{int(node % this->_num_x), int(node / this->_num_x)};
+        }
+
+        auto _is_blocked(std::size_t node) const -> bool {
+            return ((this->_blocked[node / 64] >> (node % 64)) & 1U) != 0;
+        }
+
+        // the first index whose track is at or after `coord`
+        auto _ceil_index(T coord, T origin) const -> std::size_t {
+            if (coord <= origin) {
+                return 0;
+            }
+            return std::size_t((coord - origin + this->_pitch - 1) / this->_pitch);
+        }
+
+        // the last index whose track is at or before `coord`, or `num` if there is none
+        auto _floor_index(T coord, T origin, std::size_t num) const -> std::size_t {
+            if (coord < origin) {
+                return num;
+            }
+            return std::min(std::size_t((coord - origin) / this->_pitch), num - 1);
+        }
+
+        auto _snap(const Point<T> &pt) const -> std::size_t {
+            auto snap = [this](T coord, T origin, std::size_t num) {
+                const auto offset = coord < origin ? T(0) : T(coord - origin);
+                return std::min(std::size_t((offset + this->_pitch / 2) / this->_pitch), num - 1);
+            };
+            return snap(pt.ycoord(), this->_origin.ycoord(), this->_num_y) * this->_num_x
+                   + snap(pt.xcoord(), this->_origin.xcoord(), this->_num_x);
+        }
+
+        static auto _next_epoch(std::uint32_t &epoch, std::vector<std::uint32_t> &stamps)
+            -> void {
+            if (++epoch == 0) {  // wrapped around: forget the old stamps
+                std::fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+            }
+        }
+
+        // A* from `source` to the nearest tree node; returns that node, or ~0 if unreachable
+        auto _search(std::size_t source, const Rectangle<int> &tree_box, Scratch &scratch) const
+            -> std::size_t {
+            _next_epoch(scratch._epoch, scratch._seen);
+            auto &heap = scratch._heap;
+            heap.clear();
+            auto push = [&](std::size_t node, std::uint32_t cost) {
+                const auto estimate = cost + std::uint32_t(min_dist(tree_box, this->_point(node)));
+                // equal estimates: the longer path first, it is closer to the tree
+                const auto key = (std::uint64_t(estimate) << 32U) | (~cost & 0xFFFFFFFFU);
+                heap.emplace_back(key, std::uint32_t(node));
+                std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+            };
+            scratch._seen[source] = scratch._epoch;
+            scratch._cost[source] = 0;
+            scratch._step[source] = _step_none;
+            push(source, 0);
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+                const auto [key, node32] = heap.back();
+                heap.pop_back();
+                const auto node = std::size_t(node32);
+                const auto cost = ~std::uint32_t(key & 0xFFFFFFFFU);
+                if (cost != scratch._cost[node]) {  // a stale entry
+                    continue;
+                }
+                if (scratch._tree[node] == scratch._net_epoch) {
+                    return node;
+                }
+                const auto ix = node % this->_num_x;
+                const auto iy = node / this->_num_x;
+                const bool can_move[4] = {ix + 1 < this->_num_x, ix > 0, iy + 1 < this->_num_y,
+                                          iy > 0};
+                const std::size_t next_node[4] = {node + 1, node - 1, node + this->_num_x,
+                                                  node - this->_num_x};
+                for (auto step = std::uint8_t{0}; step != 4; ++step) {
+                    if (!can_move[step]) {
+                        continue;
+                    }
+                    const auto next = next_node[step];
+                    const auto is_target = scratch._tree[next] == scratch._net_epoch;
+                    if (this->_is_blocked(next) && !is_target && !this->_is_pin(next, scratch)) {
+                        continue;
+                    }
+                    if (scratch._seen[next] == scratch._epoch
+                        && scratch._cost[next] <= cost + 1) {
+                        continue;
+                    }
+                    scratch._seen[next] = scratch._epoch;
+                    scratch._cost[next] = cost + 1;
+                    scratch._step[next] = step;
+                    push(next, cost + 1);
+                }
+            }
+            return ~std::size_t{0};
+        }
+
+        auto _is_pin(std::size_t node, const Scratch &scratch) const -> bool {
+            return std::find(scratch._pin_nodes.begin(), scratch._pin_nodes.end(), node)
+                   != scratch._pin_nodes.end();
+        }
+
+        // walk back from the tree node to the pin, adding maximal runs as segments
+        auto _emit_path(std::size_t reached, std::size_t source, Scratch &scratch,
+                        RouteResult<T> &result, Rectangle<int> &tree_box) const -> void {
+            auto node = reached;
+            auto run_start = reached;
+            while (node != source) {
+                const auto step = scratch._step[node];
+                const auto prev = step == 0   ? node - 1
+                                  : step == 1 ? node + 1
+                                  : step == 2 ? node - this->_num_x
+                                              : node + this->_num_x;
+                if (prev == source || scratch._step[prev] != step) {
+                    this->_add_segment(run_start, prev, result);
+                    run_start = prev;
+                }
+                node = prev;
+                scratch._tree[node] = scratch._net_epoch;
+                tree_box = tree_box.hull_with(this->_point(node));
+            }
+        }
+
+        auto _add_segment(std::size_t from, std::size_t to, RouteResult<T> &result) const
+            -> void {
+            const auto ix0 = from % this->_num_x;
+            const auto iy0 = from / this->_num_x;
+            const auto ix1 = to % this->_num_x;
+            const auto iy1 = to / this->_num_x;
+            if (iy0 == iy1) {
+                result.hsegments.emplace_back(
+                    Interval<T>{this->_x(std::min(ix0, ix1)), this->_x(std::max(ix0, ix1))},
+                    this->_y(iy0));
+            } else {
+                result.vsegments.emplace_back(
+                    this->_x(ix0),
+                    Interval<T>{this->_y(std::min(iy0, iy1)), this->_y(std::max(iy0, iy1))});
+            }
+        }
+    };
+
+}  // namespace recti
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <utility>  // import std::move
 
+#include "instrument.hpp"  // for RECTI_COUNT
 #include "interval.hpp"
 #include "point.hpp"
 
@@ -36,7 +37,18 @@ namespace recti {
      * @tparam T2 int or Interval
      */
     template <typename T1 = int, typename T2 = T1> class MergeObj : private Point<T1, T2> {
+        template <typename U1, typename U2> friend class MergeObj;
+
       public:
+        /**
+         * @brief The coordinates in the 45-degree rotated space
+         *
+         * `xcoord()` is the `x + y` coordinate and `ycoord()` the `x - y` coordinate of the
+         * merging segment.
+         */
+        using Point<T1, T2>::xcoord;
+        using Point<T1, T2>::ycoord;
+
         /**
          * @brief Construct a new MergeObj object
          *
@@ -279,6 +291,7 @@ namespace recti {
          */
         template <typename U1, typename U2>  //
         constexpr auto merge_with(const MergeObj<U1, U2> &other) const {
+            RECTI_COUNT(merge_with);
             auto alpha = this->min_dist_with(other);
             auto half = alpha / 2;
             auto trr1 = enlarge(*this, half);
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::min, std::max
+#include <cstddef>    // for std::size_t
+#include <gsl/span>
+#include <numeric>  // for std::iota
+#include <utility>  // for std::pair
+#include <vector>
+
+#include "instrument.hpp"
+#include "interval_tree.hpp"
+#include "parallel.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    namespace detail {
+        /**
+         * @brief Plane sweep in x over a subset of the rectangles.
+         *
+         * `items` must be sorted by `xcoord().lb()`. A pair is reported when its
+         * later-starting member is inserted, provided that member starts at or after
+         * `x_from`; this is how the strips of the parallel variant avoid reporting a pair
+         * twice.
+         */
+        template <typename T, typename Fn>
+        auto sweep_overlaps(gsl::span<const Rectangle<T>> rects,
+                            gsl::span<const std::size_t> items, const T *x_from, Fn &fn)
+            -> void {
+            auto by_ub = std::vector<std::size_t>(items.begin(), items.end());
+            std::sort(by_ub.begin(), by_ub.end(), [&rects](std::size_t lhs, std::size_t rhs) {
+                return rects[lhs].xcoord().ub() < rects[rhs].xcoord().ub();
+            });
+            auto active = IntervalTree<T>{};
+            active.reserve(items.size());
+            auto next_out = by_ub.begin();
+            for (const auto idx : items) {
+                const auto &rect = rects[idx];
+                const auto &x_lb = rect.xcoord().lb();
+                // bounds are closed: a rectangle ending exactly at `x_lb` is still active
+                while (next_out != by_ub.end() && rects[*next_out].xcoord().ub() < x_lb) {
+                    active.erase(rects[*next_out].ycoord(), *next_out);
+                    ++next_out;
+                }
+                if (x_from == nullptr || !(x_lb < *x_from)) {
+                    active.overlapping(rect.ycoord(), [&](const Interval<T> &, std::size_t other) {
+                        fn(std::min(idx, other), std::max(idx, other));
+                    });
+                }
+                active.insert(rect.ycoord(), idx);
+            }
+        }
+
+        template <typename T>
+        auto sorted_by_lb(gsl::span<const Rectangle<T>> rects) -> std::vector<std::size_t> {
+            auto order = std::vector<std::size_t>(rects.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::sort(order.begin(), order.end(), [&rects](std::size_t lhs, std::size_t rhs) {
+                return rects[lhs].xcoord().lb() < rects[rhs].xcoord().lb();
+            });
+            return order;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Report every pair of overlapping rectangles (plane sweep).
+     *
+     * Sweeps a vertical line across the rectangles in increasing x. The rectangles cut by the
+     * line are kept in an `IntervalTree` keyed on their y-intervals, so each rectangle is
+     * tested only against the active ones whose y-interval overlaps its own. The cost is
+     * O((n + k) log n) for `k` reported pairs, instead of the O(n^2) of a double loop over
+     * `overlap()`. As in `overlap()`, the bounds are closed, so touching rectangles overlap.
+     *
+     * The callback is invoked as `fn(i, j)` with `i < j`, once for each overlapping pair.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Fn The callback type.
+     * @param[in] rects The rectangles.
+     * @param[in] fn The callback.
+     */
+    template <typename T, typename Fn>
+    auto sweep_overlapping_pairs(gsl::span<const Rectangle<T>> rects, Fn &&fn) -> void {
+        RECTI_TIME_SCOPE(overlap_sweep);
+        const auto order = detail::sorted_by_lb(rects);
+        detail::sweep_overlaps<T>(rects, order, nullptr, fn);
+    }
+
+    /**
+     * @brief Report the intersection of every pair of overlapping rectangles (plane sweep).
+     *
+     * Same as `sweep_overlapping_pairs`, but the callback is invoked as
+     * `fn(i, j, intersection)` where `intersection` is the `Rectangle<T>` shared by the pair.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Fn The callback type.
+     * @param[in] rects The rectangles.
+     * @param[in] fn The callback.
+     */
+    template <typename T, typename Fn>
+    auto sweep_overlapping_intersections(gsl::span<const Rectangle<T>> rects, Fn &&fn) -> void {
+        auto report = [&rects, &fn](std::size_t idx1, std::size_t idx2) {
+            fn(idx1, idx2, Rectangle<T>{rects[idx1].intersect_with(rects[idx2])});
+        };
+        sweep_overlapping_pairs(rects, report);
+    }
+
+    /**
+     * @brief Collect every pair of overlapping rectangles, in parallel over vertical strips.
+     *
+     * The x-range is split into strips holding about the same number of left edges, and each
+     * strip is swept independently on up to `num_threads` threads. A rectangle takes part in
+     * every strip its x-interval touches, but a pair is reported only by the strip containing
+     * the left edge of its intersection, so no pair is lost or duplicated at the strip
+     * boundaries.
+     *
+     * @tparam T The coordinate type.
+     * @param[in] rects The rectangles.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::vector<std::pair<std::size_t, std::size_t>> of pairs `(i, j)`, `i < j`,
+     * sorted.
+     */
+    template <typename T>
+    auto overlapping_pairs(gsl::span<const Rectangle<T>> rects, unsigned num_threads = 1)
+        -> std::vector<std::pair<std::size_t, std::size_t>> {
+        RECTI_TIME_SCOPE(overlap_sweep);
+        using Pair = std::pair<std::size_t, std::size_t>;
+        if (num_threads == 0) {
+            num_threads = hardware_threads();
+        }
+        const auto order = detail::sorted_by_lb(rects);
+        auto result = std::vector<Pair>{};
+        const auto num_strips = std::min<std::size_t>(4 * std::size_t(num_threads),
+                                                      rects.size() / 1024 + 1);
+        if (num_strips <= 1) {
+            auto collect = [&result](std::size_t idx1, std::size_t idx2) {
+                result.emplace_back(idx1, idx2);
+            };
+            detail::sweep_overlaps<T>(rects, order, nullptr, collect);
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        // strip `k` starts at `starts[k]`; the first strip is unbounded on the left
+        auto starts = std::vector<T>{};
+        for (auto strip = std::size_t{1}; strip != num_strips; ++strip) {
+            starts.push_back(rects[order[strip * rects.size() / num_strips]].xcoord().lb());
+        }
+        auto members = std::vector<std::vector<std::size_t>>(num_strips);
+        for (const auto idx : order) {  // keeps each strip sorted by lb
+            const auto &xcoord = rects[idx].xcoord();
+            const auto first = std::upper_bound(starts.begin(), starts.end(), xcoord.lb());
+            const auto last = std::upper_bound(first, starts.end(), xcoord.ub());
+            for (auto strip = std::size_t(first - starts.begin());
+                 strip <= std::size_t(last - starts.begin()); ++strip) {
+                members[strip].push_back(idx);
+            }
+        }
+
+        auto found = std::vector<std::vector<Pair>>(num_strips);
+        parallel_for(
+            std::size_t{0}, num_strips,
+            [&](std::size_t strip) {
+                auto collect = [&found, strip](std::size_t idx1, std::size_t idx2) {
+                    found[strip].emplace_back(idx1, idx2);
+                };
+                const auto *x_from = strip == 0 ? nullptr : &starts[strip - 1];
+                detail::sweep_overlaps<T>(rects, members[strip], x_from, collect);
+            },
+            num_threads);
+
+        auto total = std::size_t{0};
+        for (const auto &pairs : found) {
+            total += pairs.size();
+        }
+        result.reserve(total);
+        for (const auto &pairs : found) {
+            result.insert(result.end(), pairs.begin(), pairs.end());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+}  // namespace recti
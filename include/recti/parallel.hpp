@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>           // for std::min, std::max
+#include <atomic>              // for std::atomic
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for std::size_t
+#include <cstdint>             // for std::uint64_t
+#include <exception>           // for std::exception_ptr
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include <type_traits>         // for std::true_type, std::remove_cvref_t
+#include <utility>             // for std::exchange
+#include <vector>
+
+#ifdef RECTI_STD_EXECUTION
+#    include <execution>  // libstdc++ needs TBB for this header
+#endif
+
+namespace recti {
+
+    /**
+     * @brief The number of hardware threads (at least 1).
+     *
+     * @return unsigned
+     */
+    inline auto hardware_threads() noexcept -> unsigned {
+        const auto num = std::thread::hardware_concurrency();
+        return num == 0 ? 1U : num;
+    }
+
+    /**
+     * @brief Run `fn(i)` for every `i` in `[first, last)` on up to `num_threads` threads.
+     *
+     * The range is handed out in chunks of `grain` indices from a shared atomic counter, so
+     * threads that finish early keep taking work from the others (dynamic load balancing).
+     * With `num_threads <= 1`, or when the range fits in one chunk, everything runs on the
+     * calling thread. `num_threads == 0` means "use all hardware threads". The first
+     * exception thrown by `fn` is rethrown on the calling thread after all workers stop.
+     *
+     * @tparam Fn The callable type, invocable as `fn(std::size_t)`.
+     * @param[in] first The first index.
+     * @param[in] last One past the last index.
+     * @param[in] fn The callable.
+     * @param[in] num_threads The maximum number of threads (0 for all hardware threads).
+     * @param[in] grain The chunk size.
+     */
+    template <typename Fn>
+    inline auto parallel_for(std::size_t first, std::size_t last, Fn &&fn, unsigned num_threads = 0,
+                             std::size_t grain = 1) -> void {
+        if (first >= last) {
+            return;
+        }
+        if (num_threads == 0) {
+            num_threads = hardware_threads();
+        }
+        grain = std::max(grain, std::size_t{1});
+        const auto num_chunks = (last - first + grain - 1) / grain;
+        const auto num_workers = std::size_t(std::min<std::size_t>(num_threads, num_chunks));
+        if (num_workers <= 1) {
+            for (auto idx = first; idx != last; ++idx) {
+                fn(idx);
+            }
+            return;
+        }
+
+        auto next = std::atomic<std::size_t>{first};
+        auto error = std::exception_ptr{};
+        auto error_mutex = std::mutex{};
+        auto worker = [&]() {
+            try {
+                for (;;) {
+                    const auto start = next.fetch_add(grain, std::memory_order_relaxed);
+                    if (start >= last) {
+                        return;
+                    }
+                    const auto stop = std::min(start + grain, last);
+                    for (auto idx = start; idx != stop; ++idx) {
+                        fn(idx);
+                    }
+                }
+            } catch (...) {
+                next.store(last, std::memory_order_relaxed);  // let the others stop early
+                const auto lock = std::lock_guard<std::mutex>{error_mutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        };
+        auto threads = std::vector<std::thread>{};
+        threads.reserve(num_workers - 1);
+        for (auto i = std::size_t{1}; i != num_workers; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();  // the calling thread takes part as well
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief A fixed set of worker threads shared by the parallel loops
+     *
+     * `parallel_for` above starts its threads on every call, which is fine for a few large
+     * loops but too costly when a program runs many short batches. A `ThreadPool` starts its
+     * threads once; `run()` hands a loop to them and the calling thread, with the same
+     * chunked dynamic scheduling and exception handling as `parallel_for`. One loop runs at
+     * a time: concurrent callers wait for their turn, and a loop started from inside a
+     * worker (nested parallelism) runs serially on that worker instead of deadlocking.
+     *
+     * `ThreadPool::shared()` is a process-wide pool with one thread per hardware thread.
+     */
+    class ThreadPool {
+        std::vector<std::thread> _threads{};
+        std::mutex _mutex{};               // guards the fields of the current loop
+        std::mutex _submit_mutex{};        // one loop at a time
+        std::condition_variable _wake{};   // a new loop or `_stop`
+        std::condition_variable _idle{};   // `_busy` dropped to 0
+        std::uint64_t _generation{0};      // number of loops started
+        std::size_t _busy{0};              // workers inside the current loop
+        bool _stop{false};
+
+        // the current loop (type-erased, valid while its `run()` is active)
+        void (*_invoke)(void *, std::size_t){nullptr};
+        void *_context{nullptr};
+        std::atomic<std::size_t> _next{0};
+        std::size_t _last{0};
+        std::size_t _grain{1};
+        std::exception_ptr _error{};
+
+        static auto _inside() noexcept -> bool & {
+            thread_local auto inside = false;
+            return inside;
+        }
+
+      public:
+        /**
+         * @brief Start the workers.
+         *
+         * @param[in] num_threads The number of threads, the callers of `run()` included (0 for
+         * all hardware threads).
+         */
+        explicit ThreadPool(unsigned num_threads = 0) {
+            if (num_threads == 0) {
+                num_threads = hardware_threads();
+            }
+            this->_threads.reserve(num_threads - 1);
+            for (auto idx = 1U; idx < num_threads; ++idx) {
+                this->_threads.emplace_back([this]() { this->_work(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+        ~ThreadPool() {
+            {
+                const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+                this->_stop = true;
+            }
+            this->_wake.notify_all();
+            for (auto &thread : this->_threads) {
+                thread.join();
+            }
+        }
+
+        /**
+         * @brief The process-wide pool (started on first use).
+         *
+         * @return ThreadPool&
+         */
+        static auto shared() -> ThreadPool & {
+            static auto pool = ThreadPool{};
+            return pool;
+        }
+
+        /**
+         * @brief The number of threads, the caller of `run()` included.
+         *
+         * @return unsigned
+         */
+        auto num_threads() const noexcept -> unsigned {
+            return unsigned(this->_threads.size() + 1);
+        }
+
+        /**
+         * @brief Run `fn(i)` for every `i` in `[first, last)` on the pool.
+         *
+         * @tparam Fn The callable type, invocable as `fn(std::size_t)`.
+         * @param[in] first The first index.
+         * @param[in] last One past the last index.
+         * @param[in] fn The callable.
+         * @param[in] grain The chunk size.
+         */
+        template <typename Fn>
+        auto run(std::size_t first, std::size_t last, Fn &&fn, std::size_t grain = 1) -> void {
+            if (first >= last) {
+                return;
+            }
+            grain = std::max(grain, std::size_t{1});
+            if (this->_threads.empty() || last - first <= grain || _inside()) {
+                for (auto idx = first; idx != last; ++idx) {
+                    fn(idx);
+                }
+                return;
+            }
+            const auto turn = std::lock_guard<std::mutex>{this->_submit_mutex};
+            {
+                auto lock = std::unique_lock<std::mutex>{this->_mutex};
+                // a late worker of the previous loop may still be leaving it
+                this->_idle.wait(lock, [this]() { return this->_busy == 0; });
+                this->_invoke = [](void *context, std::size_t idx) {
+                    (*static_cast<std::remove_reference_t<Fn> *>(context))(idx);
+                };
+                this->_context = static_cast<void *>(&fn);
+                this->_next.store(first, std::memory_order_relaxed);
+                this->_last = last;
+                this->_grain = grain;
+                this->_error = nullptr;
+                ++this->_generation;
+            }
+            this->_wake.notify_all();
+            _inside() = true;
+            this->_run_chunks();
+            _inside() = false;
+            auto lock = std::unique_lock<std::mutex>{this->_mutex};
+            this->_idle.wait(lock, [this]() { return this->_busy == 0; });
+            if (this->_error) {
+                std::rethrow_exception(std::exchange(this->_error, nullptr));
+            }
+        }
+
+      private:
+        auto _run_chunks() -> void {
+            try {
+                for (;;) {
+                    const auto start
+                        = this->_next.fetch_add(this->_grain, std::memory_order_relaxed);
+                    if (start >= this->_last) {
+                        return;
+                    }
+                    const auto stop = std::min(start + this->_grain, this->_last);
+                    for (auto idx = start; idx != stop; ++idx) {
+                        this->_invoke(this->_context, idx);
+                    }
+                }
+            } catch (...) {
+                this->_next.store(this->_last, std::memory_order_relaxed);
+                const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+                if (!this->_error) {
+                    this->_error = std::current_exception();
+                }
+            }
+        }
+
+        auto _work() -> void {
+            _inside() = true;
+            auto seen = std::uint64_t{0};
+            auto lock = std::unique_lock<std::mutex>{this->_mutex};
+            for (;;) {
+                this->_wake.wait(lock, [&]() { return this->_stop || this->_generation != seen; });
+                if (this->_stop) {
+                    return;
+                }
+                seen = this->_generation;
+                ++this->_busy;
+                lock.unlock();
+                this->_run_chunks();
+                lock.lock();
+                if (--this->_busy == 0) {
+                    this->_idle.notify_all();
+                }
+            }
+        }
+    };
+
+    namespace execution {
+        /**
+         * @brief Execution policies for the batch overloads (`polygon_batch.hpp`)
+         *
+         * They mirror `std::execution::seq` and `std::execution::par`: `seq` runs on the
+         * calling thread, `par` on `ThreadPool::shared()`. The standard policies are accepted
+         * as well when `RECTI_STD_EXECUTION` is defined; it is opt-in because libstdc++
+         * requires linking TBB as soon as `<execution>` is included.
+         */
+        struct sequenced_policy {};
+        struct parallel_policy {};
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+
+        template <typename Policy> struct is_execution_policy : std::false_type {};
+        template <> struct is_execution_policy<sequenced_policy> : std::true_type {};
+        template <> struct is_execution_policy<parallel_policy> : std::true_type {};
+
+        template <typename Policy> struct is_parallel_policy : std::false_type {};
+        template <> struct is_parallel_policy<parallel_policy> : std::true_type {};
+
+#ifdef RECTI_STD_EXECUTION
+        template <> struct is_execution_policy<std::execution::sequenced_policy>
+            : std::true_type {};
+        template <> struct is_execution_policy<std::execution::unsequenced_policy>
+            : std::true_type {};
+        template <> struct is_execution_policy<std::execution::parallel_policy>
+            : std::true_type {};
+        template <> struct is_execution_policy<std::execution::parallel_unsequenced_policy>
+            : std::true_type {};
+        template <> struct is_parallel_policy<std::execution::parallel_policy>
+            : std::true_type {};
+        template <> struct is_parallel_policy<std::execution::parallel_unsequenced_policy>
+            : std::true_type {};
+#endif
+
+        template <typename Policy> inline constexpr bool is_execution_policy_v
+            = is_execution_policy<std::remove_cvref_t<Policy>>::value;
+
+        template <typename Policy> inline constexpr bool is_parallel_policy_v
+            = is_parallel_policy<std::remove_cvref_t<Policy>>::value;
+    }  // namespace execution
+
+    /**
+     * @brief Run `fn(i)` for every `i` in `[first, last)` under an execution policy.
+     *
+     * A parallel policy runs the loop on `ThreadPool::shared()`, any other one serially.
+     *
+     * @tparam Policy The execution policy type.
+     * @tparam Fn The callable type, invocable as `fn(std::size_t)`.
+     * @param[in] first The first index.
+     * @param[in] last One past the last index.
+     * @param[in] fn The callable.
+     * @param[in] grain The chunk size.
+     */
+    template <typename Policy, typename Fn>
+        requires execution::is_execution_policy_v<Policy>
+    inline auto parallel_for(Policy && /* policy */, std::size_t first, std::size_t last,
+                             Fn &&fn, std::size_t grain = 1) -> void {
+        if constexpr (execution::is_parallel_policy_v<Policy>) {
+            ThreadPool::shared().run(first, last, fn, grain);
+        } else {
+            for (auto idx = first; idx < last; ++idx) {
+                fn(idx);
+            }
+        }
+    }
+
+}  // namespace recti
@@ -291,8 +291,9 @@ namespace recti {
          */
         template <typename U1, typename U2>  //
         constexpr auto overlaps(const Point<U1, U2> &other) const -> bool {
+            // both tests are cheap and pure: `&` avoids a hard-to-predict branch between them
             return overlap(this->xcoord(), other.xcoord())
-                   && overlap(this->ycoord(), other.ycoord());
+                   & overlap(this->ycoord(), other.ycoord());
         }
 
         /**
@@ -336,7 +337,7 @@ namespace recti {
         template <typename U1, typename U2>  //
         constexpr auto contains(const Point<U1, U2> &other) const -> bool {
             return contain(this->xcoord(), other.xcoord())
-                   && contain(this->ycoord(), other.ycoord());
+                   & contain(this->ycoord(), other.ycoord());
         }
 
         /**
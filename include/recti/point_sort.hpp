@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::transform, std::min, std::max
+#include <bit>        // for std::bit_width
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t, std::uint64_t
+#include <iterator>   // for std::iterator_traits, std::distance
+#include <type_traits>
+#include <utility>  // for std::pair
+#include <vector>
+
+#if defined(RECTI_PARALLEL_SORT)
+#    include <execution>  // for std::execution::par_unseq
+#endif
+
+namespace recti {
+
+    namespace detail {
+        /**
+         * @brief Whether `K` is a scalar that `radix_sort_by_key` can order (an integer of at
+         * most 32 bits).
+         */
+        template <typename K>
+        concept RadixScalar = std::is_integral_v<K> && !std::is_same_v<K, bool>
+                              && sizeof(K) <= sizeof(std::uint32_t);
+
+        template <typename Key> struct is_radix_key : std::false_type {};
+
+        template <typename K1, typename K2> struct is_radix_key<std::pair<K1, K2>>
+            : std::bool_constant<RadixScalar<K1> && RadixScalar<K2>> {};
+
+        /**
+         * @brief Whether the keys `Key` (lexicographic pairs of small integers) can be radix
+         * sorted as one 64-bit word.
+         */
+        template <typename Key> inline constexpr bool is_radix_key_v = is_radix_key<Key>::value;
+
+        /**
+         * @brief Map an integer of at most 32 bits to an unsigned word with the same order.
+         */
+        template <RadixScalar K> constexpr auto radix_word(K val) noexcept -> std::uint32_t {
+            if constexpr (std::is_signed_v<K>) {
+                return std::uint32_t(std::int32_t(val)) ^ 0x80000000U;
+            } else {
+                return std::uint32_t(val);
+            }
+        }
+
+        /**
+         * @brief LSD radix sort of `[first, last)` by the key pairs of the elements.
+         *
+         * Both halves of each key are first mapped to unsigned words and offset by their
+         * minimum, then packed into one 64-bit word using only as many bits as the ranges need,
+         * which keeps the order. The packed keys are sorted 11 bits per pass, so bounded
+         * coordinates (e.g. two 17-bit ranges) take four O(n) scatter passes. The elements
+         * travel with their keys between two buffers and the order of equal keys is kept.
+         *
+         * @tparam RandomIt The iterator type.
+         * @tparam KeyFn The key function type, returning a `std::pair` of small integers.
+         * @param[in,out] first The beginning of the range.
+         * @param[in,out] last The end of the range.
+         * @param[in] key The key function.
+         */
+        template <typename RandomIt, typename KeyFn>
+        auto radix_sort_by_key(RandomIt first, RandomIt last, const KeyFn &key) -> void {
+            using Value = typename std::iterator_traits<RandomIt>::value_type;
+            struct Item {
+                std::uint64_t key;
+                Value value;
+            };
+            constexpr auto digit_bits = 11U;
+            constexpr auto num_buckets = std::size_t{1} << digit_bits;
+
+            auto items = std::vector<Item>{};
+            items.reserve(std::size_t(last - first));
+            auto hi_min = ~std::uint32_t{0};
+            auto hi_max = std::uint32_t{0};
+            auto lo_min = ~std::uint32_t{0};
+            auto lo_max = std::uint32_t{0};
+            for (auto iter = first; iter != last; ++iter) {
+                const auto pair = key(*iter);
+                const auto hi_word = radix_word(pair.first);
+                const auto lo_word = radix_word(pair.second);
+                hi_min = std::min(hi_min, hi_word);
+                hi_max = std::max(hi_max, hi_word);
+                lo_min = std::min(lo_min, lo_word);
+                lo_max = std::max(lo_max, lo_word);
+                items.push_back(Item{(std::uint64_t(hi_word) << 32U) | lo_word, *iter});
+            }
+            const auto lo_bits = unsigned(std::bit_width(lo_max - lo_min));
+            const auto total_bits = lo_bits + unsigned(std::bit_width(hi_max - hi_min));
+            for (auto &item : items) {
+                const auto hi_word = std::uint64_t(item.key >> 32U) - hi_min;
+                const auto lo_word = std::uint64_t(item.key & 0xFFFFFFFFU) - lo_min;
+                item.key = (hi_word << lo_bits) | lo_word;
+            }
+
+            auto buffer = items;  // `Value` need not be default constructible
+            auto count = std::vector<std::size_t>(num_buckets);
+            for (auto shift = 0U; shift < total_bits; shift += digit_bits) {
+                std::fill(count.begin(), count.end(), std::size_t{0});
+                for (const auto &item : items) {
+                    ++count[(item.key >> shift) & (num_buckets - 1)];
+                }
+                auto offset = std::size_t{0};
+                for (auto &num : count) {
+                    const auto start = offset;
+                    offset += num;
+                    num = start;
+                }
+                for (const auto &item : items) {
+                    buffer[count[(item.key >> shift) & (num_buckets - 1)]++] = item;
+                }
+                items.swap(buffer);
+            }
+            std::transform(items.begin(), items.end(), first,
+                           [](const Item &item) { return item.value; });
+        }
+
+        /**
+         * @brief Sort `[first, last)` in increasing order of `key(elem)`.
+         *
+         * When the keys are pairs of integers of at most 32 bits, as for `Point<int>`, large
+         * ranges are radix sorted in O(n). Otherwise `std::sort` is used; when
+         * `RECTI_PARALLEL_SORT` is defined, large ranges are then sorted with
+         * `std::execution::par_unseq` (with libstdc++ this needs TBB).
+         *
+         * @tparam RandomIt The iterator type.
+         * @tparam KeyFn The key function type.
+         * @param[in,out] first The beginning of the range.
+         * @param[in,out] last The end of the range.
+         * @param[in] key The key function.
+         */
+        template <typename RandomIt, typename KeyFn>
+        auto sort_by_key(RandomIt first, RandomIt last, const KeyFn &key) -> void {
+            using Value = typename std::iterator_traits<RandomIt>::value_type;
+            using Key = std::decay_t<std::invoke_result_t<const KeyFn &, const Value &>>;
+            auto less = [&key](const Value &lhs, const Value &rhs) -> bool {
+                return key(lhs) < key(rhs);
+            };
+            const auto num = std::size_t(std::distance(first, last));
+            if constexpr (is_radix_key_v<Key>) {
+                if (num >= 256) {  // below that, the histograms cost more than they save
+                    radix_sort_by_key(first, last, key);
+                    return;
+                }
+            }
+#if defined(RECTI_PARALLEL_SORT)
+            if (num >= (std::size_t{1} << 16U)) {
+                std::sort(std::execution::par_unseq, first, last, less);
+                return;
+            }
+#endif
+            std::sort(first, last, less);
+        }
+    }  // namespace detail
+
+}  // namespace recti
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>  // for std::size_t
 #include <gsl/span>
-#include <utility>  // for std::pair
+#include <memory>           // for std::allocator
+#include <memory_resource>  // for std::pmr::polymorphic_allocator
+#include <utility>          // for std::pair
 #include <vector>
 
+#include "point_sort.hpp"
 #include "recti.hpp"
 
 namespace recti {
@@ -16,12 +20,25 @@ namespace recti {
      * stores the origin point and a vector of edges that define the polygon. The
      * template parameter `T` specifies the type of the coordinates of the points.
      *
+     * The edge vectors are stored with the allocator `Alloc`, so that many short-lived
+     * polygons can share an arena, e.g. `pmr::Polygon<T>` over a
+     * `std::pmr::monotonic_buffer_resource`.
+     *
      * @tparam T
+     * @tparam Alloc The allocator type for the edge vectors.
      */
-    template <typename T> class Polygon {
+    template <typename T, typename Alloc = std::allocator<Vector2<T>>> class Polygon {
+      public:
+        using allocator_type = Alloc;
+
       private:
         Point<T> _origin{};
-        std::vector<Vector2<T>> _vecs{};
+        std::vector<Vector2<T>, Alloc> _vecs;
+        // cached at construction; the corners are relative to `_origin`, so a translation
+        // moves the bounding box and keeps the area without touching them
+        Vector2<T> _lb_vec{T{}, T{}};
+        Vector2<T> _ub_vec{T{}, T{}};
+        accumulator_t<T> _area{};
 
       public:
         /**
@@ -33,11 +50,29 @@ namespace recti {
          * the polygon as vectors relative to the origin.
          *
          * @param[in] pointset A span of points representing the vertices of the polygon.
+         * @param[in] alloc The allocator for the edge vectors.
          */
-        explicit constexpr Polygon(gsl::span<const Point<T>> pointset) : _origin{pointset.front()} {
+        explicit constexpr Polygon(gsl::span<const Point<T>> pointset,
+                                   const Alloc &alloc = Alloc())
+            : _origin{pointset.front()}, _vecs(alloc) {
+            this->_vecs.reserve(pointset.size() - 1);
             auto itr = pointset.begin();
             for (++itr; itr != pointset.end(); ++itr) {
                 this->_vecs.push_back(*itr - this->_origin);
+                this->_extend_bbox(this->_vecs.back());
+            }
+            if (this->_vecs.size() >= 2) {
+                auto itr2 = this->_vecs.begin();
+                auto itr0 = itr2++;
+                auto itr1 = itr2++;
+                auto end = this->_vecs.end();
+                auto last = std::prev(end);
+                auto res = widen(itr0->x()) * widen(itr1->y())
+                           - widen(last->x()) * widen(std::prev(last)->y());
+                for (; itr2 != end; ++itr2, ++itr1, ++itr0) {
+                    res = std::move(res) + widen(itr1->x()) * widen(itr2->y() - itr0->y());
+                }
+                this->_area = std::move(res);
             }
         }
 
@@ -45,6 +80,8 @@ namespace recti {
          * @brief Adds a vector to the origin of the polygon, effectively translating the
          * polygon.
          *
+         * The cached bounding box moves with it and the cached area is kept.
+         *
          * @param[in] rhs The vector to add to the origin.
          * @return A reference to the modified polygon.
          */
@@ -53,43 +90,88 @@ namespace recti {
             return *this;
         }
 
+        /**
+         * @brief The allocator used for the edge vectors.
+         *
+         * @return allocator_type
+         */
+        constexpr auto get_allocator() const -> allocator_type {
+            return this->_vecs.get_allocator();
+        }
+
         /**
          * @brief Calculates the signed area of the polygon multiplied by 2.
          *
-         * This function calculates the signed area of the polygon by summing the
-         * cross products of adjacent edges. The result is multiplied by 2 to
-         * avoid the need for floating-point arithmetic.
+         * The signed area is the sum of the cross products of adjacent edges; it is
+         * multiplied by 2 to avoid the need for floating-point arithmetic. It is
+         * computed once, at construction, in the accumulator type of `T`.
          *
          * @return The signed area of the polygon multiplied by 2.
          */
-        constexpr auto signed_area_x2() const -> T {
-            auto itr2 = this->_vecs.begin();
-            auto itr0 = itr2++;
-            auto itr1 = itr2++;
-            auto end = this->_vecs.end();
-            auto last = std::prev(end);
-            auto res = itr0->x() * itr1->y() - last->x() * std::prev(last)->y();
-            for (; itr2 != end; ++itr2, ++itr1, ++itr0) {
-                res = std::move(res) + itr1->x() * (itr2->y() - itr0->y());
-            }
-            return res;
-        }
+        constexpr auto signed_area_x2() const -> accumulator_t<T> { return this->_area; }
 
         /**
-         * @brief
+         * @brief The lower-left corner of the bounding box of the polygon.
          *
          * @return Point<T>
          */
-        auto lb() const -> Point<T>;
+        constexpr auto lb() const -> Point<T> { return this->_origin + this->_lb_vec; }
 
         /**
-         * @brief
+         * @brief The upper-right corner of the bounding box of the polygon.
          *
          * @return Point<T>
          */
-        auto ub() const -> Point<T>;
+        constexpr auto ub() const -> Point<T> { return this->_origin + this->_ub_vec; }
+
+        /**
+         * @brief The bounding box of the polygon.
+         *
+         * @return Rectangle<T>
+         */
+        constexpr auto bounding_box() const -> Rectangle<T> {
+            const auto lower = this->lb();
+            const auto upper = this->ub();
+            return Rectangle<T>{Interval<T>{lower.xcoord(), upper.xcoord()},
+                                Interval<T>{lower.ycoord(), upper.ycoord()}};
+        }
+
+        /**
+         * @brief The number of vertices of the polygon.
+         *
+         * @return std::size_t
+         */
+        constexpr auto num_vertices() const -> std::size_t { return this->_vecs.size() + 1; }
+
+        /**
+         * @brief Vertex `idx` of the polygon (vertex 0 is the origin).
+         *
+         * @param[in] idx The vertex index, less than `num_vertices()`.
+         * @return Point<T>
+         */
+        constexpr auto vertex(std::size_t idx) const -> Point<T> {
+            return idx == 0 ? this->_origin : this->_origin + this->_vecs[idx - 1];
+        }
+
+      private:
+        constexpr auto _extend_bbox(const Vector2<T> &vec) -> void {
+            this->_lb_vec = Vector2<T>{std::min(this->_lb_vec.x(), vec.x()),
+                                       std::min(this->_lb_vec.y(), vec.y())};
+            this->_ub_vec = Vector2<T>{std::max(this->_ub_vec.x(), vec.x()),
+                                       std::max(this->_ub_vec.y(), vec.y())};
+        }
     };
 
+    namespace pmr {
+        /**
+         * @brief Polygon whose edge vectors come from a `std::pmr::memory_resource`.
+         *
+         * @tparam T
+         */
+        template <typename T> using Polygon
+            = recti::Polygon<T, std::pmr::polymorphic_allocator<Vector2<T>>>;
+    }  // namespace pmr
+
     /**
      * @brief Writes the vertices of a polygon to an output stream in a format suitable for
      * rendering.
@@ -105,10 +187,10 @@ namespace recti {
      * @param poly The polygon to write to the output stream.
      * @return The output stream, for method chaining.
      */
-    template <class Stream, typename T> auto operator<<(Stream &out, const Polygon<T> &poly)
-        -> Stream & {
-        for (auto &&vtx : poly) {
-            out << "  \\draw " << vtx << ";\n";
+    template <class Stream, typename T, typename Alloc>
+    auto operator<<(Stream &out, const Polygon<T, Alloc> &poly) -> Stream & {
+        for (auto idx = std::size_t{0}; idx != poly.num_vertices(); ++idx) {
+            out << "  \\draw " << poly.vertex(idx) << ";\n";
         }
         return out;
     }
@@ -145,12 +227,39 @@ namespace recti {
         std::reverse(middle, last);
     }
 
+    namespace detail {
+        /**
+         * @brief Same as `create_mono_polygon`, with the order given by a key function.
+         *
+         * The two chains are sorted with `sort_by_key`, so pairs of integer keys of at most
+         * 32 bits (e.g. for `Point<int>`) are radix sorted in linear time.
+         */
+        template <typename FwIter, typename KeyFn>
+        inline void create_mono_polygon_by_key(FwIter &&first, FwIter &&last, KeyFn &&key) {
+            assert(first != last);
+
+            auto result = std::minmax_element(
+                first, last,
+                [&key](const auto &lhs, const auto &rhs) -> bool { return key(lhs) < key(rhs); });
+            auto min_pt = *result.first;
+            auto max_pt = *result.second;
+            auto displace = max_pt - min_pt;
+            auto middle
+                = std::partition(first, last, [&displace, &min_pt](const auto &elem) -> bool {
+                      return displace.cross(elem - min_pt) <= 0;
+                  });
+            sort_by_key(first, middle, key);
+            sort_by_key(middle, last, key);
+            std::reverse(middle, last);
+        }
+    }  // namespace detail
+
     /**
      * @brief Create a xmono Polygon object
      *
      * This function creates a monotone polygon from a range of points represented by the iterators
-     * `first` and `last`. It uses a comparison function that compares the points based on their x
-     * and y coordinates.
+     * `first` and `last`. It orders the points by their x and then y coordinates; integer
+     * coordinates of at most 32 bits are radix sorted.
      *
      * @tparam FwIter The type of the forward iterator over the points.
      * @param[in] first The beginning of the range of points.
@@ -158,18 +267,16 @@ namespace recti {
      */
     template <typename FwIter> inline auto create_xmono_polygon(FwIter &&first, FwIter &&last)
         -> void {
-        return create_mono_polygon(first, last, [](const auto &lhs, const auto &rhs) -> bool {
-            return std::make_pair(lhs.xcoord(), lhs.ycoord())
-                   < std::make_pair(rhs.xcoord(), rhs.ycoord());
-        });
+        return detail::create_mono_polygon_by_key(
+            first, last, [](const auto &pt) { return std::make_pair(pt.xcoord(), pt.ycoord()); });
     }
 
     /**
      * @brief Create a ymono Polygon object
      *
      * This function creates a monotone polygon from a range of points represented by the iterators
-     * `first` and `last`. It uses a comparison function that compares the points based on their y
-     * and x coordinates.
+     * `first` and `last`. It orders the points by their y and then x coordinates; integer
+     * coordinates of at most 32 bits are radix sorted.
      *
      * @tparam FwIter The type of the forward iterator over the points.
      * @param[in] first The beginning of the range of points.
@@ -177,10 +284,8 @@ namespace recti {
      */
     template <typename FwIter> inline auto create_ymono_polygon(FwIter &&first, FwIter &&last)
         -> void {
-        return create_mono_polygon(first, last, [](const auto &lhs, const auto &rhs) -> bool {
-            return std::make_pair(lhs.ycoord(), lhs.xcoord())
-                   < std::make_pair(rhs.ycoord(), rhs.xcoord());
-        });
+        return detail::create_mono_polygon_by_key(
+            first, last, [](const auto &pt) { return std::make_pair(pt.ycoord(), pt.xcoord()); });
     }
 
     /**
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <gsl/span>
+#include <vector>
+
+#include "parallel.hpp"
+#include "polygon.hpp"
+#include "polygon_set.hpp"
+#include "rpolygon.hpp"
+
+namespace recti {
+
+    /**
+     * @name Batch overloads of the polygon utilities
+     *
+     * Each of these applies one of the single-shape functions of `polygon.hpp` and
+     * `rpolygon.hpp` to every polygon of a `PolygonSet`, under an execution policy:
+     * `execution::seq` runs on the calling thread and `execution::par` on
+     * `ThreadPool::shared()`, so many small batches do not pay for starting threads. The
+     * polygons are independent and each one is handled by a single thread; the results come
+     * back in the order of the set (predicates as `char`, since `std::vector<bool>` cannot be
+     * written concurrently).
+     */
+    ///@{
+
+    namespace detail {
+        inline constexpr std::size_t batch_grain = 64;  // polygons per chunk
+
+        template <typename Policy, typename T, typename Alloc, typename Fn>
+        auto for_each_polygon(Policy &&policy, PolygonSet<T, Alloc> &set, Fn &&fn) -> void {
+            auto apply = [&set, &fn](std::size_t idx) { fn(idx, set.mutable_polygon(idx)); };
+            parallel_for(policy, std::size_t{0}, set.size(), apply, batch_grain);
+        }
+
+        template <typename R, typename Policy, typename T, typename Alloc, typename Fn>
+        auto map_polygons(Policy &&policy, const PolygonSet<T, Alloc> &set, Fn &&fn)
+            -> std::vector<R> {
+            auto result = std::vector<R>(set.size());
+            auto apply = [&set, &fn, &result](std::size_t idx) { result[idx] = R(fn(set[idx])); };
+            parallel_for(policy, std::size_t{0}, set.size(), apply, batch_grain);
+            return result;
+        }
+
+        /// Same as `RPolygon<T>(pointset).signed_area()`, without building the polygon.
+        template <typename T>
+        auto rpolygon_signed_area(gsl::span<const Point<T>> pointset) -> accumulator_t<T> {
+            if (pointset.size() < 2) {
+                return accumulator_t<T>(0);
+            }
+            const auto &origin = pointset.front();
+            auto prev = pointset[1] - origin;
+            auto res = widen(prev.x()) * widen(prev.y());
+            for (auto idx = std::size_t{2}; idx < pointset.size(); ++idx) {
+                const auto vec = pointset[idx] - origin;
+                res += widen(vec.x()) * widen(vec.y() - prev.y());
+                prev = vec;
+            }
+            return res;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Reorder the vertices of every polygon into an x-monotone RPolygon.
+     *
+     * @return std::vector<char> The result of `create_xmono_rpolygon` for each polygon.
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto create_xmono_rpolygon(Policy &&policy, PolygonSet<T, Alloc> &set) -> std::vector<char> {
+        auto result = std::vector<char>(set.size());
+        detail::for_each_polygon(policy, set, [&result](std::size_t idx, auto pointset) {
+            result[idx] = char(create_xmono_rpolygon(pointset.begin(), pointset.end()));
+        });
+        return result;
+    }
+
+    /**
+     * @brief Reorder the vertices of every polygon into a y-monotone RPolygon.
+     *
+     * @return std::vector<char> The result of `create_ymono_rpolygon` for each polygon.
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto create_ymono_rpolygon(Policy &&policy, PolygonSet<T, Alloc> &set) -> std::vector<char> {
+        auto result = std::vector<char>(set.size());
+        detail::for_each_polygon(policy, set, [&result](std::size_t idx, auto pointset) {
+            result[idx] = char(create_ymono_rpolygon(pointset.begin(), pointset.end()));
+        });
+        return result;
+    }
+
+    /**
+     * @brief Reorder the vertices of every polygon into a test RPolygon.
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto create_test_rpolygon(Policy &&policy, PolygonSet<T, Alloc> &set) -> void {
+        detail::for_each_polygon(policy, set, [](std::size_t, auto pointset) {
+            create_test_rpolygon(pointset.begin(), pointset.end());
+        });
+    }
+
+    /**
+     * @brief Reorder the vertices of every polygon into an x-monotone Polygon.
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto create_xmono_polygon(Policy &&policy, PolygonSet<T, Alloc> &set) -> void {
+        detail::for_each_polygon(policy, set, [](std::size_t, auto pointset) {
+            create_xmono_polygon(pointset.begin(), pointset.end());
+        });
+    }
+
+    /**
+     * @brief Reorder the vertices of every polygon into a y-monotone Polygon.
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto create_ymono_polygon(Policy &&policy, PolygonSet<T, Alloc> &set) -> void {
+        detail::for_each_polygon(policy, set, [](std::size_t, auto pointset) {
+            create_ymono_polygon(pointset.begin(), pointset.end());
+        });
+    }
+
+    /**
+     * @brief The signed area of every rectilinear polygon (as `RPolygon::signed_area`).
+     *
+     * @return std::vector<accumulator_t<T>>
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto signed_area(Policy &&policy, const PolygonSet<T, Alloc> &set)
+        -> std::vector<accumulator_t<T>> {
+        auto area = [](gsl::span<const Point<T>> pointset) {
+            return detail::rpolygon_signed_area<T>(pointset);
+        };
+        return detail::map_polygons<accumulator_t<T>>(policy, set, area);
+    }
+
+    /**
+     * @brief Whether `ptq` is inside each rectilinear polygon (as `point_in_rpolygon`).
+     *
+     * @return std::vector<char>
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto point_in_rpolygon(Policy &&policy, const PolygonSet<T, Alloc> &set, const Point<T> &ptq)
+        -> std::vector<char> {
+        return detail::map_polygons<char>(policy, set, [&ptq](gsl::span<const Point<T>> pointset) {
+            return point_in_rpolygon<T>(pointset, ptq);
+        });
+    }
+
+    /**
+     * @brief Whether `ptq` is inside each polygon (as `point_in_polygon`).
+     *
+     * @return std::vector<char>
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto point_in_polygon(Policy &&policy, const PolygonSet<T, Alloc> &set, const Point<T> &ptq)
+        -> std::vector<char> {
+        return detail::map_polygons<char>(policy, set, [&ptq](gsl::span<const Point<T>> pointset) {
+            return point_in_polygon<T>(pointset, ptq);
+        });
+    }
+
+    /**
+     * @brief Whether each rectilinear polygon is clockwise (as `rpolygon_is_clockwise`).
+     *
+     * @return std::vector<char>
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto rpolygon_is_clockwise(Policy &&policy, const PolygonSet<T, Alloc> &set)
+        -> std::vector<char> {
+        return detail::map_polygons<char>(policy, set, [](gsl::span<const Point<T>> pointset) {
+            return rpolygon_is_clockwise<T>(pointset);
+        });
+    }
+
+    /**
+     * @brief Whether each polygon is clockwise (as `polygon_is_clockwise`).
+     *
+     * @return std::vector<char>
+     */
+    template <typename Policy, typename T, typename Alloc>
+        requires execution::is_execution_policy_v<Policy>
+    auto polygon_is_clockwise(Policy &&policy, const PolygonSet<T, Alloc> &set)
+        -> std::vector<char> {
+        return detail::map_polygons<char>(policy, set, [](gsl::span<const Point<T>> pointset) {
+            return polygon_is_clockwise<T>(pointset);
+        });
+    }
+
+    ///@}
+
+}  // namespace recti
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cassert>  // for assert
+#include <cstddef>  // for std::size_t
+#include <gsl/span>
+#include <memory>           // for std::allocator, std::allocator_traits
+#include <memory_resource>  // for std::pmr::polymorphic_allocator
+#include <vector>
+
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Polygon Set (flat storage)
+     *
+     * `PolygonSet` stores many polygons (or rectilinear polygons) in two flat buffers: the
+     * vertices of all polygons back to back, and an offset table where polygon `i` occupies
+     * `points[offsets[i] .. offsets[i + 1])`. Adding a polygon costs no allocation of its own
+     * once the buffers are reserved, and each polygon is handed out as a
+     * `gsl::span<const Point<T>>`, which is exactly what `point_in_polygon`,
+     * `point_in_rpolygon`, `polygon_is_clockwise` and the `Polygon`/`RPolygon` constructors
+     * take.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Alloc The allocator type for the vertices (rebound for the offsets).
+     */
+    template <typename T, typename Alloc = std::allocator<Point<T>>> class PolygonSet {
+      public:
+        using value_type = gsl::span<const Point<T>>;
+        using allocator_type = Alloc;
+
+      private:
+        using OffsetAlloc =
+            typename std::allocator_traits<Alloc>::template rebind_alloc<std::size_t>;
+
+        std::vector<Point<T>, Alloc> _points;
+        std::vector<std::size_t, OffsetAlloc> _offsets;
+
+      public:
+        /**
+         * @brief Construct an empty polygon set (implicitly, so that `{}` works as for the
+         * standard containers).
+         */
+        PolygonSet() : PolygonSet(Alloc()) {}
+
+        /**
+         * @brief Construct an empty polygon set.
+         *
+         * @param[in] alloc The allocator.
+         */
+        explicit PolygonSet(const Alloc &alloc)
+            : _points(alloc), _offsets(1, std::size_t{0}, OffsetAlloc(alloc)) {}
+
+        /**
+         * @brief Reserve storage.
+         *
+         * @param[in] num_polygons The number of polygons.
+         * @param[in] num_points The total number of vertices.
+         */
+        auto reserve(std::size_t num_polygons, std::size_t num_points) -> void {
+            this->_offsets.reserve(num_polygons + 1);
+            this->_points.reserve(num_points);
+        }
+
+        /**
+         * @brief Append a polygon given by its vertices.
+         *
+         * @param[in] pointset The vertices of the polygon.
+         */
+        auto push_back(gsl::span<const Point<T>> pointset) -> void {
+            this->_points.insert(this->_points.end(), pointset.begin(), pointset.end());
+            this->_offsets.push_back(this->_points.size());
+        }
+
+        /**
+         * @brief Append a polygon given by an iterator range of vertices.
+         *
+         * @tparam FwIter The iterator type.
+         * @param[in] first The beginning of the range of vertices.
+         * @param[in] last The end of the range of vertices.
+         */
+        template <typename FwIter> auto push_back(FwIter first, FwIter last) -> void {
+            this->_points.insert(this->_points.end(), first, last);
+            this->_offsets.push_back(this->_points.size());
+        }
+
+        /**
+         * @brief Remove all polygons (the capacity is kept).
+         */
+        auto clear() noexcept -> void {
+            this->_points.clear();
+            this->_offsets.resize(1);
+        }
+
+        /**
+         * @brief The number of polygons.
+         *
+         * @return std::size_t
+         */
+        auto size() const noexcept -> std::size_t { return this->_offsets.size() - 1; }
+
+        /**
+         * @brief Whether the set is empty.
+         *
+         * @return true if there is no polygon.
+         */
+        auto empty() const noexcept -> bool { return this->size() == 0; }
+
+        /**
+         * @brief The total number of vertices of all polygons.
+         *
+         * @return std::size_t
+         */
+        auto num_points() const noexcept -> std::size_t { return this->_points.size(); }
+
+        /**
+         * @brief The vertices of polygon `idx`.
+         *
+         * @param[in] idx The polygon index.
+         * @return gsl::span<const Point<T>>
+         */
+        auto operator[](std::size_t idx) const -> gsl::span<const Point<T>> {
+            assert(idx < this->size());
+            const auto first = this->_offsets[idx];
+            return gsl::span<const Point<T>>(this->_points)
+                .subspan(first, this->_offsets[idx + 1] - first);
+        }
+
+        /**
+         * @brief The vertices of polygon `idx`, for reordering them in place.
+         *
+         * This is a separate name rather than a non-const `operator[]`, so that the functions
+         * deducing `T` from a `gsl::span<const Point<T>>` keep accepting `set[idx]`.
+         *
+         * @param[in] idx The polygon index.
+         * @return gsl::span<Point<T>>
+         */
+        auto mutable_polygon(std::size_t idx) -> gsl::span<Point<T>> {
+            assert(idx < this->size());
+            const auto first = this->_offsets[idx];
+            return gsl::span<Point<T>>(this->_points)
+                .subspan(first, this->_offsets[idx + 1] - first);
+        }
+
+        /**
+         * @brief All vertices of all polygons.
+         *
+         * @return gsl::span<const Point<T>>
+         */
+        auto points() const noexcept -> gsl::span<const Point<T>> { return this->_points; }
+
+        /**
+         * @brief The offset table (`size() + 1` entries, starting with 0).
+         *
+         * @return gsl::span<const std::size_t>
+         */
+        auto offsets() const noexcept -> gsl::span<const std::size_t> { return this->_offsets; }
+
+        /**
+         * @brief The allocator used for the vertices.
+         *
+         * @return allocator_type
+         */
+        auto get_allocator() const -> allocator_type { return this->_points.get_allocator(); }
+    };
+
+    namespace pmr {
+        /**
+         * @brief Polygon set whose buffers come from a `std::pmr::memory_resource`.
+         *
+         * @tparam T
+         */
+        template <typename T> using PolygonSet
+            = recti::PolygonSet<T, std::pmr::polymorphic_allocator<Point<T>>>;
+    }  // namespace pmr
+
+}  // namespace recti
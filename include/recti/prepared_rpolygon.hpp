@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::upper_bound, std::lower_bound
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint64_t
+#include <gsl/span>
+#include <vector>
+
+#include "parallel.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Prepared Rectilinear Polygon
+     *
+     * `PreparedRPolygon` answers `point_in_rpolygon` queries against one fixed rectilinear
+     * polygon in O(log n) time instead of O(n). At construction, the distinct y-coordinates of
+     * the vertices cut the plane into horizontal slabs, and for each slab the x-coordinates of
+     * the vertical edges that cross it are stored in sorted order (all slabs share one flat
+     * array). A query locates its slab and counts, by binary search, the edges to its right;
+     * the point is inside when that count is odd.
+     *
+     * The polygon is given in the same form as for `point_in_rpolygon` (from each point the
+     * boundary goes horizontally, then vertically to the next point), and the answers are
+     * identical to it, including on the boundary.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> class PreparedRPolygon {
+        std::vector<T> _ys{};                  // slab boundaries, sorted and distinct
+        std::vector<std::size_t> _starts{};    // slab `j` owns `_xs[_starts[j] .. _starts[j+1])`
+        std::vector<T> _xs{};                  // vertical-edge abscissae per slab, sorted
+
+      public:
+        /**
+         * @brief Prepare a rectilinear polygon for point queries.
+         *
+         * @param[in] pointset The points defining the rectilinear polygon.
+         */
+        explicit PreparedRPolygon(gsl::span<const Point<T>> pointset) {
+            if (pointset.empty()) {
+                return;
+            }
+            this->_ys.reserve(pointset.size());
+            for (const auto &pt : pointset) {
+                this->_ys.push_back(pt.ycoord());
+            }
+            std::sort(this->_ys.begin(), this->_ys.end());
+            this->_ys.erase(std::unique(this->_ys.begin(), this->_ys.end()), this->_ys.end());
+
+            const auto num_slabs = this->_ys.size() - 1;
+            this->_starts.assign(num_slabs + 1, 0);
+            // first pass counts the edges per slab, second pass fills them in
+            for (auto pass = 0; pass != 2; ++pass) {
+                auto fill = this->_starts;
+                auto pt0 = pointset.back();
+                for (const auto &pt1 : pointset) {
+                    const auto y_min = std::min(pt0.ycoord(), pt1.ycoord());
+                    const auto y_max = std::max(pt0.ycoord(), pt1.ycoord());
+                    const auto first = this->_slab_of(y_min);
+                    const auto last = this->_slab_of(y_max);
+                    for (auto slab = first; slab != last; ++slab) {
+                        if (pass == 0) {
+                            ++this->_starts[slab + 1];
+                        } else {
+                            this->_xs[fill[slab]++] = pt1.xcoord();
+                        }
+                    }
+                    pt0 = pt1;
+                }
+                if (pass == 0) {
+                    for (auto slab = std::size_t{0}; slab != num_slabs; ++slab) {
+                        this->_starts[slab + 1] += this->_starts[slab];
+                    }
+                    this->_xs.resize(this->_starts.back());
+                }
+            }
+            for (auto slab = std::size_t{0}; slab != num_slabs; ++slab) {
+                std::sort(this->_xs.begin() + std::ptrdiff_t(this->_starts[slab]),
+                          this->_xs.begin() + std::ptrdiff_t(this->_starts[slab + 1]));
+            }
+        }
+
+        /**
+         * @brief Whether a point is inside the polygon.
+         *
+         * @param[in] ptq The query point.
+         * @return the same value as `point_in_rpolygon(pointset, ptq)`.
+         */
+        auto contains(const Point<T> &ptq) const -> bool {
+            const auto &y_q = ptq.ycoord();
+            if (this->_ys.empty() || y_q < this->_ys.front() || !(y_q < this->_ys.back())) {
+                return false;
+            }
+            const auto slab = std::size_t(
+                std::upper_bound(this->_ys.begin(), this->_ys.end(), y_q) - this->_ys.begin() - 1);
+            const auto first = this->_xs.begin() + std::ptrdiff_t(this->_starts[slab]);
+            const auto last = this->_xs.begin() + std::ptrdiff_t(this->_starts[slab + 1]);
+            const auto num_right = last - std::upper_bound(first, last, ptq.xcoord());
+            return (num_right & 1) != 0;
+        }
+
+        /**
+         * @brief Batch query: set bit `i % 64` of `mask[i / 64]` iff `pts[i]` is inside.
+         *
+         * The query points are split into blocks of 64 (one mask word each) and the blocks are
+         * processed on up to `num_threads` threads.
+         *
+         * @param[in] pts The query points.
+         * @param[out] mask The result bitmap, at least `(pts.size() + 63) / 64` words.
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         */
+        auto contains(gsl::span<const Point<T>> pts, gsl::span<std::uint64_t> mask,
+                      unsigned num_threads = 1) const -> void {
+            const auto num_words = (pts.size() + 63) / 64;
+            assert(mask.size() >= num_words);
+            auto query_word = [&](std::size_t word) {
+                const auto first = word * 64;
+                const auto last = std::min(first + 64, pts.size());
+                auto bits = std::uint64_t{0};
+                for (auto idx = first; idx != last; ++idx) {
+                    bits |= std::uint64_t(this->contains(pts[idx])) << (idx - first);
+                }
+                mask[word] = bits;
+            };
+            parallel_for(std::size_t{0}, num_words, query_word, num_threads, 16);
+        }
+
+        /**
+         * @brief Batch query returning the result bitmap.
+         *
+         * @param[in] pts The query points.
+         * @param[in] num_threads The number of threads (0 for all hardware threads).
+         * @return std::vector<std::uint64_t> with `(pts.size() + 63) / 64` words.
+         */
+        auto contains(gsl::span<const Point<T>> pts, unsigned num_threads = 1) const
+            -> std::vector<std::uint64_t> {
+            auto mask = std::vector<std::uint64_t>((pts.size() + 63) / 64, 0);
+            this->contains(pts, mask, num_threads);
+            return mask;
+        }
+
+        /**
+         * @brief The number of horizontal slabs.
+         *
+         * @return std::size_t
+         */
+        auto num_slabs() const noexcept -> std::size_t {
+            return this->_ys.empty() ? 0 : this->_ys.size() - 1;
+        }
+
+      private:
+        auto _slab_of(const T &y_coord) const -> std::size_t {
+            return std::size_t(std::lower_bound(this->_ys.begin(), this->_ys.end(), y_coord)
+                               - this->_ys.begin());
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>  // for std::max, std::fill
+#include <bit>        // for std::countr_zero
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint64_t
+#include <gsl/span>
+#include <type_traits>  // for std::is_integral_v
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "recti.hpp"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
+namespace recti {
+
+    namespace detail {
+        /**
+         * @brief Whether the SIMD kernels can handle the coordinate type `T`.
+         *
+         * The hand-written kernels operate on packed 32-bit signed lanes. Every other
+         * coordinate type uses the branch-free scalar loops, which the compiler is free to
+         * auto-vectorize (e.g. on NEON).
+         */
+        template <typename T> inline constexpr bool simd_lanes_i32
+            = std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4;
+    }  // namespace detail
+
+    /**
+     * @brief Rectangle Set (structure of arrays)
+     *
+     * `RectangleSet` stores a collection of axis-parallel rectangles as four separate,
+     * cache-line aligned coordinate arrays (`xlb`, `xub`, `ylb`, `yub`) instead of an array of
+     * packed `Rectangle<T>` objects. This layout lets one query be tested against many
+     * rectangles at once. The batch kernels `overlaps`, `contains` and `min_dist` follow the
+     * same (closed-interval) semantics as the scalar `overlap`, `contain` and `min_dist`
+     * dispatchers in `generic.hpp`.
+     *
+     * When compiled with AVX-512 or AVX2 enabled and `T` is a 32-bit signed integer, the
+     * kernels use explicit SIMD intrinsics; otherwise they fall back to branch-free scalar
+     * loops.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> class RectangleSet {
+      public:
+        using value_type = T;
+        using array_type = std::vector<T, AlignedAllocator<T>>;
+
+      private:
+        array_type _xlb{};
+        array_type _xub{};
+        array_type _ylb{};
+        array_type _yub{};
+
+      public:
+        /**
+         * @brief Construct an empty rectangle set.
+         */
+        RectangleSet() = default;
+
+        /**
+         * @brief Construct a rectangle set from a span of rectangles.
+         *
+         * @param[in] rects The rectangles to be copied into the set.
+         */
+        explicit RectangleSet(gsl::span<const Rectangle<T>> rects) {
+            this->reserve(rects.size());
+            for (const auto &rect : rects) {
+                this->push_back(rect);
+            }
+        }
+
+        /**
+         * @brief Reserve storage for at least `num` rectangles.
+         *
+         * @param[in] num The number of rectangles.
+         */
+        auto reserve(std::size_t num) -> void {
+            this->_xlb.reserve(num);
+            this->_xub.reserve(num);
+            this->_ylb.reserve(num);
+            this->_yub.reserve(num);
+        }
+
+        /**
+         * @brief Append a rectangle.
+         *
+         * @param[in] rect The rectangle to append.
+         */
+        auto push_back(const Rectangle<T> &rect) -> void {
+            this->_xlb.push_back(rect.xcoord().lb());
+            this->_xub.push_back(rect.xcoord().ub());
+            this->_ylb.push_back(rect.ycoord().lb());
+            this->_yub.push_back(rect.ycoord().ub());
+        }
+
+        /**
+         * @brief Remove all rectangles (the capacity is kept).
+         */
+        auto clear() noexcept -> void {
+            this->_xlb.clear();
+            this->_xub.clear();
+            this->_ylb.clear();
+            this->_yub.clear();
+        }
+
+        /**
+         * @brief The number of rectangles.
+         *
+         * @return std::size_t
+         */
+        auto size() const noexcept -> std::size_t { return this->_xlb.size(); }
+
+        /**
+         * @brief Whether the set is empty.
+         *
+         * @return true if there are no rectangles.
+         */
+        auto empty() const noexcept -> bool { return this->_xlb.empty(); }
+
+        /**
+         * @brief Get the `idx`-th rectangle (gathered back into the packed layout).
+         *
+         * @param[in] idx The index.
+         * @return Rectangle<T>
+         */
+        auto operator[](std::size_t idx) const -> Rectangle<T> {
+            return Rectangle<T>{Interval<T>{this->_xlb[idx], this->_xub[idx]},
+                                Interval<T>{this->_ylb[idx], this->_yub[idx]}};
+        }
+
+        /** @name Coordinate arrays
+         *  Read-only access to the underlying aligned arrays.
+         */
+        ///@{
+        auto xlb() const noexcept -> gsl::span<const T> { return this->_xlb; }
+        auto xub() const noexcept -> gsl::span<const T> { return this->_xub; }
+        auto ylb() const noexcept -> gsl::span<const T> { return this->_ylb; }
+        auto yub() const noexcept -> gsl::span<const T> { return this->_yub; }
+        ///@}
+
+        /**
+         * @brief The number of 64-bit words needed for a bitmask over this set.
+         *
+         * @return std::size_t
+         */
+        auto mask_words() const noexcept -> std::size_t { return (this->size() + 63) / 64; }
+
+        /**
+         * @brief Batch overlap test against a query rectangle.
+         *
+         * Bit `i % 64` of `mask[i / 64]` is set if and only if the `i`-th rectangle overlaps
+         * `query` (touching boundaries count as overlapping).
+         *
+         * @param[in] query The query rectangle.
+         * @param[out] mask The output bitmask, at least `mask_words()` words long.
+         */
+        auto overlaps(const Rectangle<T> &query, gsl::span<std::uint64_t> mask) const -> void {
+            assert(mask.size() >= this->mask_words());
+            std::fill(mask.begin(), mask.begin() + std::ptrdiff_t(this->mask_words()), 0U);
+            const auto num = this->size();
+            const auto qxlb = query.xcoord().lb();
+            const auto qxub = query.xcoord().ub();
+            const auto qylb = query.ycoord().lb();
+            const auto qyub = query.ycoord().ub();
+            auto idx = std::size_t{0};
+            if constexpr (detail::simd_lanes_i32<T>) {
+                idx = this->_overlaps_simd(qxlb, qxub, qylb, qyub, mask);
+            }
+            for (; idx != num; ++idx) {
+                const auto hit = (this->_xub[idx] >= qxlb) & (qxub >= this->_xlb[idx])
+                                 & (this->_yub[idx] >= qylb) & (qyub >= this->_ylb[idx]);
+                mask[idx / 64] |= std::uint64_t(hit) << (idx % 64);
+            }
+        }
+
+        /**
+         * @brief Batch overlap test against a query rectangle.
+         *
+         * @param[in] query The query rectangle.
+         * @return std::vector<std::uint64_t> The bitmask (see the span overload).
+         */
+        auto overlaps(const Rectangle<T> &query) const -> std::vector<std::uint64_t> {
+            auto mask = std::vector<std::uint64_t>(this->mask_words());
+            this->overlaps(query, mask);
+            return mask;
+        }
+
+        /**
+         * @brief Collect the indices of the rectangles containing a point.
+         *
+         * The indices are appended to `result` in increasing order, so a caller can reuse
+         * the same vector across queries without reallocation.
+         *
+         * @param[in] ptq The query point.
+         * @param[in,out] result The index buffer to append to.
+         */
+        auto contains(const Point<T> &ptq, std::vector<std::size_t> &result) const -> void {
+            const auto num = this->size();
+            const auto qx = ptq.xcoord();
+            const auto qy = ptq.ycoord();
+            auto idx = std::size_t{0};
+            if constexpr (detail::simd_lanes_i32<T>) {
+                idx = this->_contains_simd(qx, qy, result);
+            }
+            for (; idx != num; ++idx) {
+                const auto hit = (this->_xlb[idx] <= qx) & (qx <= this->_xub[idx])
+                                 & (this->_ylb[idx] <= qy) & (qy <= this->_yub[idx]);
+                if (hit) {
+                    result.push_back(idx);
+                }
+            }
+        }
+
+        /**
+         * @brief Collect the indices of the rectangles containing a point.
+         *
+         * @param[in] ptq The query point.
+         * @return std::vector<std::size_t> The indices in increasing order.
+         */
+        auto contains(const Point<T> &ptq) const -> std::vector<std::size_t> {
+            auto result = std::vector<std::size_t>{};
+            this->contains(ptq, result);
+            return result;
+        }
+
+        /**
+         * @brief Batch (Manhattan) minimum distance to a query rectangle.
+         *
+         * `dist[i]` receives `min_dist((*this)[i], query)`, i.e. zero for overlapping
+         * rectangles and the sum of the axis gaps otherwise.
+         *
+         * @param[in] query The query rectangle.
+         * @param[out] dist The output distances, at least `size()` long.
+         */
+        auto min_dist(const Rectangle<T> &query, gsl::span<T> dist) const -> void {
+            assert(dist.size() >= this->size());
+            const auto num = this->size();
+            const auto qxlb = query.xcoord().lb();
+            const auto qxub = query.xcoord().ub();
+            const auto qylb = query.ycoord().lb();
+            const auto qyub = query.ycoord().ub();
+            auto idx = std::size_t{0};
+            if constexpr (detail::simd_lanes_i32<T>) {
+                idx = this->_min_dist_simd(qxlb, qxub, qylb, qyub, dist);
+            }
+            const auto zero = T(0);
+            for (; idx != num; ++idx) {
+                const T d_x = std::max(zero, std::max(T(qxlb - this->_xub[idx]),
+                                                      T(this->_xlb[idx] - qxub)));
+                const T d_y = std::max(zero, std::max(T(qylb - this->_yub[idx]),
+                                                      T(this->_ylb[idx] - qyub)));
+                dist[idx] = T(d_x + d_y);
+            }
+        }
+
+        /**
+         * @brief Batch (Manhattan) minimum distance to a query rectangle.
+         *
+         * @param[in] query The query rectangle.
+         * @return std::vector<T> The distances (see the span overload).
+         */
+        auto min_dist(const Rectangle<T> &query) const -> std::vector<T> {
+            auto dist = std::vector<T>(this->size());
+            this->min_dist(query, dist);
+            return dist;
+        }
+
+      private:
+        // The SIMD helpers process whole vectors and return the index of the first element
+        // left for the scalar tail loop.
+
+        auto _overlaps_simd([[maybe_unused]] T qxlb, [[maybe_unused]] T qxub,
+                            [[maybe_unused]] T qylb, [[maybe_unused]] T qyub,
+                            [[maybe_unused]] gsl::span<std::uint64_t> mask) const
+            -> std::size_t {
+            auto idx = std::size_t{0};
+#if defined(__AVX512F__)
+            const auto vqxlb = _mm512_set1_epi32(qxlb);
+            const auto vqxub = _mm512_set1_epi32(qxub);
+            const auto vqylb = _mm512_set1_epi32(qylb);
+            const auto vqyub = _mm512_set1_epi32(qyub);
+            for (; idx + 16 <= this->size(); idx += 16) {
+                const auto apart
+                    = _mm512_cmpgt_epi32_mask(vqxlb, _mm512_load_si512(&this->_xub[idx]))
+                      | _mm512_cmpgt_epi32_mask(_mm512_load_si512(&this->_xlb[idx]), vqxub)
+                      | _mm512_cmpgt_epi32_mask(vqylb, _mm512_load_si512(&this->_yub[idx]))
+                      | _mm512_cmpgt_epi32_mask(_mm512_load_si512(&this->_ylb[idx]), vqyub);
+                const auto bits = std::uint64_t(std::uint16_t(~apart));
+                mask[idx / 64] |= bits << (idx % 64);
+            }
+#elif defined(__AVX2__)
+            const auto vqxlb = _mm256_set1_epi32(qxlb);
+            const auto vqxub = _mm256_set1_epi32(qxub);
+            const auto vqylb = _mm256_set1_epi32(qylb);
+            const auto vqyub = _mm256_set1_epi32(qyub);
+            for (; idx + 8 <= this->size(); idx += 8) {
+                const auto apart = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpgt_epi32(vqxlb, _load256(&this->_xub[idx])),
+                                    _mm256_cmpgt_epi32(_load256(&this->_xlb[idx]), vqxub)),
+                    _mm256_or_si256(_mm256_cmpgt_epi32(vqylb, _load256(&this->_yub[idx])),
+                                    _mm256_cmpgt_epi32(_load256(&this->_ylb[idx]), vqyub)));
+                const auto bits = std::uint64_t(
+                    unsigned(~_mm256_movemask_ps(_mm256_castsi256_ps(apart))) & 0xFFU);
+                mask[idx / 64] |= bits << (idx % 64);
+            }
+#endif
+            return idx;
+        }
+
+        auto _contains_simd([[maybe_unused]] T qx, [[maybe_unused]] T qy,
+                            [[maybe_unused]] std::vector<std::size_t> &result) const
+            -> std::size_t {
+            auto idx = std::size_t{0};
+#if defined(__AVX512F__)
+            const auto vqx = _mm512_set1_epi32(qx);
+            const auto vqy = _mm512_set1_epi32(qy);
+            for (; idx + 16 <= this->size(); idx += 16) {
+                const auto apart
+                    = _mm512_cmpgt_epi32_mask(_mm512_load_si512(&this->_xlb[idx]), vqx)
+                      | _mm512_cmpgt_epi32_mask(vqx, _mm512_load_si512(&this->_xub[idx]))
+                      | _mm512_cmpgt_epi32_mask(_mm512_load_si512(&this->_ylb[idx]), vqy)
+                      | _mm512_cmpgt_epi32_mask(vqy, _mm512_load_si512(&this->_yub[idx]));
+                _append_bits(unsigned(std::uint16_t(~apart)), idx, result);
+            }
+#elif defined(__AVX2__)
+            const auto vqx = _mm256_set1_epi32(qx);
+            const auto vqy = _mm256_set1_epi32(qy);
+            for (; idx + 8 <= this->size(); idx += 8) {
+                const auto apart = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpgt_epi32(_load256(&this->_xlb[idx]), vqx),
+                                    _mm256_cmpgt_epi32(vqx, _load256(&this->_xub[idx]))),
+                    _mm256_or_si256(_mm256_cmpgt_epi32(_load256(&this->_ylb[idx]), vqy),
+                                    _mm256_cmpgt_epi32(vqy, _load256(&this->_yub[idx]))));
+                _append_bits(unsigned(~_mm256_movemask_ps(_mm256_castsi256_ps(apart))) & 0xFFU,
+                             idx, result);
+            }
+#endif
+            return idx;
+        }
+
+        auto _min_dist_simd([[maybe_unused]] T qxlb, [[maybe_unused]] T qxub,
+                            [[maybe_unused]] T qylb, [[maybe_unused]] T qyub,
+                            [[maybe_unused]] gsl::span<T> dist) const -> std::size_t {
+            auto idx = std::size_t{0};
+#if defined(__AVX512F__)
+            // the zero-masked max avoids the `_mm512_undefined_epi32` of `_mm512_max_epi32`
+            const auto all = __mmask16(0xFFFFU);
+            const auto zero = _mm512_setzero_si512();
+            const auto vqxlb = _mm512_set1_epi32(qxlb);
+            const auto vqxub = _mm512_set1_epi32(qxub);
+            const auto vqylb = _mm512_set1_epi32(qylb);
+            const auto vqyub = _mm512_set1_epi32(qyub);
+            for (; idx + 16 <= this->size(); idx += 16) {
+                const auto gap_x0 = _mm512_sub_epi32(vqxlb, _mm512_load_si512(&this->_xub[idx]));
+                const auto gap_x1 = _mm512_sub_epi32(_mm512_load_si512(&this->_xlb[idx]), vqxub);
+                const auto gap_y0 = _mm512_sub_epi32(vqylb, _mm512_load_si512(&this->_yub[idx]));
+                const auto gap_y1 = _mm512_sub_epi32(_mm512_load_si512(&this->_ylb[idx]), vqyub);
+                const auto d_x = _mm512_maskz_max_epi32(
+                    all, zero, _mm512_maskz_max_epi32(all, gap_x0, gap_x1));
+                const auto d_y = _mm512_maskz_max_epi32(
+                    all, zero, _mm512_maskz_max_epi32(all, gap_y0, gap_y1));
+                _mm512_storeu_si512(&dist[idx], _mm512_add_epi32(d_x, d_y));
+            }
+#elif defined(__AVX2__)
+            const auto zero = _mm256_setzero_si256();
+            const auto vqxlb = _mm256_set1_epi32(qxlb);
+            const auto vqxub = _mm256_set1_epi32(qxub);
+            const auto vqylb = _mm256_set1_epi32(qylb);
+            const auto vqyub = _mm256_set1_epi32(qyub);
+            for (; idx + 8 <= this->size(); idx += 8) {
+                const auto d_x = _mm256_max_epi32(
+                    zero, _mm256_max_epi32(_mm256_sub_epi32(vqxlb, _load256(&this->_xub[idx])),
+                                           _mm256_sub_epi32(_load256(&this->_xlb[idx]), vqxub)));
+                const auto d_y = _mm256_max_epi32(
+                    zero, _mm256_max_epi32(_mm256_sub_epi32(vqylb, _load256(&this->_yub[idx])),
+                                           _mm256_sub_epi32(_load256(&this->_ylb[idx]), vqyub)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dist[idx]),
+                                    _mm256_add_epi32(d_x, d_y));
+            }
+#endif
+            return idx;
+        }
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#    if defined(__AVX2__)
+        static auto _load256(const T *ptr) -> __m256i {
+            return _mm256_load_si256(reinterpret_cast<const __m256i *>(ptr));
+        }
+#    endif
+
+        static auto _append_bits(unsigned bits, std::size_t base, std::vector<std::size_t> &result)
+            -> void {
+            while (bits != 0U) {
+                result.push_back(base + std::size_t(std::countr_zero(bits)));
+                bits &= bits - 1U;
+            }
+        }
+#endif
+    };
+
+}  // namespace recti
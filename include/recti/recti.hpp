@@ -1,7 +1,11 @@
 #pragma once
 
-#include "interval.hpp"  // for Interval
-#include "point.hpp"     // for Point
+#include <cstdint>      // for std::int64_t
+#include <type_traits>  // for std::is_trivially_copyable_v, std::is_standard_layout_v
+
+#include "accumulator.hpp"  // for accumulator_t, widen
+#include "interval.hpp"     // for Interval
+#include "point.hpp"        // for Point
 
 namespace recti {
 
@@ -89,12 +93,13 @@ namespace recti {
          * @brief area
          *
          * The `area()` function is a member function of the `Rectangle` struct. It
-         * calculates and returns the area of the rectangle.
+         * calculates and returns the area of the rectangle, in the accumulator type of `T`
+         * (see `accumulator_t`).
          *
-         * @return constexpr T
+         * @return constexpr accumulator_t<T>
          */
-        constexpr auto area() const -> T {
-            return this->xcoord().length() * this->ycoord().length();
+        constexpr auto area() const -> accumulator_t<T> {
+            return widen(this->xcoord().length()) * widen(this->ycoord().length());
         }
     };
 #pragma pack(pop)
@@ -205,4 +210,25 @@ namespace recti {
     };
 #pragma pack(pop)
 
+    namespace detail {
+        /**
+         * @brief The value types may be copied with `memcpy` and stored in flat arrays (e.g.
+         * the structure-of-arrays of `RectangleSet`), with no padding between coordinates.
+         */
+        template <typename T> constexpr auto is_flat_value() -> bool {
+            return std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>;
+        }
+
+        template <typename T> constexpr auto has_flat_geometry() -> bool {
+            return is_flat_value<Interval<T>>() && is_flat_value<Point<T>>()
+                   && is_flat_value<Vector2<T>>() && is_flat_value<Rectangle<T>>()
+                   && is_flat_value<HSegment<T>>() && is_flat_value<VSegment<T>>()
+                   && sizeof(Rectangle<T>) == 4 * sizeof(T);
+        }
+    }  // namespace detail
+
+    static_assert(detail::has_flat_geometry<int>(), "geometry of int must be memcpy-able");
+    static_assert(detail::has_flat_geometry<std::int64_t>(),
+                  "geometry of int64_t must be memcpy-able");
+
 }  // namespace recti
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>  // for std::size_t
 #include <gsl/span>
-#include <utility>  // for std::pair
+#include <memory>           // for std::allocator
+#include <memory_resource>  // for std::pmr::polymorphic_allocator
+#include <utility>          // for std::pair
 #include <vector>
 
+#include "point_sort.hpp"
 #include "recti.hpp"
 
 namespace recti {
@@ -16,12 +20,25 @@ namespace recti {
      * stores the origin point and a vector of edges that define the polygon. The
      * template parameter `T` specifies the type of the coordinates of the points.
      *
+     * The edge vectors are stored with the allocator `Alloc`, so that many short-lived
+     * polygons can share an arena, e.g. `pmr::RPolygon<T>` over a
+     * `std::pmr::monotonic_buffer_resource`.
+     *
      * @tparam T
+     * @tparam Alloc The allocator type for the edge vectors.
      */
-    template <typename T> class RPolygon {
+    template <typename T, typename Alloc = std::allocator<Vector2<T>>> class RPolygon {
+      public:
+        using allocator_type = Alloc;
+
       private:
         Point<T> _origin{};
-        std::vector<Vector2<T>> _vecs{};  // @todo: add custom allocator support
+        std::vector<Vector2<T>, Alloc> _vecs;
+        // cached at construction; the corners are relative to `_origin`, so a translation
+        // moves the bounding box and keeps the area without touching them
+        Vector2<T> _lb_vec{T{}, T{}};
+        Vector2<T> _ub_vec{T{}, T{}};
+        accumulator_t<T> _area{};
 
       public:
         /**
@@ -34,11 +51,24 @@ namespace recti {
          *
          * @param[in] pointset A span of `Point<T>` objects representing the vertices of
          * the rectilinear polygon.
+         * @param[in] alloc The allocator for the edge vectors.
          */
-        explicit constexpr RPolygon(gsl::span<const Point<T>> pointset)
-            : _origin{pointset.front()} {
+        explicit constexpr RPolygon(gsl::span<const Point<T>> pointset,
+                                    const Alloc &alloc = Alloc())
+            : _origin{pointset.front()}, _vecs(alloc) {
+            this->_vecs.reserve(pointset.size() - 1);
             for (auto itr = std::next(pointset.begin()); itr != pointset.end(); ++itr) {
                 this->_vecs.push_back(*itr - this->_origin);
+                this->_extend_bbox(this->_vecs.back());
+            }
+            if (!this->_vecs.empty()) {
+                auto itr1 = this->_vecs.begin();
+                auto itr0 = itr1++;
+                auto res = widen(itr0->x()) * widen(itr0->y());
+                for (; itr1 != this->_vecs.end(); ++itr1, ++itr0) {
+                    res = std::move(res) + widen(itr1->x()) * widen(itr1->y() - itr0->y());
+                }
+                this->_area = std::move(res);
             }
         }
 
@@ -46,7 +76,8 @@ namespace recti {
          * @brief Adds a vector to the origin of the rectilinear polygon.
          *
          * This method adds the given vector to the origin point of the rectilinear polygon,
-         * effectively translating the entire polygon by the specified vector.
+         * effectively translating the entire polygon by the specified vector. The cached
+         * bounding box moves with it and the cached area is kept.
          *
          * @param[in] vector The vector to add to the origin.
          * @return A reference to the modified RPolygon object.
@@ -56,23 +87,27 @@ namespace recti {
             return *this;
         }
 
+        /**
+         * @brief The allocator used for the edge vectors.
+         *
+         * @return allocator_type
+         */
+        constexpr auto get_allocator() const -> allocator_type {
+            return this->_vecs.get_allocator();
+        }
+
         /**
          * @brief Calculates the signed area of the rectilinear polygon.
          *
-         * This method calculates the signed area of the rectilinear polygon represented by this
-         * `RPolygon` object.
+         * This method returns the signed area of the rectilinear polygon represented by this
+         * `RPolygon` object. It is computed once, at construction, in the accumulator type
+         * of `T`.
          *
          * @return The signed area of the rectilinear polygon.
          */
-        constexpr auto signed_area() const -> T {
+        constexpr auto signed_area() const -> accumulator_t<T> {
             assert(this->_vecs.size() >= 1);
-            auto itr1 = this->_vecs.begin();
-            auto itr0 = itr1++;
-            auto res = itr0->x() * itr0->y();
-            for (; itr1 != this->_vecs.end(); ++itr1, ++itr0) {
-                res = std::move(res) + itr1->x() * (itr1->y() - itr0->y());
-            }
-            return res;
+            return this->_area;
         }
 
         /**
@@ -89,20 +124,67 @@ namespace recti {
         template <typename U> auto contains(const Point<U> &rhs) const -> bool;
 
         /**
-         * @brief
+         * @brief The lower-left corner of the bounding box of the rectilinear polygon.
          *
          * @return Point<T>
          */
-        auto lb() const -> Point<T>;
+        constexpr auto lb() const -> Point<T> { return this->_origin + this->_lb_vec; }
+
+        /**
+         * @brief The upper-right corner of the bounding box of the rectilinear polygon.
+         *
+         * @return Point<T>
+         */
+        constexpr auto ub() const -> Point<T> { return this->_origin + this->_ub_vec; }
+
+        /**
+         * @brief The bounding box of the rectilinear polygon.
+         *
+         * @return Rectangle<T>
+         */
+        constexpr auto bounding_box() const -> Rectangle<T> {
+            const auto lower = this->lb();
+            const auto upper = this->ub();
+            return Rectangle<T>{Interval<T>{lower.xcoord(), upper.xcoord()},
+                                Interval<T>{lower.ycoord(), upper.ycoord()}};
+        }
 
         /**
-         * @brief
+         * @brief The number of vertices of the rectilinear polygon.
          *
+         * @return std::size_t
+         */
+        constexpr auto num_vertices() const -> std::size_t { return this->_vecs.size() + 1; }
+
+        /**
+         * @brief Vertex `idx` of the rectilinear polygon (vertex 0 is the origin).
+         *
+         * @param[in] idx The vertex index, less than `num_vertices()`.
          * @return Point<T>
          */
-        auto ub() const -> Point<T>;
+        constexpr auto vertex(std::size_t idx) const -> Point<T> {
+            return idx == 0 ? this->_origin : this->_origin + this->_vecs[idx - 1];
+        }
+
+      private:
+        constexpr auto _extend_bbox(const Vector2<T> &vec) -> void {
+            this->_lb_vec = Vector2<T>{std::min(this->_lb_vec.x(), vec.x()),
+                                       std::min(this->_lb_vec.y(), vec.y())};
+            this->_ub_vec = Vector2<T>{std::max(this->_ub_vec.x(), vec.x()),
+                                       std::max(this->_ub_vec.y(), vec.y())};
+        }
     };
 
+    namespace pmr {
+        /**
+         * @brief Rectilinear polygon whose edge vectors come from a `std::pmr::memory_resource`.
+         *
+         * @tparam T
+         */
+        template <typename T> using RPolygon
+            = recti::RPolygon<T, std::pmr::polymorphic_allocator<Vector2<T>>>;
+    }  // namespace pmr
+
     /**
      * @brief Create a x-monotone rectilinear polygon (RPolygon) object.
      *
@@ -110,6 +192,9 @@ namespace recti {
      * function `dir` that extracts the x and y coordinates of each point. It then creates an
      * monotone RPolygon object from the given points.
      *
+     * The two chains are sorted with `detail::sort_by_key`: when `dir` returns pairs of integers
+     * of at most 32 bits (e.g. for `Point<int>`), large inputs are radix sorted in linear time.
+     *
      * @tparam FwIter The iterator type for the range of points.
      * @tparam KeyFn The type of the key function that extracts the x and y coordinates of each
      * point.
@@ -138,8 +223,8 @@ namespace recti {
         };
         const auto middle = is_anticw ? std::partition(first, last, std::move(r2l))
                                       : std::partition(first, last, std::move(l2r));
-        std::sort(first, middle, leftward);
-        std::sort(middle, last, std::move(leftward));
+        detail::sort_by_key(first, middle, dir);
+        detail::sort_by_key(middle, last, dir);
         std::reverse(middle, last);
         return is_anticw;  // is_clockwise if y-monotone
     }
@@ -192,21 +277,13 @@ namespace recti {
     template <typename FwIter> inline void create_test_rpolygon(FwIter &&first, FwIter &&last) {
         assert(first != last);
 
-        auto upwd = [](const auto &rhs, const auto &lhs) -> bool {
-            return std::make_pair(rhs.ycoord(), rhs.xcoord())
-                   < std::make_pair(lhs.ycoord(), lhs.xcoord());
-        };
-        auto down = [](const auto &rhs, const auto &lhs) -> bool {
-            return std::make_pair(rhs.ycoord(), rhs.xcoord())
-                   > std::make_pair(lhs.ycoord(), lhs.xcoord());
-        };
-        auto left = [](const auto &rhs, const auto &lhs) {
-            return std::make_pair(rhs.xcoord(), rhs.ycoord())
-                   < std::make_pair(lhs.xcoord(), lhs.ycoord());
+        auto y_first = [](const auto &pt) { return std::make_pair(pt.ycoord(), pt.xcoord()); };
+        auto x_first = [](const auto &pt) { return std::make_pair(pt.xcoord(), pt.ycoord()); };
+        auto upwd = [&y_first](const auto &rhs, const auto &lhs) -> bool {
+            return y_first(rhs) < y_first(lhs);
         };
-        auto right = [](const auto &rhs, const auto &lhs) {
-            return std::make_pair(rhs.xcoord(), rhs.ycoord())
-                   > std::make_pair(lhs.xcoord(), lhs.ycoord());
+        auto left = [&x_first](const auto &rhs, const auto &lhs) -> bool {
+            return x_first(rhs) < x_first(lhs);
         };
 
         auto result = std::minmax_element(first, last, upwd);
@@ -227,16 +304,21 @@ namespace recti {
             return elem.ycoord() > min_pt2.ycoord();
         });
 
+        // the descending runs are sorted ascending, then reversed
         if (d_x < 0) {  // clockwise
-            std::sort(first, middle2, down);
-            std::sort(middle2, middle, left);
-            std::sort(middle, middle3, upwd);
-            std::sort(middle3, last, right);
+            detail::sort_by_key(first, middle2, y_first);
+            std::reverse(first, middle2);
+            detail::sort_by_key(middle2, middle, x_first);
+            detail::sort_by_key(middle, middle3, y_first);
+            detail::sort_by_key(middle3, last, x_first);
+            std::reverse(middle3, last);
         } else {  // anti-clockwise
-            std::sort(first, middle2, left);
-            std::sort(middle2, middle, upwd);
-            std::sort(middle, middle3, right);
-            std::sort(middle3, last, down);
+            detail::sort_by_key(first, middle2, x_first);
+            detail::sort_by_key(middle2, middle, y_first);
+            detail::sort_by_key(middle, middle3, x_first);
+            std::reverse(middle, middle3);
+            detail::sort_by_key(middle3, last, y_first);
+            std::reverse(middle3, last);
         }
     }
 
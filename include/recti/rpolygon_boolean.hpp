@@ -0,0 +1,690 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::lower_bound, std::unique, std::minmax
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t
+#include <gsl/span>
+#include <stdexcept>  // for std::runtime_error
+#include <utility>    // for std::pair
+#include <vector>
+
+#include "instrument.hpp"
+#include "parallel.hpp"
+#include "polygon_set.hpp"
+#include "recti.hpp"
+#include "rpolygon.hpp"
+#include "rtree.hpp"
+
+namespace recti {
+
+    /**
+     * @brief The Boolean operations supported by `rpolygon_boolean`.
+     */
+    enum class BoolOp { Union, Intersection, Difference, Xor };
+
+    /**
+     * @brief A rectilinear polygon with holes
+     *
+     * The outer boundary and the holes use the same point-list form as `RPolygon` and
+     * `point_in_rpolygon` (from each point the boundary goes horizontally, then vertically to
+     * the next point). The outer boundary is anti-clockwise, the holes are clockwise.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> struct RPolygonWithHoles {
+        std::vector<Point<T>> outer{};
+        std::vector<std::vector<Point<T>>> holes{};
+
+        /**
+         * @brief The outer boundary as an `RPolygon`.
+         *
+         * @return RPolygon<T>
+         */
+        auto rpolygon() const -> RPolygon<T> { return RPolygon<T>(this->outer); }
+
+        /**
+         * @brief The area (outer area minus the area of the holes).
+         *
+         * @return accumulator_t<T>
+         */
+        auto area() const -> accumulator_t<T> {
+            auto res = RPolygon<T>(this->outer).signed_area();
+            for (const auto &hole : this->holes) {
+                res += RPolygon<T>(hole).signed_area();  // negative: holes are clockwise
+            }
+            return res;
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief An input edge for the scanline: at `pos`, the coverage counts of the
+         * elementary intervals `[lo, hi)` change by `w_a` (first operand) and `w_b` (second).
+         */
+        template <typename T> struct ScanEdge {
+            T pos;
+            std::uint32_t lo;
+            std::uint32_t hi;
+            int w_a;
+            int w_b;
+        };
+
+        /**
+         * @brief A maximal output boundary edge at `pos` spanning `[lo, hi]`; `entering` if the
+         * result is entered when crossing it in increasing `pos`.
+         */
+        template <typename T> struct BoundaryEdge {
+            T pos;
+            T lo;
+            T hi;
+            bool entering;
+        };
+
+        inline auto bool_op_inside(BoolOp op, int cnt_a, int cnt_b) -> bool {
+            const auto in_a = cnt_a > 0;
+            const auto in_b = cnt_b > 0;
+            switch (op) {
+                case BoolOp::Union:
+                    return in_a || in_b;
+                case BoolOp::Intersection:
+                    return in_a && in_b;
+                case BoolOp::Difference:
+                    return in_a && !in_b;
+                default:
+                    return in_a != in_b;
+            }
+        }
+
+        /// A maximal run `[lo, hi)` of elementary intervals with the same result status.
+        struct StatusRun {
+            std::uint32_t lo;
+            std::uint32_t hi;
+            bool inside;
+        };
+
+        /**
+         * @brief Segment tree over the elementary intervals, holding the coverage counts of
+         * both operands under lazy range additions.
+         *
+         * Each node keeps the minimum and maximum count of either operand in its range. Where
+         * both are on one side of zero throughout, the result of `op` is uniform there and
+         * the node is reported without descending, so listing the status runs of a range
+         * costs O(log n) per change of either operand's coverage inside it.
+         */
+        class CoverTree {
+            struct Node {
+                int min_a{0};
+                int max_a{0};
+                int min_b{0};
+                int max_b{0};
+                int add_a{0};  // pending for the children
+                int add_b{0};
+            };
+
+            std::vector<Node> _nodes;
+            std::uint32_t _size;
+
+          public:
+            /**
+             * @brief Build the tree over the counts `cnt_a`, `cnt_b` of the elementary
+             * intervals.
+             */
+            CoverTree(gsl::span<const int> cnt_a, gsl::span<const int> cnt_b)
+                : _nodes(4 * std::max<std::size_t>(cnt_a.size(), 1)),
+                  _size{std::uint32_t(cnt_a.size())} {
+                if (this->_size != 0) {
+                    this->_build(1, 0, this->_size, cnt_a, cnt_b);
+                }
+            }
+
+            /// Add `w_a`, `w_b` to the counts of the elementary intervals `[lo, hi)`.
+            auto add(std::uint32_t lo, std::uint32_t hi, int w_a, int w_b) -> void {
+                if (lo < hi) {
+                    this->_add(1, 0, this->_size, lo, hi, w_a, w_b);
+                }
+            }
+
+            /// Append the status runs of `[lo, hi)` under `op` to `runs`, adjacent ones merged.
+            auto runs(std::uint32_t lo, std::uint32_t hi, BoolOp op, std::vector<StatusRun> &runs)
+                -> void {
+                if (lo < hi) {
+                    this->_runs(1, 0, this->_size, lo, hi, op, runs);
+                }
+            }
+
+          private:
+            auto _pull(std::size_t node) -> void {
+                auto &cur = this->_nodes[node];
+                const auto &left = this->_nodes[2 * node];
+                const auto &right = this->_nodes[2 * node + 1];
+                cur.min_a = std::min(left.min_a, right.min_a);
+                cur.max_a = std::max(left.max_a, right.max_a);
+                cur.min_b = std::min(left.min_b, right.min_b);
+                cur.max_b = std::max(left.max_b, right.max_b);
+            }
+
+            auto _apply(std::size_t node, int w_a, int w_b) -> void {
+                auto &cur = this->_nodes[node];
+                cur.min_a += w_a;
+                cur.max_a += w_a;
+                cur.min_b += w_b;
+                cur.max_b += w_b;
+                cur.add_a += w_a;
+                cur.add_b += w_b;
+            }
+
+            auto _push(std::size_t node) -> void {
+                auto &cur = this->_nodes[node];
+                if (cur.add_a != 0 || cur.add_b != 0) {
+                    this->_apply(2 * node, cur.add_a, cur.add_b);
+                    this->_apply(2 * node + 1, cur.add_a, cur.add_b);
+                    cur.add_a = 0;
+                    cur.add_b = 0;
+                }
+            }
+
+            auto _build(std::size_t node, std::uint32_t first, std::uint32_t last,
+                        gsl::span<const int> cnt_a, gsl::span<const int> cnt_b) -> void {
+                if (last - first == 1) {
+                    this->_nodes[node] = Node{cnt_a[first], cnt_a[first], cnt_b[first],
+                                              cnt_b[first], 0, 0};
+                    return;
+                }
+                const auto mid = first + (last - first) / 2;
+                this->_build(2 * node, first, mid, cnt_a, cnt_b);
+                this->_build(2 * node + 1, mid, last, cnt_a, cnt_b);
+                this->_pull(node);
+            }
+
+            auto _add(std::size_t node, std::uint32_t first, std::uint32_t last, std::uint32_t lo,
+                      std::uint32_t hi, int w_a, int w_b) -> void {
+                if (lo <= first && last <= hi) {
+                    this->_apply(node, w_a, w_b);
+                    return;
+                }
+                this->_push(node);
+                const auto mid = first + (last - first) / 2;
+                if (lo < mid) {
+                    this->_add(2 * node, first, mid, lo, hi, w_a, w_b);
+                }
+                if (mid < hi) {
+                    this->_add(2 * node + 1, mid, last, lo, hi, w_a, w_b);
+                }
+                this->_pull(node);
+            }
+
+            auto _runs(std::size_t node, std::uint32_t first, std::uint32_t last,
+                       std::uint32_t lo, std::uint32_t hi, BoolOp op,
+                       std::vector<StatusRun> &runs) -> void {
+                const auto &cur = this->_nodes[node];
+                const auto uniform_a = cur.min_a > 0 || cur.max_a <= 0;
+                const auto uniform_b = cur.min_b > 0 || cur.max_b <= 0;
+                if (uniform_a && uniform_b) {
+                    const auto run_lo = std::max(first, lo);
+                    const auto run_hi = std::min(last, hi);
+                    const auto inside = bool_op_inside(op, cur.max_a, cur.max_b);
+                    if (!runs.empty() && runs.back().hi == run_lo && runs.back().inside == inside) {
+                        runs.back().hi = run_hi;
+                    } else {
+                        runs.push_back({run_lo, run_hi, inside});
+                    }
+                    return;
+                }
+                this->_push(node);
+                const auto mid = first + (last - first) / 2;
+                if (lo < mid) {
+                    this->_runs(2 * node, first, mid, lo, hi, op, runs);
+                }
+                if (mid < hi) {
+                    this->_runs(2 * node + 1, mid, last, lo, hi, op, runs);
+                }
+            }
+        };
+
+        /**
+         * @brief One scanline pass over the edges of one orientation.
+         *
+         * The scan positions are split into strips of about equal numbers of edges. The
+         * coverage counts at the start of each strip are obtained from per-strip difference
+         * arrays (summed in parallel, then scanned across the strips), after which the strips
+         * are swept independently, each with a `CoverTree`. At each position the status runs
+         * over the ranges of its edges are listed before and after adding the edges, and the
+         * runs whose status differs become the boundary edges.
+         */
+        template <typename T>
+        auto boolean_scan(std::vector<ScanEdge<T>> &edges, gsl::span<const T> coords, BoolOp op,
+                          unsigned num_threads) -> std::vector<BoundaryEdge<T>> {
+            using Diff = std::vector<int>;
+            std::sort(edges.begin(), edges.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.pos < rhs.pos; });
+            const auto num_elems = coords.empty() ? std::size_t{0} : coords.size() - 1;
+            if (num_threads == 0) {
+                num_threads = hardware_threads();
+            }
+
+            // strip `s` holds edges[cuts[s] .. cuts[s+1]), never splitting one position
+            auto cuts = std::vector<std::size_t>{0};
+            const auto num_strips
+                = std::max<std::size_t>(1, std::min<std::size_t>(num_threads, edges.size() / 4096));
+            for (auto strip = std::size_t{1}; strip < num_strips; ++strip) {
+                auto cut = std::max(cuts.back(), strip * edges.size() / num_strips);
+                while (cut != 0 && cut < edges.size() && !(edges[cut - 1].pos < edges[cut].pos)) {
+                    ++cut;
+                }
+                if (cut != cuts.back() && cut != edges.size()) {
+                    cuts.push_back(cut);
+                }
+            }
+            cuts.push_back(edges.size());
+            const auto strips = cuts.size() - 1;
+
+            auto diff_a = std::vector<Diff>(strips, Diff(num_elems + 1, 0));
+            auto diff_b = std::vector<Diff>(strips, Diff(num_elems + 1, 0));
+            if (strips > 1) {
+                parallel_for(
+                    0, strips - 1,
+                    [&](std::size_t strip) {
+                        for (auto idx = cuts[strip]; idx != cuts[strip + 1]; ++idx) {
+                            const auto &edge = edges[idx];
+                            diff_a[strip][edge.lo] += edge.w_a;
+                            diff_a[strip][edge.hi] -= edge.w_a;
+                            diff_b[strip][edge.lo] += edge.w_b;
+                            diff_b[strip][edge.hi] -= edge.w_b;
+                        }
+                    },
+                    num_threads);
+                // exclusive scan: each strip's array becomes the difference array at its start
+                for (auto elem = std::size_t{0}; elem != num_elems + 1; ++elem) {
+                    auto run_a = 0;
+                    auto run_b = 0;
+                    for (auto strip = std::size_t{0}; strip != strips; ++strip) {
+                        const auto cur_a = diff_a[strip][elem];
+                        const auto cur_b = diff_b[strip][elem];
+                        diff_a[strip][elem] = run_a;
+                        diff_b[strip][elem] = run_b;
+                        run_a += cur_a;
+                        run_b += cur_b;
+                    }
+                }
+            }
+
+            auto found = std::vector<std::vector<BoundaryEdge<T>>>(strips);
+            parallel_for(
+                0, strips,
+                [&](std::size_t strip) {
+                    auto &cnt_a = diff_a[strip];
+                    auto &cnt_b = diff_b[strip];
+                    for (auto elem = std::size_t{1}; elem < num_elems; ++elem) {
+                        cnt_a[elem] += cnt_a[elem - 1];
+                        cnt_b[elem] += cnt_b[elem - 1];
+                    }
+                    auto tree = CoverTree(gsl::span<const int>(cnt_a.data(), num_elems),
+                                          gsl::span<const int>(cnt_b.data(), num_elems));
+                    auto ranges = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+                    auto before = std::vector<StatusRun>{};
+                    auto after = std::vector<StatusRun>{};
+                    auto &out = found[strip];
+                    for (auto first = cuts[strip]; first != cuts[strip + 1];) {
+                        auto last = first;
+                        ranges.clear();
+                        while (last != cuts[strip + 1] && !(edges[first].pos < edges[last].pos)) {
+                            ranges.emplace_back(edges[last].lo, edges[last].hi);
+                            ++last;
+                        }
+                        // the union of the edge ranges, as disjoint non-touching ranges
+                        std::sort(ranges.begin(), ranges.end());
+                        auto merged = std::size_t{0};
+                        for (const auto &range : ranges) {
+                            if (merged != 0 && range.first <= ranges[merged - 1].second) {
+                                ranges[merged - 1].second
+                                    = std::max(ranges[merged - 1].second, range.second);
+                            } else {
+                                ranges[merged++] = range;
+                            }
+                        }
+                        ranges.resize(merged);
+                        before.clear();
+                        for (const auto &[lo, hi] : ranges) {
+                            tree.runs(lo, hi, op, before);
+                        }
+                        for (auto idx = first; idx != last; ++idx) {
+                            tree.add(edges[idx].lo, edges[idx].hi, edges[idx].w_a, edges[idx].w_b);
+                        }
+                        after.clear();
+                        for (const auto &[lo, hi] : ranges) {
+                            tree.runs(lo, hi, op, after);
+                        }
+                        // both lists cover the same ranges; where the status flips, emit
+                        // maximal runs with the same transition
+                        const auto pos = edges[first].pos;
+                        const auto out_start = out.size();
+                        auto i_before = std::size_t{0};
+                        auto i_after = std::size_t{0};
+                        auto elem = before.empty() ? std::uint32_t{0} : before[0].lo;
+                        while (i_before != before.size() && i_after != after.size()) {
+                            const auto &old_run = before[i_before];
+                            const auto &new_run = after[i_after];
+                            elem = std::max({elem, old_run.lo, new_run.lo});
+                            const auto end = std::min(old_run.hi, new_run.hi);
+                            if (old_run.inside != new_run.inside) {
+                                if (out.size() != out_start && out.back().hi == coords[elem]
+                                    && out.back().entering == new_run.inside) {
+                                    out.back().hi = coords[end];
+                                } else {
+                                    out.push_back(
+                                        {pos, coords[elem], coords[end], new_run.inside});
+                                }
+                            }
+                            elem = end;
+                            if (old_run.hi == end) {
+                                ++i_before;
+                            }
+                            if (new_run.hi == end) {
+                                ++i_after;
+                            }
+                        }
+                        first = last;
+                    }
+                },
+                num_threads);
+
+            auto result = std::vector<BoundaryEdge<T>>{};
+            for (const auto &part : found) {
+                result.insert(result.end(), part.begin(), part.end());
+            }
+            return result;
+        }
+
+        template <typename T> auto compress(std::vector<T> &coords) -> void {
+            std::sort(coords.begin(), coords.end());
+            coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+        }
+
+        template <typename T> auto elem_index(const std::vector<T> &coords, const T &val)
+            -> std::uint32_t {
+            return std::uint32_t(std::lower_bound(coords.begin(), coords.end(), val)
+                                 - coords.begin());
+        }
+
+        template <typename T> struct DirectedEdge {
+            Point<T> start;
+            Point<T> end;
+        };
+
+        template <typename T> auto start_less(const DirectedEdge<T> &lhs,
+                                              const DirectedEdge<T> &rhs) -> bool {
+            return lhs.start < rhs.start;
+        }
+
+        /**
+         * @brief Among the edges starting at `vtx`, pick the one on the left of `dir`.
+         *
+         * Where two result regions touch only at a corner, two edges leave the vertex;
+         * turning left keeps each region's boundary separate.
+         */
+        template <typename T>
+        auto next_edge(const std::vector<DirectedEdge<T>> &edges, const Point<T> &vtx,
+                       const Point<T> &left_of) -> std::size_t {
+            const auto key = DirectedEdge<T>{vtx, vtx};
+            const auto range
+                = std::equal_range(edges.begin(), edges.end(), key, start_less<T>);
+            if (range.first == range.second) {
+                throw std::runtime_error("rpolygon_boolean: open boundary");
+            }
+            const auto sgn = [](const T &val) { return int(T(0) < val) - int(val < T(0)); };
+            const auto want_x = sgn(left_of.xcoord() - vtx.xcoord());
+            const auto want_y = sgn(left_of.ycoord() - vtx.ycoord());
+            auto chosen = range.first;
+            for (auto itr = range.first; itr != range.second; ++itr) {
+                if (sgn(itr->end.xcoord() - vtx.xcoord()) == want_x
+                    && sgn(itr->end.ycoord() - vtx.ycoord()) == want_y) {
+                    chosen = itr;
+                }
+            }
+            return std::size_t(chosen - edges.begin());
+        }
+
+        // point_in_rpolygon at (qx/2, qy/2) for doubled query coordinates, which are in the
+        // accumulator type so that doubling cannot overflow
+        template <typename T>
+        auto contains_doubled(gsl::span<const Point<T>> pointset, accumulator_t<T> q_x,
+                              accumulator_t<T> q_y) -> bool {
+            auto res = false;
+            auto pt0 = pointset.back();
+            for (const auto &pt1 : pointset) {
+                const auto y_0 = 2 * widen(pt0.ycoord());
+                const auto y_1 = 2 * widen(pt1.ycoord());
+                if ((y_1 <= q_y && q_y < y_0) || (y_0 <= q_y && q_y < y_1)) {
+                    if (2 * widen(pt1.xcoord()) > q_x) {
+                        res = !res;
+                    }
+                }
+                pt0 = pt1;
+            }
+            return res;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Boolean operation on two batches of rectilinear polygons
+     *
+     * Each operand is a batch of rectilinear polygons (in the point-list form of
+     * `point_in_rpolygon`, either orientation), and stands for the union of its polygons, so a
+     * whole batch is merged in one pass instead of pairwise. The result is returned as
+     * polygons with holes.
+     *
+     * The engine is a Manhattan scanline. All vertical edges are swept in x over the
+     * elementary y-intervals between consecutive distinct y-coordinates, keeping the
+     * coverage count of both operands per elementary interval; wherever the result of `op`
+     * flips, a vertical result edge is emitted. The horizontal result edges come from the
+     * same sweep in y. Both sweeps are split into strips and run on up to `num_threads`
+     * threads. Finally the directed edges are linked into cycles (anti-clockwise outer
+     * boundaries and clockwise holes) and every hole is assigned, through a `StaticRTree` of
+     * the outer bounding boxes, to the innermost outer boundary containing it.
+     *
+     * Each sweep keeps the coverage counts in a segment tree (`CoverTree`) over the
+     * elementary intervals, so an edge costs O(log n) per change of coverage along it, not
+     * per elementary interval it spans: long rails are no more expensive than short edges.
+     * The cost is O(n log n) plus that of the boundary walk.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Alloc The allocator type of the polygon sets.
+     * @param[in] lhs The first operand.
+     * @param[in] rhs The second operand.
+     * @param[in] op The operation.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::vector<RPolygonWithHoles<T>>
+     */
+    template <typename T, typename Alloc>
+    auto rpolygon_boolean(const PolygonSet<T, Alloc> &lhs, const PolygonSet<T, Alloc> &rhs,
+                          BoolOp op, unsigned num_threads = 1)
+        -> std::vector<RPolygonWithHoles<T>> {
+        RECTI_TIME_SCOPE(rpolygon_boolean);
+        // ---- input edges ----
+        auto xs = std::vector<T>{};
+        auto ys = std::vector<T>{};
+        for (const auto *set : {&lhs, &rhs}) {
+            for (const auto &pt : set->points()) {
+                xs.push_back(pt.xcoord());
+                ys.push_back(pt.ycoord());
+            }
+        }
+        detail::compress(xs);
+        detail::compress(ys);
+
+        auto v_edges = std::vector<detail::ScanEdge<T>>{};
+        auto h_edges = std::vector<detail::ScanEdge<T>>{};
+        for (const auto *set : {&lhs, &rhs}) {
+            const auto is_a = set == &lhs;
+            for (auto poly = std::size_t{0}; poly != set->size(); ++poly) {
+                const auto pts = (*set)[poly];
+                if (pts.size() < 2) {
+                    continue;
+                }
+                // make every polygon count +1 inside, whatever its orientation
+                const auto sign = rpolygon_is_clockwise<T>(pts) ? -1 : 1;
+                for (auto idx = std::size_t{0}; idx != pts.size(); ++idx) {
+                    const auto &pt0 = pts[idx];
+                    const auto &pt1 = pts[idx + 1 == pts.size() ? 0 : idx + 1];
+                    // horizontal edge from pt0 to (pt1.x, pt0.y); crossing it upwards enters
+                    // an anti-clockwise polygon iff it runs east
+                    if (pt0.xcoord() != pt1.xcoord()) {
+                        const auto east = pt0.xcoord() < pt1.xcoord();
+                        const auto wgt = east ? sign : -sign;
+                        const auto [lo, hi] = std::minmax(pt0.xcoord(), pt1.xcoord());
+                        h_edges.push_back({pt0.ycoord(), detail::elem_index(xs, lo),
+                                           detail::elem_index(xs, hi), is_a ? wgt : 0,
+                                           is_a ? 0 : wgt});
+                    }
+                    // vertical edge from (pt1.x, pt0.y) to pt1; crossing it eastwards enters
+                    // an anti-clockwise polygon iff it runs south
+                    if (pt0.ycoord() != pt1.ycoord()) {
+                        const auto south = pt1.ycoord() < pt0.ycoord();
+                        const auto wgt = south ? sign : -sign;
+                        const auto [lo, hi] = std::minmax(pt0.ycoord(), pt1.ycoord());
+                        v_edges.push_back({pt1.xcoord(), detail::elem_index(ys, lo),
+                                           detail::elem_index(ys, hi), is_a ? wgt : 0,
+                                           is_a ? 0 : wgt});
+                    }
+                }
+            }
+        }
+
+        // ---- scanlines ----
+        const auto v_bound = detail::boolean_scan<T>(v_edges, ys, op, num_threads);
+        const auto h_bound = detail::boolean_scan<T>(h_edges, xs, op, num_threads);
+
+        // ---- directed result edges, interior on the left ----
+        using Edge = detail::DirectedEdge<T>;
+        auto v_dir = std::vector<Edge>{};
+        auto h_dir = std::vector<Edge>{};
+        v_dir.reserve(v_bound.size());
+        h_dir.reserve(h_bound.size());
+        for (const auto &bnd : v_bound) {  // entered eastwards: runs south
+            const auto low = Point<T>{bnd.pos, bnd.lo};
+            const auto high = Point<T>{bnd.pos, bnd.hi};
+            v_dir.push_back(bnd.entering ? Edge{high, low} : Edge{low, high});
+        }
+        for (const auto &bnd : h_bound) {  // entered northwards: runs east
+            const auto low = Point<T>{bnd.lo, bnd.pos};
+            const auto high = Point<T>{bnd.hi, bnd.pos};
+            h_dir.push_back(bnd.entering ? Edge{low, high} : Edge{high, low});
+        }
+        std::sort(v_dir.begin(), v_dir.end(), detail::start_less<T>);
+        std::sort(h_dir.begin(), h_dir.end(), detail::start_less<T>);
+
+        // ---- link into cycles ----
+        auto left_of = [](const Edge &edge) {  // a point on the left of the edge's end
+            const auto d_x = edge.end.xcoord() - edge.start.xcoord();
+            const auto d_y = edge.end.ycoord() - edge.start.ycoord();
+            const auto s_x = d_x > 0 ? 1 : (d_x < 0 ? -1 : 0);
+            const auto s_y = d_y > 0 ? 1 : (d_y < 0 ? -1 : 0);
+            return Point<T>{T(edge.end.xcoord() - s_y), T(edge.end.ycoord() + s_x)};
+        };
+        auto used = std::vector<char>(h_dir.size(), 0);
+        auto outers = std::vector<std::vector<Point<T>>>{};
+        auto holes = std::vector<std::vector<Point<T>>>{};
+        for (auto first = std::size_t{0}; first != h_dir.size(); ++first) {
+            if (used[first] != 0) {
+                continue;
+            }
+            auto cycle = std::vector<Point<T>>{};
+            auto cur = first;
+            do {
+                used[cur] = 1;
+                cycle.push_back(h_dir[cur].start);
+                const auto &vert
+                    = v_dir[detail::next_edge(v_dir, h_dir[cur].end, left_of(h_dir[cur]))];
+                cur = detail::next_edge(h_dir, vert.end, left_of(vert));
+            } while (cur != first);
+            if (rpolygon_is_clockwise<T>(cycle)) {
+                holes.push_back(std::move(cycle));
+            } else {
+                outers.push_back(std::move(cycle));
+            }
+        }
+
+        // ---- assign the holes ----
+        auto result = std::vector<RPolygonWithHoles<T>>(outers.size());
+        auto boxes = std::vector<Rectangle<T>>{};
+        auto areas = std::vector<accumulator_t<T>>{};
+        for (auto idx = std::size_t{0}; idx != outers.size(); ++idx) {
+            auto x_ivl = Interval<T>{outers[idx][0].xcoord(), outers[idx][0].xcoord()};
+            auto y_ivl = Interval<T>{outers[idx][0].ycoord(), outers[idx][0].ycoord()};
+            for (const auto &pt : outers[idx]) {
+                x_ivl = x_ivl.hull_with(pt.xcoord());
+                y_ivl = y_ivl.hull_with(pt.ycoord());
+            }
+            boxes.emplace_back(x_ivl, y_ivl);
+            areas.push_back(RPolygon<T>(outers[idx]).signed_area());
+            result[idx].outer = std::move(outers[idx]);
+        }
+        const auto rtree = StaticRTree<T>(boxes);
+        for (auto &hole : holes) {
+            // a point half a unit off the first edge, on the inside of the result
+            const auto east = hole[0].xcoord() < hole[1 % hole.size()].xcoord();
+            const auto q_x = 2 * widen(hole[0].xcoord()) + (east ? 1 : -1);
+            const auto q_y = 2 * widen(hole[0].ycoord()) + (east ? 1 : -1);
+            auto owner = ~std::size_t{0};
+            for (const auto cand : rtree.query(hole[0])) {
+                if ((owner == ~std::size_t{0} || areas[cand] < areas[owner])
+                    && detail::contains_doubled<T>(result[cand].outer, q_x, q_y)) {
+                    owner = cand;
+                }
+            }
+            assert(owner != ~std::size_t{0});
+            result[owner].holes.push_back(std::move(hole));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Union of a batch of rectilinear polygons.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Alloc The allocator type of the polygon set.
+     * @param[in] polys The polygons.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::vector<RPolygonWithHoles<T>>
+     */
+    template <typename T, typename Alloc>
+    auto rpolygon_union(const PolygonSet<T, Alloc> &polys, unsigned num_threads = 1)
+        -> std::vector<RPolygonWithHoles<T>> {
+        return rpolygon_boolean(polys, PolygonSet<T, Alloc>(polys.get_allocator()), BoolOp::Union,
+                                num_threads);
+    }
+
+    /**
+     * @brief Intersection of the unions of two batches of rectilinear polygons.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Alloc The allocator type of the polygon sets.
+     * @param[in] lhs The first operand.
+     * @param[in] rhs The second operand.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::vector<RPolygonWithHoles<T>>
+     */
+    template <typename T, typename Alloc>
+    auto rpolygon_intersection(const PolygonSet<T, Alloc> &lhs, const PolygonSet<T, Alloc> &rhs,
+                               unsigned num_threads = 1) -> std::vector<RPolygonWithHoles<T>> {
+        return rpolygon_boolean(lhs, rhs, BoolOp::Intersection, num_threads);
+    }
+
+    /**
+     * @brief Difference of the unions of two batches of rectilinear polygons.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Alloc The allocator type of the polygon sets.
+     * @param[in] lhs The first operand.
+     * @param[in] rhs The second operand (subtracted).
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::vector<RPolygonWithHoles<T>>
+     */
+    template <typename T, typename Alloc>
+    auto rpolygon_difference(const PolygonSet<T, Alloc> &lhs, const PolygonSet<T, Alloc> &rhs,
+                             unsigned num_threads = 1) -> std::vector<RPolygonWithHoles<T>> {
+        return rpolygon_boolean(lhs, rhs, BoolOp::Difference, num_threads);
+    }
+
+}  // namespace recti
@@ -0,0 +1,559 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::lower_bound, std::unique
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <gsl/span>
+#include <iterator>  // for std::prev
+#include <map>       // for std::map
+#include <utility>   // for std::pair
+#include <vector>
+
+#include "rectangle_set.hpp"
+#include "recti.hpp"
+#include "rpolygon_boolean.hpp"
+
+namespace recti {
+
+    /**
+     * @brief The decomposition modes of `decompose_rpolygon`.
+     *
+     * - `Slab`: cut at every vertex y-coordinate, merging equal pieces of consecutive slabs.
+     *   Fast, but not minimum.
+     * - `Minimum`: a partition into the minimum number of rectangles.
+     */
+    enum class DecompositionMode { Slab, Minimum };
+
+    namespace detail {
+        template <typename T> struct VerticalEdge {
+            T x_pos;
+            T y_lo;
+            T y_hi;
+        };
+
+        /**
+         * @brief Sweep the horizontal slabs of a set of boundary cycles (outer boundaries and
+         * holes alike, parity rule) bottom-up.
+         *
+         * `fn(y_lo, y_hi, crossings)` is called for each slab with the sorted x-coordinates of
+         * the vertical edges crossing it; the inside is between crossings 0 and 1, 2 and 3, ...
+         *
+         * The crossings are kept in a sorted vector, so an edge event costs O(k) for k active
+         * edges, within the O(k) of handing the slab to `fn`. It serves the `Minimum` mode,
+         * which fills a grid cell by cell anyway; the `Slab` mode uses `decompose_slab`.
+         */
+        template <typename T, typename Fn>
+        auto for_each_slab(gsl::span<const gsl::span<const Point<T>>> cycles, Fn &&fn) -> void {
+            auto edges = std::vector<VerticalEdge<T>>{};
+            for (const auto &pts : cycles) {
+                auto pt0 = pts.back();
+                for (const auto &pt1 : pts) {
+                    if (pt0.ycoord() != pt1.ycoord()) {
+                        const auto [y_lo, y_hi] = std::minmax(pt0.ycoord(), pt1.ycoord());
+                        edges.push_back({pt1.xcoord(), y_lo, y_hi});
+                    }
+                    pt0 = pt1;
+                }
+            }
+            if (edges.empty()) {
+                return;
+            }
+            auto by_hi = edges;
+            std::sort(edges.begin(), edges.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.y_lo < rhs.y_lo; });
+            std::sort(by_hi.begin(), by_hi.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.y_hi < rhs.y_hi; });
+            auto active = std::vector<T>{};
+            auto next_in = edges.begin();
+            auto next_out = by_hi.begin();
+            auto y_cur = edges.front().y_lo;
+            while (next_out != by_hi.end()) {
+                while (next_out != by_hi.end() && !(y_cur < next_out->y_hi)) {
+                    active.erase(std::lower_bound(active.begin(), active.end(), next_out->x_pos));
+                    ++next_out;
+                }
+                while (next_in != edges.end() && !(y_cur < next_in->y_lo)) {
+                    active.insert(std::upper_bound(active.begin(), active.end(), next_in->x_pos),
+                                  next_in->x_pos);
+                    ++next_in;
+                }
+                if (next_out == by_hi.end()) {
+                    break;
+                }
+                auto y_next = next_out->y_hi;
+                if (next_in != edges.end() && next_in->y_lo < y_next) {
+                    y_next = next_in->y_lo;
+                }
+                if (!active.empty()) {
+                    fn(y_cur, y_next, gsl::span<const T>(active));
+                }
+                y_cur = y_next;
+            }
+        }
+
+        template <typename T> struct HorizontalEdge {
+            T y_pos;
+            T x_lo;
+            T x_hi;
+        };
+
+        /**
+         * @brief Slab decomposition by a sweep over the horizontal edges, bottom-up.
+         *
+         * The inside of the current slab is kept as an ordered map of disjoint, non-touching
+         * x-intervals (the open pieces). Under the parity rule, a horizontal edge at `y`
+         * toggles the inside of its x-range above `y`, so it only closes the pieces it
+         * overlaps or touches and opens their replacements: O(log n) plus those pieces. A
+         * piece closed at `y` and reopened with the same x-extent in the same row continues,
+         * so each rectangle spans all consecutive slabs in which its extent is unchanged.
+         */
+        template <typename T, typename Emit>
+        auto decompose_slab(gsl::span<const gsl::span<const Point<T>>> cycles, Emit &emit)
+            -> void {
+            auto edges = std::vector<HorizontalEdge<T>>{};
+            for (const auto &pts : cycles) {
+                auto pt0 = pts.back();
+                for (const auto &pt1 : pts) {  // the edge from `pt0` runs along y = pt0.y
+                    if (pt0.xcoord() != pt1.xcoord()) {
+                        const auto [x_lo, x_hi] = std::minmax(pt0.xcoord(), pt1.xcoord());
+                        edges.push_back({pt0.ycoord(), x_lo, x_hi});
+                    }
+                    pt0 = pt1;
+                }
+            }
+            std::sort(edges.begin(), edges.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.y_pos < rhs.y_pos; });
+
+            struct Piece {
+                T x_hi;
+                T y_lo;
+            };
+            auto open = std::map<T, Piece>{};              // keyed by x_lo
+            auto closing = std::map<std::pair<T, T>, T>{};  // ended in this row: extent -> y_lo
+            auto bounds = std::vector<T>{};
+            auto toggle = [&](const T &x_lo, const T &x_hi, const T &y_pos) {
+                auto first = open.upper_bound(x_lo);
+                if (first != open.begin() && !(std::prev(first)->second.x_hi < x_lo)) {
+                    --first;
+                }
+                auto last = first;
+                bounds.assign({x_lo, x_hi});
+                for (; last != open.end() && !(x_hi < last->first); ++last) {
+                    bounds.push_back(last->first);
+                    bounds.push_back(last->second.x_hi);
+                    if (last->second.y_lo < y_pos) {  // else opened in this row: no height
+                        closing.emplace(std::pair{last->first, last->second.x_hi},
+                                        last->second.y_lo);
+                    }
+                }
+                open.erase(first, last);
+                // each bound toggles the inside; the runs covered an odd number of times remain
+                std::sort(bounds.begin(), bounds.end());
+                auto run_lo = T{};
+                auto inside = false;
+                for (auto idx = std::size_t{0}; idx != bounds.size();) {
+                    const auto pos = bounds[idx];
+                    auto flips = false;
+                    for (; idx != bounds.size() && !(pos < bounds[idx]); ++idx) {
+                        flips = !flips;
+                    }
+                    if (!flips) {
+                        continue;
+                    }
+                    inside = !inside;
+                    if (inside) {
+                        run_lo = pos;
+                        continue;
+                    }
+                    auto y_lo = y_pos;
+                    const auto reopened = closing.find(std::pair{run_lo, pos});
+                    if (reopened != closing.end()) {
+                        y_lo = reopened->second;
+                        closing.erase(reopened);
+                    }
+                    open.emplace_hint(last, run_lo, Piece{pos, y_lo});
+                }
+            };
+            for (auto itr = edges.begin(); itr != edges.end();) {
+                const auto y_pos = itr->y_pos;
+                for (; itr != edges.end() && !(y_pos < itr->y_pos); ++itr) {
+                    toggle(itr->x_lo, itr->x_hi, y_pos);
+                }
+                for (const auto &[extent, y_lo] : closing) {
+                    emit(Rectangle<T>{{extent.first, extent.second}, {y_lo, y_pos}});
+                }
+                closing.clear();
+            }
+        }
+
+        /**
+         * @brief Kuhn's augmenting-path bipartite matching, one augmenting path from `root`.
+         *
+         * The depth-first search keeps its frames (a left vertex and the position of the next
+         * edge to try) in `stack` instead of recursing, so long paths cannot overflow the
+         * call stack. On success, the frames hold the path.
+         */
+        inline auto try_augment(std::size_t root, const std::vector<std::vector<std::size_t>> &adj,
+                                std::vector<std::size_t> &match_right, std::vector<char> &seen,
+                                std::vector<std::pair<std::size_t, std::size_t>> &stack)
+            -> bool {
+            stack.assign(1, {root, 0});
+            while (!stack.empty()) {
+                const auto left = stack.back().first;
+                if (stack.back().second == adj[left].size()) {
+                    stack.pop_back();
+                    continue;
+                }
+                const auto right = adj[left][stack.back().second++];
+                if (seen[right] != 0) {
+                    continue;
+                }
+                seen[right] = 1;
+                if (match_right[right] == ~std::size_t{0}) {
+                    // each frame's last tried edge is on the path
+                    for (const auto &[node, next] : stack) {
+                        match_right[adj[node][next - 1]] = node;
+                    }
+                    return true;
+                }
+                stack.emplace_back(match_right[right], 0);
+            }
+            return false;
+        }
+
+        template <typename T, typename Emit>
+        auto decompose_minimum(gsl::span<const gsl::span<const Point<T>>> cycles, Emit &emit)
+            -> void {
+            // ---- compressed grid and inside cells ----
+            auto xs = std::vector<T>{};
+            auto ys = std::vector<T>{};
+            for (const auto &pts : cycles) {
+                for (const auto &pt : pts) {
+                    xs.push_back(pt.xcoord());
+                    ys.push_back(pt.ycoord());
+                }
+            }
+            compress(xs);
+            compress(ys);
+            if (xs.size() < 2 || ys.size() < 2) {
+                return;
+            }
+            const auto cols = xs.size() - 1;
+            const auto rows = ys.size() - 1;
+            auto inside_cells = std::vector<char>(cols * rows, 0);
+            auto fill = [&](const T &y_lo, const T &y_hi, gsl::span<const T> crossings) {
+                for (auto row = std::size_t(elem_index(ys, y_lo)); row != elem_index(ys, y_hi);
+                     ++row) {
+                    for (auto idx = std::size_t{0}; idx + 1 < crossings.size(); idx += 2) {
+                        const auto first = elem_index(xs, crossings[idx]);
+                        const auto last = elem_index(xs, crossings[idx + 1]);
+                        for (auto col = first; col < last; ++col) {
+                            inside_cells[row * cols + col] = 1;
+                        }
+                    }
+                }
+            };
+            for_each_slab<T>(cycles, fill);
+            auto inside = [&](std::size_t col, std::size_t row) {  // (col, row) may be -1
+                return col < cols && row < rows && inside_cells[row * cols + col] != 0;
+            };
+
+            // walls: v_wall on line x = xs[i] between ys[j], ys[j+1]; h_wall likewise
+            auto v_wall = std::vector<char>((cols + 1) * rows, 0);
+            auto h_wall = std::vector<char>(cols * (rows + 1), 0);
+            auto vw = [&](std::size_t col, std::size_t row) -> char & {
+                return v_wall[row * (cols + 1) + col];
+            };
+            auto hw = [&](std::size_t col, std::size_t row) -> char & {
+                return h_wall[row * cols + col];
+            };
+            for (auto row = std::size_t{0}; row != rows; ++row) {
+                for (auto col = std::size_t{0}; col != cols + 1; ++col) {
+                    vw(col, row) = char(inside(col - 1, row) != inside(col, row));
+                }
+            }
+            for (auto row = std::size_t{0}; row != rows + 1; ++row) {
+                for (auto col = std::size_t{0}; col != cols; ++col) {
+                    hw(col, row) = char(inside(col, row - 1) != inside(col, row));
+                }
+            }
+            // is there a vertical (horizontal) wall at grid point (i, j)?
+            auto v_wall_at = [&](std::size_t col, std::size_t row) {
+                return (row != 0 && vw(col, row - 1) != 0) || (row != rows && vw(col, row) != 0);
+            };
+            auto h_wall_at = [&](std::size_t col, std::size_t row) {
+                return (col != 0 && hw(col - 1, row) != 0) || (col != cols && hw(col, row) != 0);
+            };
+
+            // ---- reflex vertices: three of the four cells around a grid point inside ----
+            struct Reflex {
+                std::size_t col;
+                std::size_t row;
+                int d_x;  // the direction in which the horizontal cut leaves the vertex
+                int d_y;  // likewise for the vertical cut
+            };
+            auto reflex = std::vector<Reflex>{};
+            auto reflex_at = std::vector<std::size_t>((cols + 1) * (rows + 1), ~std::size_t{0});
+            for (auto row = std::size_t{1}; row != rows; ++row) {
+                for (auto col = std::size_t{1}; col != cols; ++col) {
+                    const auto s_w = inside(col - 1, row - 1);
+                    const auto s_e = inside(col, row - 1);
+                    const auto n_w = inside(col - 1, row);
+                    const auto n_e = inside(col, row);
+                    if (int(s_w) + int(s_e) + int(n_w) + int(n_e) != 3) {
+                        continue;
+                    }
+                    reflex_at[row * (cols + 1) + col] = reflex.size();
+                    reflex.push_back({col, row, (s_w && n_w) ? -1 : 1, (s_w && s_e) ? -1 : 1});
+                }
+            }
+            auto reflex_index = [&](std::size_t col, std::size_t row) {
+                return reflex_at[row * (cols + 1) + col];
+            };
+
+            // ---- good chords: interior segments joining two facing reflex vertices ----
+            struct Chord {
+                std::size_t from;  // reflex indices
+                std::size_t to;
+                std::size_t line;  // the row (horizontal chord) or column (vertical chord)
+                std::size_t lo;    // grid range along the line
+                std::size_t hi;
+            };
+            auto h_chords = std::vector<Chord>{};
+            auto v_chords = std::vector<Chord>{};
+            for (auto idx = std::size_t{0}; idx != reflex.size(); ++idx) {
+                const auto &rfx = reflex[idx];
+                if (rfx.d_x > 0) {
+                    auto col = rfx.col;
+                    while (col < cols && inside(col, rfx.row - 1) && inside(col, rfx.row)) {
+                        ++col;
+                        if (v_wall_at(col, rfx.row)) {
+                            break;
+                        }
+                    }
+                    const auto other = col <= cols ? reflex_index(col, rfx.row) : ~std::size_t{0};
+                    if (col != rfx.col && other != ~std::size_t{0} && reflex[other].d_x < 0) {
+                        h_chords.push_back({idx, other, rfx.row, rfx.col, col});
+                    }
+                }
+                if (rfx.d_y > 0) {
+                    auto row = rfx.row;
+                    while (row < rows && inside(rfx.col - 1, row) && inside(rfx.col, row)) {
+                        ++row;
+                        if (h_wall_at(rfx.col, row)) {
+                            break;
+                        }
+                    }
+                    const auto other = row <= rows ? reflex_index(rfx.col, row) : ~std::size_t{0};
+                    if (row != rfx.row && other != ~std::size_t{0} && reflex[other].d_y < 0) {
+                        v_chords.push_back({idx, other, rfx.col, rfx.row, row});
+                    }
+                }
+            }
+
+            // ---- maximum set of non-intersecting good chords (Koenig's theorem) ----
+            auto adj = std::vector<std::vector<std::size_t>>(h_chords.size());
+            for (auto h_i = std::size_t{0}; h_i != h_chords.size(); ++h_i) {
+                const auto &hor = h_chords[h_i];
+                for (auto v_i = std::size_t{0}; v_i != v_chords.size(); ++v_i) {
+                    const auto &ver = v_chords[v_i];
+                    if (hor.lo <= ver.line && ver.line <= hor.hi && ver.lo <= hor.line
+                        && hor.line <= ver.hi) {
+                        adj[h_i].push_back(v_i);
+                    }
+                }
+            }
+            auto match_right = std::vector<std::size_t>(v_chords.size(), ~std::size_t{0});
+            auto match_left = std::vector<std::size_t>(h_chords.size(), ~std::size_t{0});
+            auto seen = std::vector<char>{};
+            auto path = std::vector<std::pair<std::size_t, std::size_t>>{};
+            for (auto h_i = std::size_t{0}; h_i != h_chords.size(); ++h_i) {
+                seen.assign(v_chords.size(), 0);
+                try_augment(h_i, adj, match_right, seen, path);
+            }
+            for (auto v_i = std::size_t{0}; v_i != v_chords.size(); ++v_i) {
+                if (match_right[v_i] != ~std::size_t{0}) {
+                    match_left[match_right[v_i]] = v_i;
+                }
+            }
+            // alternating reachability from the unmatched horizontal chords
+            auto reach_left = std::vector<char>(h_chords.size(), 0);
+            auto reach_right = std::vector<char>(v_chords.size(), 0);
+            auto stack = std::vector<std::size_t>{};
+            for (auto h_i = std::size_t{0}; h_i != h_chords.size(); ++h_i) {
+                if (match_left[h_i] == ~std::size_t{0}) {
+                    reach_left[h_i] = 1;
+                    stack.push_back(h_i);
+                }
+            }
+            while (!stack.empty()) {
+                const auto h_i = stack.back();
+                stack.pop_back();
+                for (const auto v_i : adj[h_i]) {
+                    if (reach_right[v_i] != 0) {
+                        continue;
+                    }
+                    reach_right[v_i] = 1;
+                    const auto next = match_right[v_i];
+                    if (next != ~std::size_t{0} && reach_left[next] == 0) {
+                        reach_left[next] = 1;
+                        stack.push_back(next);
+                    }
+                }
+            }
+
+            auto resolved = std::vector<char>(reflex.size(), 0);
+            for (auto h_i = std::size_t{0}; h_i != h_chords.size(); ++h_i) {
+                if (reach_left[h_i] != 0) {  // in the maximum independent set
+                    const auto &hor = h_chords[h_i];
+                    for (auto col = hor.lo; col != hor.hi; ++col) {
+                        hw(col, hor.line) = 1;
+                    }
+                    resolved[hor.from] = resolved[hor.to] = 1;
+                }
+            }
+            for (auto v_i = std::size_t{0}; v_i != v_chords.size(); ++v_i) {
+                if (reach_right[v_i] == 0) {
+                    const auto &ver = v_chords[v_i];
+                    for (auto row = ver.lo; row != ver.hi; ++row) {
+                        vw(ver.line, row) = 1;
+                    }
+                    resolved[ver.from] = resolved[ver.to] = 1;
+                }
+            }
+
+            // ---- cut every remaining reflex vertex horizontally up to the first wall ----
+            for (auto idx = std::size_t{0}; idx != reflex.size(); ++idx) {
+                if (resolved[idx] != 0) {
+                    continue;
+                }
+                const auto &rfx = reflex[idx];
+                auto col = rfx.col;
+                for (;;) {
+                    auto &seg = hw(rfx.d_x > 0 ? col : col - 1, rfx.row);
+                    if (seg != 0) {
+                        break;  // runs into a collinear cut
+                    }
+                    seg = 1;
+                    col = rfx.d_x > 0 ? col + 1 : col - 1;
+                    if (v_wall_at(col, rfx.row)) {
+                        break;
+                    }
+                }
+            }
+
+            // ---- the faces are now rectangles ----
+            auto done = std::vector<char>(cols * rows, 0);
+            for (auto row = std::size_t{0}; row != rows; ++row) {
+                for (auto col = std::size_t{0}; col != cols; ++col) {
+                    if (!inside(col, row) || done[row * cols + col] != 0) {
+                        continue;
+                    }
+                    auto col_end = col + 1;
+                    while (col_end != cols && vw(col_end, row) == 0) {
+                        ++col_end;
+                    }
+                    auto row_end = row + 1;
+                    while (row_end != rows && hw(col, row_end) == 0) {
+                        ++row_end;
+                    }
+                    for (auto r_i = row; r_i != row_end; ++r_i) {
+                        for (auto c_i = col; c_i != col_end; ++c_i) {
+                            assert(done[r_i * cols + c_i] == 0);
+                            done[r_i * cols + c_i] = 1;
+                        }
+                    }
+                    emit(Rectangle<T>{{xs[col], xs[col_end]}, {ys[row], ys[row_end]}});
+                }
+            }
+        }
+
+        template <typename T, typename Emit>
+        auto decompose(gsl::span<const gsl::span<const Point<T>>> cycles, DecompositionMode mode,
+                       Emit &&emit) -> void {
+            if (mode == DecompositionMode::Slab) {
+                decompose_slab<T>(cycles, emit);
+            } else {
+                decompose_minimum<T>(cycles, emit);
+            }
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Decompose a rectilinear polygon into non-overlapping rectangles.
+     *
+     * The polygon is given in the point-list form of `RPolygon` and `point_in_rpolygon`. The
+     * rectangles are appended to `out`, whose capacity is reused across calls.
+     *
+     * - `DecompositionMode::Slab` sweeps the horizontal edges bottom-up, keeping the inside
+     *   of the current slab as an ordered map of x-intervals that each edge toggles, and
+     *   merges a piece with the one below it when they have the same x-extent.
+     *   O((n + r) log n) for `r` rectangles.
+     * - `DecompositionMode::Minimum` computes a partition into the fewest rectangles:
+     *   the maximum set of non-intersecting chords between pairs of facing reflex vertices
+     *   is found by bipartite matching (Koenig's theorem), those chords are cut, and every
+     *   remaining reflex vertex is cut horizontally. It works on the compressed grid of the
+     *   vertex coordinates, so the cost grows with the product of distinct x- and
+     *   y-coordinates; use it for output-size-sensitive flows, not for throughput.
+     *
+     * @tparam T The coordinate type.
+     * @param[in] pointset The points defining the rectilinear polygon.
+     * @param[in,out] out The rectangles are appended here.
+     * @param[in] mode The decomposition mode.
+     * @return The number of rectangles appended.
+     */
+    template <typename T>
+    auto decompose_rpolygon(gsl::span<const Point<T>> pointset, std::vector<Rectangle<T>> &out,
+                            DecompositionMode mode = DecompositionMode::Slab) -> std::size_t {
+        const auto before = out.size();
+        const gsl::span<const Point<T>> cycles[] = {pointset};
+        detail::decompose<T>(cycles, mode, [&out](const Rectangle<T> &rect) {
+            out.push_back(rect);
+        });
+        return out.size() - before;
+    }
+
+    /**
+     * @brief Decompose a rectilinear polygon into rectangles appended to a `RectangleSet`.
+     *
+     * @tparam T The coordinate type.
+     * @param[in] pointset The points defining the rectilinear polygon.
+     * @param[in,out] out The rectangles are appended here.
+     * @param[in] mode The decomposition mode.
+     * @return The number of rectangles appended.
+     */
+    template <typename T>
+    auto decompose_rpolygon(gsl::span<const Point<T>> pointset, RectangleSet<T> &out,
+                            DecompositionMode mode = DecompositionMode::Slab) -> std::size_t {
+        const auto before = out.size();
+        const gsl::span<const Point<T>> cycles[] = {pointset};
+        detail::decompose<T>(cycles, mode, [&out](const Rectangle<T> &rect) {
+            out.push_back(rect);
+        });
+        return out.size() - before;
+    }
+
+    /**
+     * @brief Decompose a rectilinear polygon with holes (e.g. a `rpolygon_boolean` result)
+     * into non-overlapping rectangles.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Out `std::vector<Rectangle<T>>` or `RectangleSet<T>`.
+     * @param[in] poly The polygon with holes.
+     * @param[in,out] out The rectangles are appended here.
+     * @param[in] mode The decomposition mode.
+     * @return The number of rectangles appended.
+     */
+    template <typename T, typename Out>
+    auto decompose_rpolygon(const RPolygonWithHoles<T> &poly, Out &out,
+                            DecompositionMode mode = DecompositionMode::Slab) -> std::size_t {
+        const auto before = out.size();
+        auto cycles = std::vector<gsl::span<const Point<T>>>{poly.outer};
+        cycles.insert(cycles.end(), poly.holes.begin(), poly.holes.end());
+        detail::decompose<T>(cycles, mode, [&out](const Rectangle<T> &rect) {
+            out.push_back(rect);
+        });
+        return out.size() - before;
+    }
+
+}  // namespace recti
@@ -0,0 +1,584 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::min, std::max, std::unique
+#include <cassert>    // for assert
+#include <cstddef>    // for std::size_t
+#include <gsl/span>
+#include <map>          // for std::map
+#include <numeric>      // for std::iota
+#include <tuple>        // for std::tuple
+#include <type_traits>  // for std::is_signed_v
+#include <utility>      // for std::pair, std::swap
+#include <vector>
+
+#include "parallel.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @brief The construction modes of `rectilinear_steiner_tree`.
+     *
+     * - `Fast`: the O(n log n) rectilinear MST, refined by edge substitution.
+     * - `OneSteiner`: iterated 1-Steiner over the Hanan grid. A little shorter, but about
+     *   O(n^4) per round, so only worth it for small nets where quality matters.
+     */
+    enum class SteinerMode { Fast, OneSteiner };
+
+    /**
+     * @brief Rectilinear Steiner tree
+     *
+     * The tree spans `nodes`, whose first `num_pins` entries are the pins of the net (in the
+     * given order) and the rest are Steiner points. Each edge is a pair of node indices and is
+     * routed with an L-shape, so its length is the Manhattan distance between its ends.
+     *
+     * @tparam T The coordinate type.
+     */
+    template <typename T> struct SteinerTree {
+        std::vector<Point<T>> nodes{};
+        std::vector<std::pair<std::size_t, std::size_t>> edges{};
+        std::size_t num_pins{0};
+
+        /**
+         * @brief The total Manhattan length of the edges.
+         *
+         * @return T
+         */
+        auto wirelength() const -> T {
+            auto total = T(0);
+            for (const auto &[src, dst] : this->edges) {
+                total += min_dist(this->nodes[src], this->nodes[dst]);
+            }
+            return total;
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Disjoint sets with path halving (for Kruskal).
+         */
+        class DisjointSets {
+            std::vector<std::size_t> _parent;
+
+          public:
+            explicit DisjointSets(std::size_t num) : _parent(num) {
+                std::iota(this->_parent.begin(), this->_parent.end(), std::size_t{0});
+            }
+
+            auto find(std::size_t idx) -> std::size_t {
+                while (this->_parent[idx] != idx) {
+                    idx = this->_parent[idx] = this->_parent[this->_parent[idx]];
+                }
+                return idx;
+            }
+
+            auto unite(std::size_t lhs, std::size_t rhs) -> bool {
+                lhs = this->find(lhs);
+                rhs = this->find(rhs);
+                if (lhs == rhs) {
+                    return false;
+                }
+                this->_parent[std::max(lhs, rhs)] = std::min(lhs, rhs);
+                return true;
+            }
+        };
+
+        /**
+         * @brief Half-perimeter of the bounding box, the exact RSMT length of up to 3 pins.
+         */
+        template <typename T> auto half_perimeter(gsl::span<const Point<T>> pins) -> T {
+            auto x_min = pins[0].xcoord(), x_max = x_min;
+            auto y_min = pins[0].ycoord(), y_max = y_min;
+            for (const auto &pin : pins) {
+                x_min = std::min(x_min, pin.xcoord());
+                x_max = std::max(x_max, pin.xcoord());
+                y_min = std::min(y_min, pin.ycoord());
+                y_max = std::max(y_max, pin.ycoord());
+            }
+            return (x_max - x_min) + (y_max - y_min);
+        }
+
+        /**
+         * @brief The coordinate-wise median, the optimal Steiner point of three pins.
+         */
+        template <typename T>
+        auto median_point(const Point<T> &pt_a, const Point<T> &pt_b, const Point<T> &pt_c)
+            -> Point<T> {
+            auto median = [](const T &val_a, const T &val_b, const T &val_c) -> T {
+                return std::max(std::min(val_a, val_b), std::min(std::max(val_a, val_b), val_c));
+            };
+            return Point<T>{median(pt_a.xcoord(), pt_b.xcoord(), pt_c.xcoord()),
+                            median(pt_a.ycoord(), pt_b.ycoord(), pt_c.ycoord())};
+        }
+
+        /**
+         * @brief Candidate edges of the rectilinear MST (at most 4n), by four octant sweeps.
+         *
+         * In each sweep the points are visited in increasing `x + y`; an ordered map keyed on
+         * `-y` holds the points still waiting for their nearest neighbour in one octant, and
+         * every visited point settles the waiting points of whose octant it is the nearest.
+         * Between the sweeps the coordinates are reflected, so that the four sweeps cover the
+         * eight octants (each edge is undirected). O(n log n).
+         *
+         * Reference:
+         *  - H. Zhou, N. Shenoy and W. Nicholls, "Efficient minimum spanning tree construction
+         * without Delaunay triangulation," Information Processing Letters, 81(5), 2002.
+         */
+        template <typename T> auto mst_candidate_edges(gsl::span<const Point<T>> pins)
+            -> std::vector<std::tuple<T, std::size_t, std::size_t>> {
+            static_assert(std::is_signed_v<T>, "the octant sweep reflects the coordinates");
+            auto coords = std::vector<std::pair<T, T>>{};
+            coords.reserve(pins.size());
+            for (const auto &pin : pins) {
+                coords.emplace_back(pin.xcoord(), pin.ycoord());
+            }
+            auto order = std::vector<std::size_t>(pins.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            auto edges = std::vector<std::tuple<T, std::size_t, std::size_t>>{};
+            edges.reserve(4 * pins.size());
+            auto waiting = std::map<T, std::size_t>{};
+            for (auto sweep = 0; sweep != 4; ++sweep) {
+                std::sort(order.begin(), order.end(), [&coords](std::size_t lhs, std::size_t rhs) {
+                    return coords[lhs].first + coords[lhs].second
+                           < coords[rhs].first + coords[rhs].second;
+                });
+                waiting.clear();
+                for (const auto idx : order) {
+                    const auto &[x_i, y_i] = coords[idx];
+                    for (auto iter = waiting.lower_bound(-y_i); iter != waiting.end();) {
+                        const auto other = iter->second;
+                        const auto d_x = x_i - coords[other].first;
+                        const auto d_y = y_i - coords[other].second;
+                        if (d_y > d_x) {
+                            break;
+                        }
+                        edges.emplace_back(d_x + d_y, idx, other);
+                        iter = waiting.erase(iter);
+                    }
+                    waiting[-y_i] = idx;
+                }
+                for (auto &[x_i, y_i] : coords) {
+                    if (sweep % 2 == 0) {
+                        std::swap(x_i, y_i);
+                    } else {
+                        x_i = -x_i;
+                    }
+                }
+            }
+            return edges;
+        }
+
+        /**
+         * @brief Dense Prim over a few nodes: O(k^2).
+         *
+         * @return the MST length; the tree edges are appended to `edges` when it is not null.
+         */
+        template <typename T>
+        auto prim_length(gsl::span<const Point<T>> nodes,
+                         std::vector<std::pair<std::size_t, std::size_t>> *edges = nullptr) -> T {
+            auto dist = std::vector<T>(nodes.size());
+            auto from = std::vector<std::size_t>(nodes.size());
+            auto done = std::vector<char>(nodes.size(), 0);
+            for (auto idx = std::size_t{0}; idx != nodes.size(); ++idx) {
+                dist[idx] = min_dist(nodes[0], nodes[idx]);
+                from[idx] = 0;
+            }
+            done[0] = 1;
+            auto total = T(0);
+            for (auto step = std::size_t{1}; step < nodes.size(); ++step) {
+                auto best = std::size_t{0};
+                for (auto idx = std::size_t{1}; idx != nodes.size(); ++idx) {
+                    if (done[idx] == 0 && (best == 0 || dist[idx] < dist[best])) {
+                        best = idx;
+                    }
+                }
+                done[best] = 1;
+                total += dist[best];
+                if (edges != nullptr) {
+                    edges->emplace_back(from[best], best);
+                }
+                for (auto idx = std::size_t{1}; idx != nodes.size(); ++idx) {
+                    const auto cand = min_dist(nodes[best], nodes[idx]);
+                    if (done[idx] == 0 && cand < dist[idx]) {
+                        dist[idx] = cand;
+                        from[idx] = best;
+                    }
+                }
+            }
+            return total;
+        }
+
+        /**
+         * @brief The MST length after adding `cand` to `nodes`, given the current MST.
+         *
+         * The new MST uses only the old tree edges and, from `cand`, the edge to the nearest
+         * node in each of the eight octants around it (any farther node of an octant is closer
+         * to that nearest one). Kruskal over these at most k + 7 edges, the old ones presorted,
+         * costs O(k) instead of the O(k^2) of a fresh Prim. `parent` is scratch space, kept
+         * by the caller across the candidates.
+         */
+        template <typename T>
+        auto mst_length_with(gsl::span<const Point<T>> nodes,
+                             gsl::span<const std::tuple<T, std::size_t, std::size_t>> tree,
+                             const Point<T> &cand, std::vector<std::size_t> &parent) -> T {
+            constexpr auto none = ~std::size_t{0};
+            const auto num = nodes.size();
+            std::pair<T, std::size_t> star[8];
+            std::fill(star, star + 8, std::pair<T, std::size_t>{T(0), none});
+            for (auto idx = std::size_t{0}; idx != num; ++idx) {
+                const auto d_x = nodes[idx].xcoord() - cand.xcoord();
+                const auto d_y = nodes[idx].ycoord() - cand.ycoord();
+                const auto a_x = d_x < 0 ? -d_x : d_x;
+                const auto a_y = d_y < 0 ? -d_y : d_y;
+                auto &best = star[4 * int(d_x < 0) + 2 * int(d_y < 0) + int(a_x < a_y)];
+                if (best.second == none || a_x + a_y < best.first) {
+                    best = {a_x + a_y, idx};
+                }
+            }
+            const auto num_star = std::size_t(
+                std::remove_if(star, star + 8, [](const auto &arm) { return arm.second == none; })
+                - star);
+            for (auto idx = std::size_t{1}; idx < num_star; ++idx) {  // insertion sort
+                for (auto pos = idx; pos != 0 && star[pos] < star[pos - 1]; --pos) {
+                    std::swap(star[pos], star[pos - 1]);
+                }
+            }
+            parent.resize(num + 1);
+            std::iota(parent.begin(), parent.end(), std::size_t{0});
+            auto find = [&parent](std::size_t idx) {
+                while (parent[idx] != idx) {
+                    idx = parent[idx] = parent[parent[idx]];
+                }
+                return idx;
+            };
+            auto total = T(0);
+            auto i_star = std::size_t{0};
+            auto i_tree = std::size_t{0};
+            for (auto joined = std::size_t{0}; joined != num;) {  // `cand` is node `num`
+                const auto from_star
+                    = i_tree == tree.size()
+                      || (i_star != num_star && star[i_star].first < std::get<0>(tree[i_tree]));
+                const auto [weight, src, dst]
+                    = from_star ? std::tuple{star[i_star].first, star[i_star].second, num}
+                                : tree[i_tree];
+                from_star ? ++i_star : ++i_tree;
+                const auto root_src = find(src);
+                const auto root_dst = find(dst);
+                if (root_src != root_dst) {
+                    parent[root_src] = root_dst;
+                    total += weight;
+                    ++joined;
+                }
+            }
+            return total;
+        }
+
+        /**
+         * @brief Iterated 1-Steiner over the Hanan grid, for small nets.
+         *
+         * Each round evaluates every Hanan-grid point, then adds them by decreasing gain as
+         * long as each still shortens the MST (the batched variant), dropping the Steiner
+         * points left with degree 2 or less (they never shorten the tree). The rounds repeat
+         * until no point helps. The gain of a point comes from `mst_length_with`.
+         *
+         * Reference:
+         *  - A. B. Kahng and G. Robins, "A new class of iterative Steiner tree heuristics with
+         * good performance," IEEE Trans. CAD, 11(7), 1992, pp. 893-902.
+         */
+        template <typename T> auto iterated_one_steiner(gsl::span<const Point<T>> pins)
+            -> SteinerTree<T> {
+            auto tree = SteinerTree<T>{{pins.begin(), pins.end()}, {}, pins.size()};
+            auto xs = std::vector<T>{};
+            auto ys = std::vector<T>{};
+            for (const auto &pin : pins) {
+                xs.push_back(pin.xcoord());
+                ys.push_back(pin.ycoord());
+            }
+            std::sort(xs.begin(), xs.end());
+            xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+            std::sort(ys.begin(), ys.end());
+            ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+            auto &nodes = tree.nodes;
+            auto length = prim_length<T>(nodes, &tree.edges);
+            auto weighted = std::vector<std::tuple<T, std::size_t, std::size_t>>{};
+            auto sort_tree = [&]() {
+                weighted.clear();
+                for (const auto &[src, dst] : tree.edges) {
+                    weighted.emplace_back(min_dist(nodes[src], nodes[dst]), src, dst);
+                }
+                std::sort(weighted.begin(), weighted.end());
+            };
+            auto used = std::vector<char>(xs.size() * ys.size());  // Hanan cells holding nodes
+            auto mark_nodes = [&]() {
+                std::fill(used.begin(), used.end(), char{0});
+                for (const auto &node : nodes) {
+                    const auto col = std::lower_bound(xs.begin(), xs.end(), node.xcoord());
+                    const auto row = std::lower_bound(ys.begin(), ys.end(), node.ycoord());
+                    used[std::size_t(row - ys.begin()) * xs.size()
+                         + std::size_t(col - xs.begin())] = 1;
+                }
+            };
+            auto gains = std::vector<std::pair<T, Point<T>>>{};
+            auto degree = std::vector<unsigned>{};
+            auto parent = std::vector<std::size_t>{};
+            for (auto added = true; added;) {
+                added = false;
+                sort_tree();
+                gains.clear();
+                mark_nodes();
+                for (auto row = std::size_t{0}; row != ys.size(); ++row) {
+                    for (auto col = std::size_t{0}; col != xs.size(); ++col) {
+                        if (used[row * xs.size() + col] != 0) {
+                            continue;
+                        }
+                        const auto cand = Point<T>{xs[col], ys[row]};
+                        const auto gain = length - mst_length_with<T>(nodes, weighted, cand, parent);
+                        if (T(0) < gain) {
+                            gains.emplace_back(gain, cand);
+                        }
+                    }
+                }
+                // batched: take the candidates by decreasing gain while they still help
+                std::stable_sort(gains.begin(), gains.end(), [](const auto &lhs, const auto &rhs) {
+                    return rhs.first < lhs.first;
+                });
+                for (const auto &[first_gain, cand] : gains) {
+                    if (added
+                        && !(T(0) < length - mst_length_with<T>(nodes, weighted, cand, parent))) {
+                        continue;
+                    }
+                    nodes.push_back(cand);
+                    added = true;
+                    // drop Steiner points of degree <= 2, one at a time, until none is left
+                    for (auto pruned = true; pruned;) {
+                        pruned = false;
+                        tree.edges.clear();
+                        length = prim_length<T>(nodes, &tree.edges);
+                        degree.assign(nodes.size(), 0);
+                        for (const auto &[src, dst] : tree.edges) {
+                            ++degree[src];
+                            ++degree[dst];
+                        }
+                        for (auto idx = tree.num_pins; idx != nodes.size(); ++idx) {
+                            if (degree[idx] <= 2) {
+                                nodes.erase(nodes.begin() + std::ptrdiff_t(idx));
+                                pruned = true;
+                                break;
+                            }
+                        }
+                    }
+                    sort_tree();
+                }
+            }
+            return tree;
+        }
+
+        /**
+         * @brief Edge-substitution refinement of a spanning tree.
+         *
+         * For each node `u` and each pair `v`, `w` of its neighbours, the two edges `uv` and
+         * `uw` may be replaced by the three edges from the median point `s` of `u`, `v`, `w`
+         * (the rectilinear Steiner tree of the three points). The best such substitution at
+         * each node is applied when it shortens the tree; the passes repeat until none does.
+         * Each pass costs O(sum of squared degrees), i.e. O(n) for an MST.
+         */
+        template <typename T> auto substitute_steiner_points(SteinerTree<T> &tree) -> void {
+            auto &nodes = tree.nodes;
+            auto adj = std::vector<std::vector<std::size_t>>(nodes.size());
+            for (const auto &[src, dst] : tree.edges) {
+                adj[src].push_back(dst);
+                adj[dst].push_back(src);
+            }
+            auto unlink = [&adj](std::size_t src, std::size_t dst) {
+                adj[src].erase(std::find(adj[src].begin(), adj[src].end(), dst));
+                adj[dst].erase(std::find(adj[dst].begin(), adj[dst].end(), src));
+            };
+            auto link = [&adj](std::size_t src, std::size_t dst) {
+                adj[src].push_back(dst);
+                adj[dst].push_back(src);
+            };
+
+            for (auto changed = true; changed;) {
+                changed = false;
+                for (auto node = std::size_t{0}; node != nodes.size(); ++node) {
+                    const auto &nbrs = adj[node];
+                    auto best_gain = T(0);
+                    auto best_v = std::size_t{0};
+                    auto best_w = std::size_t{0};
+                    for (auto i_v = std::size_t{0}; i_v < nbrs.size(); ++i_v) {
+                        for (auto i_w = i_v + 1; i_w < nbrs.size(); ++i_w) {
+                            const auto &pt_u = nodes[node];
+                            const auto &pt_v = nodes[nbrs[i_v]];
+                            const auto &pt_w = nodes[nbrs[i_w]];
+                            const Point<T> trio[] = {pt_u, pt_v, pt_w};
+                            const auto gain = min_dist(pt_u, pt_v) + min_dist(pt_u, pt_w)
+                                              - half_perimeter<T>(trio);
+                            if (best_gain < gain) {
+                                best_gain = gain;
+                                best_v = nbrs[i_v];
+                                best_w = nbrs[i_w];
+                            }
+                        }
+                    }
+                    if (!(T(0) < best_gain)) {
+                        continue;
+                    }
+                    const auto steiner = median_point(nodes[node], nodes[best_v], nodes[best_w]);
+                    if (steiner == nodes[best_v]) {  // the Steiner point is `v`: move `uw` to `vw`
+                        unlink(node, best_w);
+                        link(best_v, best_w);
+                    } else if (steiner == nodes[best_w]) {
+                        unlink(node, best_v);
+                        link(best_w, best_v);
+                    } else {
+                        unlink(node, best_v);
+                        unlink(node, best_w);
+                        nodes.push_back(steiner);
+                        adj.emplace_back();
+                        const auto added = nodes.size() - 1;
+                        link(added, node);
+                        link(added, best_v);
+                        link(added, best_w);
+                    }
+                    changed = true;
+                }
+            }
+
+            tree.edges.clear();
+            for (auto src = std::size_t{0}; src != adj.size(); ++src) {
+                for (const auto dst : adj[src]) {
+                    if (src < dst) {
+                        tree.edges.emplace_back(src, dst);
+                    }
+                }
+            }
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Rectilinear minimum spanning tree in O(n log n).
+     *
+     * The candidate edges come from four octant sweeps (at most 4n edges, which contain an MST
+     * of the Manhattan metric), and Kruskal picks the tree among them.
+     *
+     * @tparam T The coordinate type (signed).
+     * @param[in] pins The points.
+     * @return std::vector<std::pair<std::size_t, std::size_t>> of `pins.size() - 1` edges
+     * (pairs of indices into `pins`), or none for fewer than two points.
+     */
+    template <typename T> auto rectilinear_mst(gsl::span<const Point<T>> pins)
+        -> std::vector<std::pair<std::size_t, std::size_t>> {
+        auto tree = std::vector<std::pair<std::size_t, std::size_t>>{};
+        if (pins.size() < 2) {
+            return tree;
+        }
+        auto edges = detail::mst_candidate_edges(pins);
+        std::sort(edges.begin(), edges.end());
+        auto sets = detail::DisjointSets(pins.size());
+        tree.reserve(pins.size() - 1);
+        for (const auto &[length, src, dst] : edges) {
+            if (sets.unite(src, dst)) {
+                tree.emplace_back(std::min(src, dst), std::max(src, dst));
+                if (tree.size() + 1 == pins.size()) {
+                    break;
+                }
+            }
+        }
+        return tree;
+    }
+
+    /**
+     * @brief Rectilinear Steiner minimal tree (heuristic) of a net.
+     *
+     * - up to 3 pins: exact, with the median point as the only Steiner point;
+     * - larger nets: the O(n log n) rectilinear MST, refined by edge substitution with
+     *   median Steiner points (about 8% shorter than the MST on random nets), or iterated
+     *   1-Steiner over the Hanan grid if `mode` is `SteinerMode::OneSteiner`.
+     *
+     * @tparam T The coordinate type (signed).
+     * @param[in] pins The pins of the net.
+     * @param[in] mode The construction mode for nets of more than 3 pins.
+     * @return SteinerTree<T> whose first `pins.size()` nodes are the pins.
+     */
+    template <typename T>
+    auto rectilinear_steiner_tree(gsl::span<const Point<T>> pins,
+                                  SteinerMode mode = SteinerMode::Fast) -> SteinerTree<T> {
+        if (pins.size() > 3) {
+            if (mode == SteinerMode::OneSteiner) {
+                return detail::iterated_one_steiner(pins);
+            }
+            auto tree = SteinerTree<T>{{pins.begin(), pins.end()}, rectilinear_mst(pins),
+                                       pins.size()};
+            detail::substitute_steiner_points(tree);
+            return tree;
+        }
+        auto tree = SteinerTree<T>{{pins.begin(), pins.end()}, {}, pins.size()};
+        if (pins.size() == 2) {
+            tree.edges.emplace_back(0, 1);
+        } else if (pins.size() == 3) {
+            const auto steiner = detail::median_point(pins[0], pins[1], pins[2]);
+            const auto center = std::size_t(std::find(pins.begin(), pins.end(), steiner)
+                                            - pins.begin());  // 3 if it is no pin
+            if (center == 3) {
+                tree.nodes.push_back(steiner);
+            }
+            for (auto pin = std::size_t{0}; pin != 3; ++pin) {
+                if (pin != center) {
+                    tree.edges.emplace_back(pin, center);
+                }
+            }
+        }
+        return tree;
+    }
+
+    /**
+     * @brief The wirelength of `rectilinear_steiner_tree(pins)`.
+     *
+     * Nets of up to 3 pins, usually the vast majority, take the closed form (the
+     * half-perimeter of the bounding box) without any allocation.
+     *
+     * @tparam T The coordinate type (signed).
+     * @param[in] pins The pins of the net.
+     * @param[in] mode The construction mode for nets of more than 3 pins.
+     * @return T
+     */
+    template <typename T>
+    auto rsmt_length(gsl::span<const Point<T>> pins, SteinerMode mode = SteinerMode::Fast) -> T {
+        if (pins.size() < 2) {
+            return T(0);
+        }
+        if (pins.size() <= 3) {
+            return detail::half_perimeter(pins);
+        }
+        return rectilinear_steiner_tree(pins, mode).wirelength();
+    }
+
+    /**
+     * @brief Batch RSMT wirelength of many nets, in parallel over the nets.
+     *
+     * The nets are given in flat (CSR) form: net `i` has the pins
+     * `pins[offsets[i] .. offsets[i + 1])`, which is the layout of `PolygonSet::points()` and
+     * `PolygonSet::offsets()`. The nets are handed out in chunks to up to `num_threads`
+     * threads; the result does not depend on the thread count.
+     *
+     * @tparam T The coordinate type (signed).
+     * @param[in] pins The pins of all nets, back to back.
+     * @param[in] offsets The offset table (`out.size() + 1` entries).
+     * @param[out] out The wirelength of each net.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @param[in] mode The construction mode for nets of more than 3 pins.
+     */
+    template <typename T>
+    auto rsmt_lengths(gsl::span<const Point<T>> pins, gsl::span<const std::size_t> offsets,
+                      gsl::span<T> out, unsigned num_threads = 1,
+                      SteinerMode mode = SteinerMode::Fast) -> void {
+        assert(offsets.size() == out.size() + 1);
+        auto one_net = [&](std::size_t net) {
+            const auto net_pins = pins.subspan(offsets[net], offsets[net + 1] - offsets[net]);
+            out[net] = rsmt_length(net_pins, mode);
+        };
+        parallel_for(std::size_t{0}, out.size(), one_net, num_threads, 64);
+    }
+
+}  // namespace recti
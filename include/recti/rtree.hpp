@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::min
+#include <cassert>    // for assert
+#include <cmath>      // for std::sqrt, std::ceil
+#include <cstddef>    // for std::size_t
+#include <functional>  // for std::greater
+#include <gsl/span>
+#include <numeric>  // for std::iota
+#include <queue>    // for std::priority_queue
+#include <tuple>    // for std::tuple
+#include <utility>  // for std::pair
+#include <vector>
+
+#include "instrument.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    /**
+     * @brief Static (bulk-loaded) R-tree
+     *
+     * `StaticRTree` is a read-only spatial index over a set of `Rectangle<T>` objects. It is
+     * bulk-loaded with the Sort-Tile-Recursive (STR) packing and stores every level of the tree
+     * in a single contiguous array of bounding boxes. Because the tree is packed, the children
+     * of node `k` on level `L` are simply the nodes `[k * NodeSize, (k + 1) * NodeSize)` on
+     * level `L - 1`, so no child pointers (and no per-node allocation) are needed.
+     *
+     * Queries report the index of a rectangle in the span the tree was built from.
+     *
+     * Reference:
+     *  - S. T. Leutenegger, M. A. Lopez and J. Edgington, "STR: a simple and efficient
+     * algorithm for R-tree packing," Proceedings 13th International Conference on Data
+     * Engineering, 1997, pp. 497-506.
+     *
+     * @tparam T The coordinate type.
+     * @tparam NodeSize The fan-out of every node.
+     */
+    template <typename T, std::size_t NodeSize = 16> class StaticRTree {
+        static_assert(NodeSize >= 2, "the fan-out must be at least 2");
+
+        std::vector<Rectangle<T>> _boxes{};   // all levels, the items (level 0) first
+        std::vector<std::size_t> _offsets{};  // start of each level in `_boxes`, plus the end
+        std::vector<std::size_t> _ids{};      // original index of each item on level 0
+
+      public:
+        /**
+         * @brief Construct an empty tree.
+         */
+        StaticRTree() = default;
+
+        /**
+         * @brief Bulk-load a tree from a span of rectangles.
+         *
+         * @param[in] rects The rectangles to be indexed.
+         */
+        explicit StaticRTree(gsl::span<const Rectangle<T>> rects) {
+            RECTI_TIME_SCOPE(rtree_build);
+            const auto num = rects.size();
+            if (num == 0) {
+                return;
+            }
+            this->_ids.resize(num);
+            std::iota(this->_ids.begin(), this->_ids.end(), std::size_t{0});
+            this->_str_sort(rects);
+
+            auto num_nodes = std::size_t{0};
+            for (auto count = num; count > 1 || num_nodes == 0;) {
+                count = (count + NodeSize - 1) / NodeSize;
+                num_nodes += count;
+            }
+            this->_boxes.reserve(num + num_nodes);
+            for (auto idx : this->_ids) {
+                this->_boxes.push_back(rects[idx]);
+            }
+
+            this->_offsets.push_back(0);
+            this->_offsets.push_back(num);
+            // there is always at least one internal level, so the root is never an item
+            for (auto level = std::size_t{0}; level == 0 || this->_level_size(level) > 1;
+                 ++level) {
+                const auto first = this->_offsets[level];
+                const auto last = this->_offsets[level + 1];
+                for (auto start = first; start < last; start += NodeSize) {
+                    const auto stop = std::min(start + NodeSize, last);
+                    auto bbox = this->_boxes[start];
+                    for (auto child = start + 1; child != stop; ++child) {
+                        bbox = bbox.hull_with(this->_boxes[child]);
+                    }
+                    this->_boxes.push_back(bbox);
+                }
+                this->_offsets.push_back(this->_boxes.size());
+            }
+        }
+
+        /**
+         * @brief The number of indexed rectangles.
+         *
+         * @return std::size_t
+         */
+        auto size() const noexcept -> std::size_t { return this->_ids.size(); }
+
+        /**
+         * @brief Whether the tree is empty.
+         *
+         * @return true if no rectangle is indexed.
+         */
+        auto empty() const noexcept -> bool { return this->_ids.empty(); }
+
+        /**
+         * @brief The bounding box of all indexed rectangles.
+         *
+         * @return const Rectangle<T>& (the tree must not be empty)
+         */
+        auto bounding_box() const -> const Rectangle<T> & {
+            assert(!this->empty());
+            return this->_boxes.back();
+        }
+
+        /**
+         * @brief Visit every rectangle that overlaps a query object.
+         *
+         * The query may be any object that `overlap()` can test against a `Rectangle<T>`,
+         * e.g. a `Rectangle<T>` window or a `Point<T>`. The callback receives the original index
+         * of each overlapping rectangle.
+         *
+         * @tparam Query The query type.
+         * @tparam Fn The callback type, invocable as `fn(std::size_t)`.
+         * @param[in] query The query object.
+         * @param[in] fn The callback.
+         */
+        template <typename Query, typename Fn>
+        auto visit_overlapping(const Query &query, Fn &&fn) const -> void {
+            RECTI_COUNT(rtree_query);
+            if (this->empty()) {
+                return;
+            }
+            const auto top = this->_offsets.size() - 2;
+            if (overlap(this->_boxes.back(), query)) {
+                this->_visit(top, 0, query, fn);
+            }
+        }
+
+        /**
+         * @brief Window query.
+         *
+         * @param[in] window The query window.
+         * @return std::vector<std::size_t> The indices of the overlapping rectangles.
+         */
+        auto query(const Rectangle<T> &window) const -> std::vector<std::size_t> {
+            auto result = std::vector<std::size_t>{};
+            this->visit_overlapping(window, [&result](std::size_t idx) { result.push_back(idx); });
+            return result;
+        }
+
+        /**
+         * @brief Point-containment query.
+         *
+         * @param[in] ptq The query point.
+         * @return std::vector<std::size_t> The indices of the rectangles containing `ptq`.
+         */
+        auto query(const Point<T> &ptq) const -> std::vector<std::size_t> {
+            auto result = std::vector<std::size_t>{};
+            this->visit_overlapping(ptq, [&result](std::size_t idx) { result.push_back(idx); });
+            return result;
+        }
+
+        /**
+         * @brief k-nearest neighbour query by the (Manhattan) `min_dist` metric.
+         *
+         * The search is best-first over the node bounding boxes, so only the nodes that can
+         * still contain one of the `k` nearest rectangles are expanded. Rectangles at the same
+         * distance are reported in increasing order of their original index.
+         *
+         * @tparam Query The query type (`Point<T>` or `Rectangle<T>`).
+         * @param[in] query The query object.
+         * @param[in] k The number of neighbours wanted.
+         * @return std::vector<std::pair<T, std::size_t>> Pairs of (distance, index) in
+         * increasing order of distance.
+         */
+        template <typename Query> auto nearest(const Query &query, std::size_t k) const
+            -> std::vector<std::pair<T, std::size_t>> {
+            auto result = std::vector<std::pair<T, std::size_t>>{};
+            if (this->empty() || k == 0) {
+                return result;
+            }
+            result.reserve(k);
+            // (distance, is item, key, level): on equal distance the nodes are expanded before
+            // any item is reported, and the items are keyed by their original index, so ties
+            // come out in increasing order of index.
+            using Entry = std::tuple<T, bool, std::size_t, std::size_t>;
+            auto heap = std::priority_queue<Entry, std::vector<Entry>, std::greater<>>{};
+            const auto top = this->_offsets.size() - 2;
+            heap.emplace(T(min_dist(this->_boxes.back(), query)), false, 0, top);
+            while (!heap.empty() && result.size() != k) {
+                const auto [dist, is_item, key, level] = heap.top();
+                heap.pop();
+                if (is_item) {
+                    result.emplace_back(dist, key);
+                    continue;
+                }
+                const auto first = key * NodeSize;
+                const auto last = std::min(first + NodeSize, this->_level_size(level - 1));
+                const auto base = this->_offsets[level - 1];
+                for (auto child = first; child != last; ++child) {
+                    const auto child_dist = T(min_dist(this->_boxes[base + child], query));
+                    if (level == 1) {
+                        heap.emplace(child_dist, true, this->_ids[child], 0);
+                    } else {
+                        heap.emplace(child_dist, false, child, level - 1);
+                    }
+                }
+            }
+            return result;
+        }
+
+      private:
+        auto _level_size(std::size_t level) const -> std::size_t {
+            return this->_offsets[level + 1] - this->_offsets[level];
+        }
+
+        template <typename Query, typename Fn>
+        auto _visit(std::size_t level, std::size_t pos, const Query &query, Fn &fn) const
+            -> void {
+            const auto first = pos * NodeSize;
+            const auto last = std::min(first + NodeSize, this->_level_size(level - 1));
+            const auto base = this->_offsets[level - 1];
+            for (auto child = first; child != last; ++child) {
+                if (!overlap(this->_boxes[base + child], query)) {
+                    continue;
+                }
+                if (level == 1) {
+                    fn(this->_ids[child]);
+                } else {
+                    this->_visit(level - 1, child, query, fn);
+                }
+            }
+        }
+
+        /**
+         * @brief Order `_ids` by Sort-Tile-Recursive: x-slices of y-sorted runs.
+         */
+        auto _str_sort(gsl::span<const Rectangle<T>> rects) -> void {
+            auto center_x = [&rects](std::size_t idx) {
+                return rects[idx].xcoord().lb() + rects[idx].xcoord().ub();
+            };
+            auto center_y = [&rects](std::size_t idx) {
+                return rects[idx].ycoord().lb() + rects[idx].ycoord().ub();
+            };
+            const auto num = this->_ids.size();
+            const auto num_leaves = (num + NodeSize - 1) / NodeSize;
+            const auto num_slices = std::size_t(std::ceil(std::sqrt(double(num_leaves))));
+            const auto slice_size = num_slices * NodeSize;
+            std::sort(this->_ids.begin(), this->_ids.end(),
+                      [&center_x](std::size_t lhs, std::size_t rhs) {
+                          return center_x(lhs) < center_x(rhs);
+                      });
+            for (auto start = std::size_t{0}; start < num; start += slice_size) {
+                const auto stop = std::min(start + slice_size, num);
+                std::sort(this->_ids.begin() + std::ptrdiff_t(start),
+                          this->_ids.begin() + std::ptrdiff_t(stop),
+                          [&center_y](std::size_t lhs, std::size_t rhs) {
+                              return center_y(lhs) < center_y(rhs);
+                          });
+            }
+        }
+    };
+
+}  // namespace recti
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>  // for std::sort, std::unique, std::lower_bound, std::upper_bound
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint8_t
+#include <gsl/span>
+#include <numeric>  // for std::iota
+#include <utility>  // for std::pair
+#include <vector>
+
+#include "instrument.hpp"
+#include "parallel.hpp"
+#include "recti.hpp"
+
+namespace recti {
+
+    namespace detail {
+        /**
+         * @brief Fenwick (binary indexed) tree of counts over the slots `[0, size)`.
+         */
+        class FenwickTree {
+            std::vector<std::size_t> _tree;  // 1-based
+
+          public:
+            explicit FenwickTree(std::size_t size) : _tree(size + 1, 0) {}
+
+            auto increment(std::size_t slot) -> void {
+                for (auto pos = slot + 1; pos < this->_tree.size(); pos += pos & (~pos + 1)) {
+                    ++this->_tree[pos];
+                }
+            }
+
+            auto decrement(std::size_t slot) -> void {
+                for (auto pos = slot + 1; pos < this->_tree.size(); pos += pos & (~pos + 1)) {
+                    --this->_tree[pos];
+                }
+            }
+
+            /// The total count of the slots `[0, slot)`.
+            auto prefix(std::size_t slot) const -> std::size_t {
+                auto total = std::size_t{0};
+                for (auto pos = slot; pos != 0; pos -= pos & (~pos + 1)) {
+                    total += this->_tree[pos];
+                }
+                return total;
+            }
+
+            /// The first slot at which the prefix count exceeds `rank`, or `size` if none.
+            auto find(std::size_t rank) const -> std::size_t {
+                auto pos = std::size_t{0};
+                auto step = std::size_t{1};
+                while (2 * step < this->_tree.size()) {
+                    step *= 2;
+                }
+                for (; step != 0; step /= 2) {
+                    if (pos + step < this->_tree.size() && this->_tree[pos + step] <= rank) {
+                        pos += step;
+                        rank -= this->_tree[pos];
+                    }
+                }
+                return pos;
+            }
+        };
+
+        /**
+         * @brief Plane sweep in x over a subset of the segments.
+         *
+         * The horizontal segments cut by the sweep line are counted in a `FenwickTree` over
+         * their (compressed) y-coordinates, so a vertical segment counts its crossings with
+         * two prefix queries. When reporting, the active segments are also kept in one bucket
+         * per y-coordinate, and the non-empty buckets in range are found with `find()`.
+         *
+         * @return std::size_t The number of crossings.
+         */
+        template <typename T, bool Report, typename Fn>
+        auto sweep_crossings(gsl::span<const HSegment<T>> hsegs,
+                             gsl::span<const VSegment<T>> vsegs,
+                             gsl::span<const std::size_t> h_items,
+                             gsl::span<const std::size_t> v_items, Fn &fn) -> std::size_t {
+            auto ycoords = std::vector<T>{};
+            ycoords.reserve(h_items.size());
+            for (const auto idx : h_items) {
+                ycoords.push_back(hsegs[idx].ycoord());
+            }
+            std::sort(ycoords.begin(), ycoords.end());
+            ycoords.erase(std::unique(ycoords.begin(), ycoords.end()), ycoords.end());
+            auto slot_of = [&ycoords](const T &ycoord) {
+                return std::size_t(std::lower_bound(ycoords.begin(), ycoords.end(), ycoord)
+                                   - ycoords.begin());
+            };
+
+            // bounds are closed: at equal x, insert before query before remove
+            struct Event {
+                T xcoord;
+                std::uint8_t kind;  // 0: insert, 1: query, 2: remove
+                std::size_t item;   // position in `h_items` or `v_items`
+            };
+            auto events = std::vector<Event>{};
+            events.reserve(2 * h_items.size() + v_items.size());
+            for (auto item = std::size_t{0}; item != h_items.size(); ++item) {
+                const auto &xcoord = hsegs[h_items[item]].xcoord();
+                events.push_back({xcoord.lb(), 0, item});
+                events.push_back({xcoord.ub(), 2, item});
+            }
+            for (auto item = std::size_t{0}; item != v_items.size(); ++item) {
+                events.push_back({vsegs[v_items[item]].xcoord(), 1, item});
+            }
+            std::sort(events.begin(), events.end(), [](const Event &lhs, const Event &rhs) {
+                if (lhs.xcoord < rhs.xcoord || rhs.xcoord < lhs.xcoord) {
+                    return lhs.xcoord < rhs.xcoord;
+                }
+                return lhs.kind < rhs.kind;
+            });
+
+            auto active = FenwickTree(ycoords.size());
+            auto buckets = std::vector<std::vector<std::size_t>>(Report ? ycoords.size() : 0);
+            auto place = std::vector<std::size_t>(Report ? h_items.size() : 0);
+            auto total = std::size_t{0};
+            for (const auto &event : events) {
+                if (event.kind != 1) {
+                    const auto slot = slot_of(hsegs[h_items[event.item]].ycoord());
+                    if (event.kind == 0) {
+                        active.increment(slot);
+                    } else {
+                        active.decrement(slot);
+                    }
+                    if constexpr (Report) {
+                        auto &bucket = buckets[slot];
+                        if (event.kind == 0) {
+                            place[event.item] = bucket.size();
+                            bucket.push_back(event.item);
+                        } else {  // swap-remove
+                            const auto last = bucket.back();
+                            bucket[place[event.item]] = last;
+                            place[last] = place[event.item];
+                            bucket.pop_back();
+                        }
+                    }
+                    continue;
+                }
+                const auto v_idx = v_items[event.item];
+                const auto &yrange = vsegs[v_idx].ycoord();
+                const auto first = slot_of(yrange.lb());
+                const auto last = std::size_t(
+                    std::upper_bound(ycoords.begin(), ycoords.end(), yrange.ub())
+                    - ycoords.begin());
+                if (!(first < last)) {
+                    continue;
+                }
+                const auto before = active.prefix(first);
+                total += active.prefix(last) - before;
+                if constexpr (Report) {
+                    for (auto slot = active.find(before); slot < last;
+                         slot = active.find(active.prefix(slot + 1))) {
+                        for (const auto item : buckets[slot]) {
+                            fn(h_items[item], v_idx);
+                        }
+                    }
+                }
+            }
+            return total;
+        }
+
+        /**
+         * @brief Split the segments into vertical strips holding about the same number of
+         * vertical segments.
+         *
+         * Each vertical segment goes to exactly one strip; a horizontal segment goes to every
+         * strip whose x-range it touches. So every crossing is found by exactly one strip.
+         */
+        template <typename T>
+        auto crossing_strips(gsl::span<const HSegment<T>> hsegs,
+                             gsl::span<const VSegment<T>> vsegs, std::size_t num_strips)
+            -> std::pair<std::vector<std::vector<std::size_t>>,
+                         std::vector<std::vector<std::size_t>>> {
+            auto order = std::vector<std::size_t>(vsegs.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::sort(order.begin(), order.end(), [&vsegs](std::size_t lhs, std::size_t rhs) {
+                return vsegs[lhs].xcoord() < vsegs[rhs].xcoord();
+            });
+            // strip `k` takes the vertical segments with x in `[starts[k - 1], starts[k])`
+            auto starts = std::vector<T>{};
+            for (auto strip = std::size_t{1}; strip != num_strips; ++strip) {
+                starts.push_back(vsegs[order[strip * vsegs.size() / num_strips]].xcoord());
+            }
+            auto h_members = std::vector<std::vector<std::size_t>>(num_strips);
+            auto v_members = std::vector<std::vector<std::size_t>>(num_strips);
+            for (const auto idx : order) {
+                const auto &xcoord = vsegs[idx].xcoord();
+                const auto strip = std::upper_bound(starts.begin(), starts.end(), xcoord);
+                v_members[std::size_t(strip - starts.begin())].push_back(idx);
+            }
+            for (auto idx = std::size_t{0}; idx != hsegs.size(); ++idx) {
+                const auto &xcoord = hsegs[idx].xcoord();
+                const auto first = std::upper_bound(starts.begin(), starts.end(), xcoord.lb());
+                const auto last = std::upper_bound(first, starts.end(), xcoord.ub());
+                for (auto strip = std::size_t(first - starts.begin());
+                     strip <= std::size_t(last - starts.begin()); ++strip) {
+                    h_members[strip].push_back(idx);
+                }
+            }
+            return {std::move(h_members), std::move(v_members)};
+        }
+
+        inline auto crossing_num_strips(std::size_t num_vsegs, unsigned num_threads)
+            -> std::size_t {
+            if (num_threads == 0) {
+                num_threads = hardware_threads();
+            }
+            return std::min<std::size_t>(4 * std::size_t(num_threads), num_vsegs / 1024 + 1);
+        }
+
+        inline auto all_items(std::size_t size) -> std::vector<std::size_t> {
+            auto items = std::vector<std::size_t>(size);
+            std::iota(items.begin(), items.end(), std::size_t{0});
+            return items;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Report every crossing of a horizontal and a vertical segment (plane sweep).
+     *
+     * Sweeps a vertical line across the segments in increasing x, keeping the y-coordinates
+     * of the horizontal segments cut by the line in a Fenwick tree, so that each vertical
+     * segment finds its crossings in O(log n) plus the number reported. As in `overlap()`,
+     * the bounds are closed, so a segment ending on another one crosses it.
+     *
+     * The callback is invoked as `fn(h, v)`, once for each crossing pair of the horizontal
+     * segment `hsegs[h]` and the vertical segment `vsegs[v]`.
+     *
+     * @tparam T The coordinate type.
+     * @tparam Fn The callback type.
+     * @param[in] hsegs The horizontal segments.
+     * @param[in] vsegs The vertical segments.
+     * @param[in] fn The callback.
+     */
+    template <typename T, typename Fn>
+    auto sweep_crossings(gsl::span<const HSegment<T>> hsegs, gsl::span<const VSegment<T>> vsegs,
+                         Fn &&fn) -> void {
+        RECTI_TIME_SCOPE(segment_crossings);
+        const auto h_items = detail::all_items(hsegs.size());
+        const auto v_items = detail::all_items(vsegs.size());
+        detail::sweep_crossings<T, true>(hsegs, vsegs, h_items, v_items, fn);
+    }
+
+    /**
+     * @brief The number of crossings of horizontal and vertical segments.
+     *
+     * Same sweep as `sweep_crossings`, without reporting the pairs: O(n log n) whatever the
+     * number of crossings. The x-range is split into strips holding about the same number of
+     * vertical segments, which are swept independently on up to `num_threads` threads.
+     *
+     * @tparam T The coordinate type.
+     * @param[in] hsegs The horizontal segments.
+     * @param[in] vsegs The vertical segments.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::size_t
+     */
+    template <typename T>
+    auto count_crossings(gsl::span<const HSegment<T>> hsegs, gsl::span<const VSegment<T>> vsegs,
+                         unsigned num_threads = 1) -> std::size_t {
+        RECTI_TIME_SCOPE(segment_crossings);
+        auto ignore = [](std::size_t, std::size_t) {};
+        const auto num_strips = detail::crossing_num_strips(vsegs.size(), num_threads);
+        if (num_strips <= 1) {
+            const auto h_items = detail::all_items(hsegs.size());
+            const auto v_items = detail::all_items(vsegs.size());
+            return detail::sweep_crossings<T, false>(hsegs, vsegs, h_items, v_items, ignore);
+        }
+        const auto [h_members, v_members] = detail::crossing_strips<T>(hsegs, vsegs, num_strips);
+        auto counts = std::vector<std::size_t>(num_strips, 0);
+        auto sweep = [&](std::size_t strip) {
+            counts[strip] = detail::sweep_crossings<T, false>(hsegs, vsegs, h_members[strip],
+                                                              v_members[strip], ignore);
+        };
+        parallel_for(std::size_t{0}, num_strips, sweep, num_threads);
+        auto total = std::size_t{0};
+        for (const auto count : counts) {
+            total += count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Collect every crossing of horizontal and vertical segments, in parallel over
+     * vertical strips.
+     *
+     * @tparam T The coordinate type.
+     * @param[in] hsegs The horizontal segments.
+     * @param[in] vsegs The vertical segments.
+     * @param[in] num_threads The number of threads (0 for all hardware threads).
+     * @return std::vector<std::pair<std::size_t, std::size_t>> of pairs `(h, v)`, sorted.
+     */
+    template <typename T>
+    auto crossing_pairs(gsl::span<const HSegment<T>> hsegs, gsl::span<const VSegment<T>> vsegs,
+                        unsigned num_threads = 1)
+        -> std::vector<std::pair<std::size_t, std::size_t>> {
+        RECTI_TIME_SCOPE(segment_crossings);
+        using Pair = std::pair<std::size_t, std::size_t>;
+        const auto num_strips = detail::crossing_num_strips(vsegs.size(), num_threads);
+        auto result = std::vector<Pair>{};
+        if (num_strips <= 1) {
+            auto collect = [&result](std::size_t h_idx, std::size_t v_idx) {
+                result.emplace_back(h_idx, v_idx);
+            };
+            const auto h_items = detail::all_items(hsegs.size());
+            const auto v_items = detail::all_items(vsegs.size());
+            detail::sweep_crossings<T, true>(hsegs, vsegs, h_items, v_items, collect);
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+        const auto [h_members, v_members] = detail::crossing_strips<T>(hsegs, vsegs, num_strips);
+        auto found = std::vector<std::vector<Pair>>(num_strips);
+        auto sweep = [&](std::size_t strip) {
+            auto collect = [&found, strip](std::size_t h_idx, std::size_t v_idx) {
+                found[strip].emplace_back(h_idx, v_idx);
+            };
+            detail::sweep_crossings<T, true>(hsegs, vsegs, h_members[strip], v_members[strip],
+                                             collect);
+        };
+        parallel_for(std::size_t{0}, num_strips, sweep, num_threads);
+        auto total = std::size_t{0};
+        for (const auto &pairs : found) {
+            total += pairs.size();
+        }
+        result.reserve(total);
+        for (const auto &pairs : found) {
+            result.insert(result.end(), pairs.begin(), pairs.end());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+}  // namespace recti
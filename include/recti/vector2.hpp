@@ -3,6 +3,8 @@
 #include <tuple>    // import std::tie()
 #include <utility>  // import std::move
 
+#include "accumulator.hpp"
+
 #if __cpp_constexpr >= 201304
 #    define CONSTEXPR14 constexpr
 #else
@@ -87,6 +89,8 @@ namespace recti {
          * This function computes the cross product of the current `Vector2` object and the
          * provided `Vector2` object `other`. The cross product of two 2D vectors is a scalar
          * value that represents the signed area of the parallelogram formed by the two vectors.
+         * The products are taken in the accumulator type (`accumulator_t`), so 32-bit
+         * coordinates give an exact 64-bit result.
          *
          * @tparam U1 The type of the x-coordinate of the other `Vector2` object.
          * @tparam U2 The type of the y-coordinate of the other `Vector2` object.
@@ -95,7 +99,7 @@ namespace recti {
          */
         template <typename U1, typename U2>  //
         constexpr auto cross(const Vector2<U1, U2> &other) const {
-            return this->_x * other._y - other._x * this->_y;
+            return widen(this->_x) * widen(other._y) - widen(other._x) * widen(this->_y);
         }
 
         /** @name Comparison operators
@@ -1,53 +1,336 @@
-#include <recti/greeter.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <recti/binary_io.hpp>
+#include <recti/cts_topology.hpp>
+#include <recti/def_reader.hpp>
+#include <recti/dme.hpp>
+#include <recti/hpwl.hpp>
+#include <recti/instrument.hpp>
+#include <recti/overlap_sweep.hpp>
+#include <recti/parallel.hpp>
+#include <recti/polygon_set.hpp>
+#include <recti/rpolygon_decompose.hpp>
 #include <recti/version.h>
 
+#include <chrono>
 #include <cxxopts.hpp>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
-auto main(int argc, char **argv) -> int {
-    const std::unordered_map<std::string, recti::LanguageCode> languages{
-        {"en", recti::LanguageCode::EN},
-        {"de", recti::LanguageCode::DE},
-        {"es", recti::LanguageCode::ES},
-        {"fr", recti::LanguageCode::FR},
+namespace {
+
+    using Coord = int;
+    using recti::Point;
+    using recti::PolygonSet;
+    using recti::Rectangle;
+
+    /// Everything the pipelines work on.
+    struct Layout {
+        std::vector<Rectangle<Coord>> rects;
+        PolygonSet<Coord> rpolygons;      // point lists of rectilinear polygons
+        std::vector<Point<Coord>> sinks;  // clock sinks
+        PolygonSet<Coord> nets;           // the pin positions of each net
     };
 
-    cxxopts::Options options(*argv, "A program to welcome the world!");
+    auto center_of(const Rectangle<Coord> &rect) -> Point<Coord> {
+        return Point<Coord>{rect.xcoord().lb() + (rect.xcoord().ub() - rect.xcoord().lb()) / 2,
+                            rect.ycoord().lb() + (rect.ycoord().ub() - rect.ycoord().lb()) / 2};
+    }
+
+    /// Points become sinks, rectangles and polygon sets shapes; segments are ignored.
+    auto load_binary(const std::string &path, Layout &layout) -> void {
+        using recti::binary::Kind;
+        const auto reader = recti::binary::BinaryReader(path);
+        for (auto idx = std::size_t{0}; idx != reader.num_sections(); ++idx) {
+            switch (reader.section(idx).kind) {
+                case Kind::points: {
+                    const auto pts = reader.records<Point<Coord>>(idx);
+                    layout.sinks.insert(layout.sinks.end(), pts.begin(), pts.end());
+                    break;
+                }
+                case Kind::rectangles: {
+                    const auto rects = reader.records<Rectangle<Coord>>(idx);
+                    layout.rects.insert(layout.rects.end(), rects.begin(), rects.end());
+                    break;
+                }
+                case Kind::polygon_set: {
+                    const auto polygons = reader.polygon_set<Coord>(idx);
+                    for (auto pos = std::size_t{0}; pos != polygons.size(); ++pos) {
+                        layout.rpolygons.push_back(polygons[pos]);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    /// Every polygon set of the file is a list of nets (the pins of net `i` are "polygon" i).
+    auto load_nets(const std::string &path, Layout &layout) -> void {
+        const auto reader = recti::binary::BinaryReader(path);
+        for (auto idx = std::size_t{0}; idx != reader.num_sections(); ++idx) {
+            if (reader.section(idx).kind == recti::binary::Kind::polygon_set) {
+                const auto nets = reader.polygon_set<Coord>(idx);
+                for (auto pos = std::size_t{0}; pos != nets.size(); ++pos) {
+                    layout.nets.push_back(nets[pos]);
+                }
+            }
+        }
+    }
+
+    /// The placed components become shapes and sinks (at their centers).
+    auto load_def(const std::string &path, const std::string &lef_path, Layout &layout)
+        -> void {
+        auto macros = recti::def::MacroSizes{};
+        if (!lef_path.empty()) {
+            auto lef = std::ifstream(lef_path);
+            if (!lef) {
+                throw std::runtime_error("cannot open " + lef_path);
+            }
+            macros = recti::def::read_lef_macro_sizes(lef);
+        }
+        auto input = std::ifstream(path);
+        if (!input) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        auto reader = recti::def::DefReader<Coord>(input, lef_path.empty() ? nullptr : &macros);
+        recti::def::read_def_pipelined(reader, [&layout](const auto &batch) {
+            for (auto idx = std::size_t{0}; idx != batch.rects.size(); ++idx) {
+                layout.rects.push_back(batch.rects[idx]);
+                if (batch.rect_kinds[idx] == recti::def::ShapeKind::component) {
+                    layout.sinks.push_back(center_of(batch.rects[idx]));
+                }
+            }
+            for (auto idx = std::size_t{0}; idx != batch.rpolygons.size(); ++idx) {
+                layout.rpolygons.push_back(batch.rpolygons[idx]);
+            }
+        });
+    }
+
+    /// Runs one stage and reports its time and throughput on stderr.
+    template <typename Fn> auto run_stage(const std::string &name, Fn &&fn) -> void {
+        const auto start = std::chrono::steady_clock::now();
+        const auto items = fn();
+        const auto stop = std::chrono::steady_clock::now();
+        const auto secs = std::chrono::duration<double>(stop - start).count();
+        fmt::print(std::cerr, "{:<10} {:>12} items {:>12.3f} ms {:>14.0f} items/s\n", name, items,
+                   secs * 1e3, secs > 0 ? double(items) / secs : 0.0);
+    }
+
+    auto overlap_stage(const Layout &layout, unsigned num_threads, std::ostream &out)
+        -> std::size_t {
+        const auto pairs = recti::overlapping_pairs<Coord>(layout.rects, num_threads);
+        for (const auto &[idx1, idx2] : pairs) {
+            fmt::print(out, "overlap {} {}\n", idx1, idx2);
+        }
+        fmt::print(out, "overlap_pairs {}\n", pairs.size());
+        return layout.rects.size();
+    }
+
+    auto decompose_stage(const Layout &layout, unsigned num_threads, std::ostream &out)
+        -> std::size_t {
+        const auto &polygons = layout.rpolygons;
+        auto pieces = std::vector<std::vector<Rectangle<Coord>>>(polygons.size());
+        recti::parallel_for(
+            std::size_t{0}, polygons.size(),
+            [&](std::size_t idx) { recti::decompose_rpolygon<Coord>(polygons[idx], pieces[idx]); },
+            num_threads, 64);
+        auto total = std::size_t{0};
+        for (auto idx = std::size_t{0}; idx != pieces.size(); ++idx) {
+            for (const auto &rect : pieces[idx]) {
+                fmt::print(out, "rect {} {} {} {} {}\n", idx, rect.xcoord().lb(),
+                           rect.ycoord().lb(), rect.xcoord().ub(), rect.ycoord().ub());
+            }
+            total += pieces[idx].size();
+        }
+        fmt::print(out, "decompose_rects {}\n", total);
+        return polygons.size();
+    }
+
+    auto hpwl_stage(const Layout &layout, unsigned num_threads, std::ostream &out)
+        -> std::size_t {
+        const auto &nets = layout.nets;
+        // every pin is a cell of its own, at the pin position
+        auto pin_cells = std::vector<std::size_t>(nets.num_points());
+        std::iota(pin_cells.begin(), pin_cells.end(), std::size_t{0});
+        const auto pin_offsets
+            = std::vector<recti::Vector2<Coord>>(nets.num_points(), recti::Vector2<Coord>{0, 0});
+        const auto netlist = recti::HpwlNetlist<Coord>(nets.offsets(), pin_cells, pin_offsets,
+                                                       nets.points(), num_threads);
+        for (auto net = std::size_t{0}; net != netlist.num_nets(); ++net) {
+            fmt::print(out, "hpwl {} {}\n", net, netlist.hpwl(net));
+        }
+        fmt::print(out, "hpwl_total {}\n", netlist.total());
+        return nets.num_points();
+    }
+
+    auto cts_stage(const Layout &layout, unsigned num_threads, std::ostream &out)
+        -> std::size_t {
+        if (layout.sinks.empty()) {
+            fmt::print(out, "cts_wirelength 0\n");
+            return 0;
+        }
+        auto topo = recti::greedy_matching_topology<Coord>(layout.sinks, num_threads);
+        auto tree = recti::DmeTree<Coord>(layout.sinks, std::move(topo));
+        tree.build(num_threads);
+        fmt::print(out, "cts_wirelength {}\n", tree.total_wire_length());
+        return layout.sinks.size();
+    }
 
-    std::string language;
-    std::string name;
+    auto split_list(const std::string &list) -> std::vector<std::string> {
+        auto items = std::vector<std::string>{};
+        auto input = std::istringstream(list);
+        for (auto item = std::string{}; std::getline(input, item, ',');) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+#ifdef RECTI_INSTRUMENT
+    auto write_file(const std::string &path, void (*write)(std::ostream &)) -> void {
+        auto file = std::ofstream(path);
+        if (!file) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        write(file);
+    }
+#endif
 
-    // clang-format off
+    auto run(int argc, char **argv) -> int {
+        cxxopts::Options options("recti", "Batch processing of rectilinear layout geometry");
+
+        auto input = std::string{};
+        auto def = std::string{};
+        auto lef = std::string{};
+        auto nets = std::string{};
+        auto pipeline = std::string{};
+        auto output = std::string{};
+        auto stats = std::string{};
+        auto trace = std::string{};
+        auto num_threads = 1U;
+
+        // clang-format off
   options.add_options()
     ("h,help", "Show help")
     ("v,version", "Print the current version number")
-    ("n,name", "Name to greet", cxxopts::value(name)->default_value("World"))
-    ("l,lang", "Language code to use", cxxopts::value(language)->default_value("en"))
+    ("i,input", "Binary geometry file (points, rectangles, polygon sets)",
+     cxxopts::value(input))
+    ("d,def", "DEF file (die area, components, pins, blockages)", cxxopts::value(def))
+    ("l,lef", "LEF file with the macro sizes of the DEF components", cxxopts::value(lef))
+    ("n,nets", "Binary file whose polygon sets hold the pin positions of each net",
+     cxxopts::value(nets))
+    ("p,pipeline", "Comma-separated stages: overlap, decompose, hpwl, cts",
+     cxxopts::value(pipeline)->default_value("overlap"))
+    ("t,threads", "Number of threads (0 for all hardware threads)",
+     cxxopts::value(num_threads)->default_value("1"))
+    ("o,output", "Result file ('-' for stdout)", cxxopts::value(output)->default_value("-"))
+    ("stats", "Write the instrumentation counters as JSON to this file", cxxopts::value(stats))
+    ("trace", "Write a Chrome trace of the timed stages to this file", cxxopts::value(trace))
   ;
-    // clang-format on
+        // clang-format on
 
-    auto result = options.parse(argc, argv);
+        const auto result = options.parse(argc, argv);
 
-    if (result["help"].as<bool>()) {
-        std::cout << options.help() << std::endl;
-        return 0;
-    }
+        if (result["help"].as<bool>()) {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
 
-    if (result["version"].as<bool>()) {
-        std::cout << "Recti, version " << RECTI_VERSION << std::endl;
+        if (result["version"].as<bool>()) {
+            std::cout << "recti, version " << RECTI_VERSION << std::endl;
+            return 0;
+        }
+
+        const auto stages = split_list(pipeline);
+        for (const auto &stage : stages) {
+            if (stage != "overlap" && stage != "decompose" && stage != "hpwl" && stage != "cts") {
+                std::cerr << "unknown stage: " << stage << std::endl;
+                return 1;
+            }
+        }
+        if (input.empty() && def.empty()) {
+            std::cerr << "no input: give --input or --def" << std::endl;
+            return 1;
+        }
+        if (!recti::instrument::enabled && !(stats.empty() && trace.empty())) {
+            std::cerr << "--stats and --trace need a build with RECTI_INSTRUMENT" << std::endl;
+            return 1;
+        }
+        if (num_threads == 0) {
+            num_threads = recti::hardware_threads();
+        }
+#ifdef RECTI_INSTRUMENT
+        recti::instrument::set_tracing(!trace.empty());
+#endif
+
+        auto layout = Layout{};
+        run_stage("load", [&]() {
+            if (!input.empty()) {
+                load_binary(input, layout);
+            }
+            if (!def.empty()) {
+                load_def(def, lef, layout);
+            }
+            if (!nets.empty()) {
+                load_nets(nets, layout);
+            }
+            return layout.rects.size() + layout.rpolygons.size() + layout.sinks.size()
+                   + layout.nets.size();
+        });
+
+        auto file = std::unique_ptr<std::ofstream>{};
+        if (output != "-") {
+            file = std::make_unique<std::ofstream>(output);
+            if (!*file) {
+                throw std::runtime_error("cannot open " + output);
+            }
+        }
+        auto &out = file ? static_cast<std::ostream &>(*file) : std::cout;
+
+        for (const auto &stage : stages) {
+            run_stage(stage, [&]() {
+                if (stage == "overlap") {
+                    return overlap_stage(layout, num_threads, out);
+                }
+                if (stage == "decompose") {
+                    return decompose_stage(layout, num_threads, out);
+                }
+                if (stage == "hpwl") {
+                    return hpwl_stage(layout, num_threads, out);
+                }
+                return cts_stage(layout, num_threads, out);
+            });
+        }
+        out.flush();
+
+#ifdef RECTI_INSTRUMENT
+        if (!stats.empty()) {
+            write_file(stats, recti::instrument::write_json);
+        }
+        if (!trace.empty()) {
+            write_file(trace, recti::instrument::write_chrome_trace);
+        }
+#endif
         return 0;
     }
 
-    auto langIt = languages.find(language);
-    if (langIt == languages.end()) {
-        std::cerr << "unknown language code: " << language << std::endl;
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+    std::ios::sync_with_stdio(false);
+    try {
+        return run(argc, argv);
+    } catch (const std::exception &error) {
+        std::cerr << "recti: " << error.what() << std::endl;
         return 1;
     }
-
-    // recti::Recti recti(name);
-    // std::cout << recti.greet(langIt->second) << std::endl;
-
-    return 0;
 }
@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <cstdio>                 // for std::remove
+#include <fstream>                // for ofstream
+#include <recti/binary_io.hpp>    // for BinaryReader, BinaryWriter
+#include <recti/polygon_set.hpp>  // for PolygonSet
+#include <stdexcept>              // for runtime_error
+#include <string>                 // for string
+#include <vector>                 // for vector
+
+#include "recti/recti.hpp"  // for Point, Rectangle, HSegment, VSegment
+
+using namespace recti;
+
+TEST_CASE("Binary IO test (round trip)") {
+    const auto path = std::string("test_binary_io_1.rbin");
+    const auto points = std::vector<Point<int>>{{1, 2}, {-3, 4}, {5, -6}};
+    const auto rects = std::vector<Rectangle<std::int64_t>>{
+        {{0, 10}, {-5, 5}}, {{1LL << 40, (1LL << 40) + 1}, {2, 3}}};
+    const auto hsegs = std::vector<HSegment<int>>{{{0, 4}, 7}};
+    const auto vsegs = std::vector<VSegment<int>>{{3, {1, 9}}, {4, {2, 8}}};
+    auto polygons = PolygonSet<int>{};
+    polygons.push_back(points);
+    polygons.push_back(gsl::span<const Point<int>>(points).first(1));  // odd size: padding
+    {
+        auto writer = binary::BinaryWriter(path);
+        writer.write<Point<int>>(points);
+        writer.write<Rectangle<std::int64_t>>(rects);
+        // streamed in pieces
+        writer.begin_section<HSegment<int>>();
+        writer.append<HSegment<int>>(hsegs);
+        writer.end_section();
+        writer.begin_section<VSegment<int>>();
+        writer.append<VSegment<int>>(gsl::span<const VSegment<int>>(vsegs).first(1));
+        writer.append<VSegment<int>>(gsl::span<const VSegment<int>>(vsegs).subspan(1));
+        writer.write(polygons);
+        writer.begin_polygon_set<int>();
+        writer.append_polygon<int>(polygons[1]);
+        writer.append_polygon<int>(polygons[0]);
+        writer.close();
+    }
+    const auto reader = binary::BinaryReader(path);
+    REQUIRE_EQ(reader.num_sections(), 6U);
+    CHECK_EQ(reader.section(1).kind, binary::Kind::rectangles);
+    CHECK_EQ(reader.section(1).count, 2U);
+
+    const auto read_points = reader.records<Point<int>>(0);
+    CHECK(std::vector<Point<int>>(read_points.begin(), read_points.end()) == points);
+    const auto read_rects = reader.records<Rectangle<std::int64_t>>(1);
+    REQUIRE_EQ(read_rects.size(), 2U);
+    CHECK_EQ(read_rects[1], rects[1]);
+    CHECK_EQ(reader.records<HSegment<int>>(2)[0], hsegs[0]);
+    const auto read_vsegs = reader.records<VSegment<int>>(3);
+    REQUIRE_EQ(read_vsegs.size(), 2U);
+    CHECK_EQ(read_vsegs[1], vsegs[1]);
+
+    const auto read_polygons = reader.polygon_set<int>(4);
+    REQUIRE_EQ(read_polygons.size(), 2U);
+    CHECK_EQ(read_polygons.num_points(), 4U);
+    CHECK_EQ(read_polygons[0].size(), 3U);
+    CHECK_EQ(read_polygons[0][2], points[2]);
+    CHECK_EQ(read_polygons[1][0], points[0]);
+    const auto streamed = reader.polygon_set<int>(5);
+    REQUIRE_EQ(streamed.size(), 2U);
+    CHECK_EQ(streamed[0].size(), 1U);
+    CHECK_EQ(streamed[1][1], points[1]);
+
+    CHECK_THROWS_AS(reader.records<Point<std::int64_t>>(0), std::runtime_error);
+    CHECK_THROWS_AS(reader.records<Rectangle<int>>(0), std::runtime_error);
+    CHECK_THROWS_AS(reader.section(6), std::out_of_range);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary IO test (invalid files)") {
+    const auto path = std::string("test_binary_io_2.rbin");
+    CHECK_THROWS_AS(binary::BinaryReader("no_such_file.rbin"), std::runtime_error);
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        file << "RECTITXT and some more bytes";
+    }
+    CHECK_THROWS_AS(binary::BinaryReader{path}, std::runtime_error);
+    {
+        const auto points = std::vector<Point<int>>{{1, 2}, {3, 4}};
+        auto writer = binary::BinaryWriter(path);
+        writer.write<Point<int>>(points);
+        CHECK_THROWS_AS(writer.append<Point<int>>(points), std::runtime_error);  // closed
+    }
+    {
+        auto file = std::ofstream(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16 + 8);  // the record count of the first section
+        const auto count = std::uint64_t{1000};
+        file.write(reinterpret_cast<const char *>(&count), sizeof count);
+    }
+    CHECK_THROWS_AS(binary::BinaryReader{path}, std::runtime_error);
+    {
+        auto file = std::ofstream(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16 + 8);
+        const auto count = (std::uint64_t{1} << 61) + 2;  // count * 8 wraps to the real 16
+        file.write(reinterpret_cast<const char *>(&count), sizeof count);
+    }
+    CHECK_THROWS_AS(binary::BinaryReader{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary IO test (corrupt offset table)") {
+    const auto path = std::string("test_binary_io_3.rbin");
+    auto polygons = PolygonSet<int>{};
+    polygons.push_back(std::vector<Point<int>>{{0, 0}, {1, 0}, {1, 1}});
+    polygons.push_back(std::vector<Point<int>>{{2, 2}, {3, 2}, {3, 3}, {2, 3}});
+    polygons.push_back(std::vector<Point<int>>{{5, 5}, {6, 6}});
+    // the offsets follow the 9 points (72 bytes) of the section
+    const auto offsets_pos = std::streamoff(16 + 32 + 72);
+    for (const auto bad : {std::uint64_t{1000}, std::uint64_t{2}, ~std::uint64_t{0}}) {
+        {
+            auto writer = binary::BinaryWriter(path);
+            writer.write(polygons);
+        }
+        REQUIRE_EQ(binary::BinaryReader{path}.polygon_set<int>(0).size(), 3U);
+        {
+            auto file = std::ofstream(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(offsets_pos + 2 * 8);  // offsets[2], an interior one (7)
+            file.write(reinterpret_cast<const char *>(&bad), sizeof bad);
+        }
+        CHECK_THROWS_AS(binary::BinaryReader{path}, std::runtime_error);
+    }
+    std::remove(path.c_str());
+}
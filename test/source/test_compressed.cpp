@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>                // for equal
+#include <cstdint>                // for int64_t
+#include <ldsgen/ilds.hpp>        // for VdCorput
+#include <limits>                 // for numeric_limits
+#include <recti/compressed.hpp>   // for CompressedSequence, CompressedPolygonSet
+#include <recti/polygon_set.hpp>  // for PolygonSet
+#include <vector>                 // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, Point
+
+using namespace recti;
+
+TEST_CASE("Compressed sequence test (rows of cells)") {
+    // 100 rows of 200 equal cells: almost every field is coded in one byte
+    auto cells = std::vector<Rectangle<int>>{};
+    for (auto row = 0; row != 100; ++row) {
+        for (auto col = 0; col != 200; ++col) {
+            const auto x = 1000000 + col * 380;
+            const auto y = 2000000 + row * 2800;
+            cells.push_back({{x, x + 380}, {y, y + 2800}});
+        }
+    }
+    const auto seq = CompressedSequence<Rectangle<int>>(cells);
+    CHECK_EQ(seq.size(), cells.size());
+    CHECK_EQ(seq.num_blocks(), (cells.size() + 63) / 64);
+    CHECK(seq.compressed_bytes() * 3 < cells.size() * sizeof(Rectangle<int>));
+    CHECK_EQ(seq.decode(), cells);
+    auto all_match = true;
+    for (auto idx = 0U; idx < cells.size(); idx += 97) {
+        all_match = all_match && seq[idx] == cells[idx];
+    }
+    CHECK(all_match);
+    auto block = std::vector<Rectangle<int>>{};
+    seq.decode_block(seq.num_blocks() - 1, block);
+    CHECK_EQ(block.size(), cells.size() % 64);
+    CHECK_EQ(block.back(), cells.back());
+}
+
+TEST_CASE("Compressed sequence test (extreme values)") {
+    using Limits = std::numeric_limits<std::int64_t>;
+    const auto pts = std::vector<Point<std::int64_t>>{
+        {Limits::max(), Limits::min()}, {Limits::min(), Limits::max()}, {0, -1}, {-5, 7}};
+    auto seq = CompressedSequence<Point<std::int64_t>>(2);
+    for (const auto &pt : pts) {
+        seq.push_back(pt);
+    }
+    CHECK_EQ(seq.decode(), pts);
+    CHECK_EQ(seq[1], pts[1]);
+    CHECK_EQ(seq[3], pts[3]);
+}
+
+TEST_CASE("Compressed polygon set test") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto set = PolygonSet<int>{};
+    auto pointset = std::vector<Point<int>>{};
+    for (auto k = 0U; k != 300; ++k) {
+        pointset.clear();
+        for (auto i = 0U; i != k % 12; ++i) {  // including empty polygons
+            pointset.emplace_back(int(hgenX.pop()) - 1000, int(hgenY.pop()) - 1000);
+        }
+        set.push_back(pointset);
+    }
+    const auto packed = CompressedPolygonSet<int>(set);
+    CHECK_EQ(packed.size(), set.size());
+    CHECK_EQ(packed.num_points(), set.num_points());
+    CHECK(packed.compressed_bytes() < set.num_points() * sizeof(Point<int>));
+
+    const auto decoded = packed.decode();
+    CHECK((decoded.points().size() == set.points().size()
+           && std::equal(decoded.points().begin(), decoded.points().end(), set.points().begin())));
+    CHECK((std::equal(decoded.offsets().begin(), decoded.offsets().end(),
+                      set.offsets().begin())));
+    auto all_match = true;
+    for (auto idx = 0U; idx < set.size(); idx += 7) {
+        packed.polygon(idx, pointset);
+        all_match = all_match && pointset.size() == set[idx].size()
+                    && std::equal(pointset.begin(), pointset.end(), set[idx].begin());
+    }
+    CHECK(all_match);
+}
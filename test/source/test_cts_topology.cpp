@@ -0,0 +1,61 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>         // for VdCorput
+#include <recti/cts_topology.hpp>  // for greedy_matching_topology
+#include <recti/dme.hpp>           // for DmeTree, ClockTopology
+#include <vector>                  // for vector
+
+#include "recti/point.hpp"  // for Point
+
+using namespace recti;
+
+static auto make_sinks(unsigned num) -> std::vector<Point<int>> {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto sinks = std::vector<Point<int>>{};
+    for (auto i = 0U; i != num; ++i) {
+        sinks.emplace_back(2 * int(hgenX.pop()), 2 * int(hgenY.pop()));
+    }
+    return sinks;
+}
+
+TEST_CASE("Greedy matching topology test (small)") {
+    auto sinks = std::vector<Point<int>>{{0, 0}, {1000, 0}, {10, 0}, {1000, 10}};
+    auto topo = greedy_matching_topology<int>(sinks);
+    CHECK_EQ(topo.num_nodes(), 7U);
+    CHECK_EQ(topo.children[0], std::pair<std::size_t, std::size_t>{0U, 2U});
+    CHECK_EQ(topo.children[1], std::pair<std::size_t, std::size_t>{1U, 3U});
+    CHECK_EQ(topo.children[2], std::pair<std::size_t, std::size_t>{4U, 5U});
+    CHECK_EQ(greedy_matching_topology<int>(gsl::span<const Point<int>>{}).num_nodes(), 0U);
+}
+
+TEST_CASE("Greedy matching topology test (1000 sinks)") {
+    const auto sinks = make_sinks(1000);
+    const auto topo = greedy_matching_topology<int>(sinks, 1);
+    const auto topo4 = greedy_matching_topology<int>(sinks, 4);
+    CHECK_EQ(topo.children, topo4.children);
+
+    auto seen = std::vector<int>(topo.num_nodes(), 0);
+    for (const auto &[left, right] : topo.children) {
+        ++seen[left];
+        ++seen[right];
+    }
+    auto bad = 0;
+    for (auto node = 0U; node != topo.root(); ++node) {
+        bad += int(seen[node] != 1);
+    }
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(seen[topo.root()], 0);
+
+    // much shorter than pairing the sinks in index (Van der Corput) order
+    auto naive = ClockTopology{sinks.size(), {}};
+    naive.children.emplace_back(0, 1);
+    for (auto i = 2U; i != sinks.size(); ++i) {
+        naive.children.emplace_back(naive.num_nodes() - 1, i);
+    }
+    auto greedy_tree = DmeTree<int>(sinks, topo);
+    greedy_tree.build();
+    auto naive_tree = DmeTree<int>(sinks, naive);
+    naive_tree.build();
+    CHECK(2 * greedy_tree.total_wire_length() < naive_tree.total_wire_length());
+}
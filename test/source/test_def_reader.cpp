@@ -0,0 +1,189 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <recti/def_reader.hpp>  // for DefReader, read_def, read_lef_macro_sizes
+#include <recti/rpolygon.hpp>    // for RPolygon
+#include <sstream>               // for istringstream
+#include <stdexcept>             // for runtime_error
+#include <string>                // for string
+#include <vector>                // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, Point
+
+using namespace recti;
+
+static const char *const test_lef = R"(VERSION 5.8 ;
+UNITS DATABASE MICRONS 1000 ; END UNITS
+MACRO INV
+  CLASS CORE ;
+  SIZE 0.4 BY 1.2 ;
+  PIN A DIRECTION INPUT ; PORT LAYER M1 ; RECT 0 0 0.1 0.1 ; END END A
+END INV
+MACRO NAND2 SIZE 0.6 BY 1.2 ; END NAND2
+END LIBRARY
+)";
+
+static const char *const test_def = R"(VERSION 5.8 ;
+DIVIDERCHAR "/" ;
+BUSBITCHARS "[]" ;
+DESIGN top ;
+UNITS DISTANCE MICRONS 1000 ;
+# a comment ; with a semicolon
+DIEAREA ( 0 0 ) ( 100000 80000 ) ;
+ROW row0 core 0 0 N DO 10 BY 1 STEP 200 0 ;
+PROPERTYDEFINITIONS
+  COMPONENTPIN text STRING "a ; b" ;
+END PROPERTYDEFINITIONS
+COMPONENTS 4 ;
+- u1 INV + PLACED ( 1000 2000 ) N ;
+- u2 NAND2 + SOURCE DIST + FIXED ( 5000 6000 ) E ;
+- u3 INV + UNPLACED ;
+- u4 UNKNOWN + PLACED ( 0 0 ) N ;
+END COMPONENTS
+PINS 2 ;
+- in + NET in + DIRECTION INPUT + LAYER M1 ( -100 0 ) ( 100 200 ) + PLACED ( 500 0 ) N ;
+- out + NET out
+  + PORT + LAYER M2 MASK 1 ( 0 0 ) ( 10 20 ) + FIXED ( 1000 1000 ) E
+  + PORT + POLYGON M2 ( 0 0 ) ( 30 0 ) ( 30 10 ) ( 10 10 ) ( 10 30 ) ( 0 30 )
+    + PLACED ( 0 0 ) N ;
+END PINS
+BLOCKAGES 2 ;
+- LAYER M1 + COMPONENT u1 RECT ( 10 10 ) ( 0 0 ) RECT ( 20 20 ) ( 30 40 ) ;
+- PLACEMENT POLYGON ( 0 0 ) ( 50 0 ) ( 100 0 ) ( * 50 ) ( 50 * ) ( * 100 ) ( 0 * ) ( 0 0 ) ;
+END BLOCKAGES
+NETS 1 ;
+- n1 ( u1 A ) ( u2 Y ) + ROUTED M1 ( 0 0 ) ( 100 * ) ;
+END NETS
+END DESIGN
+)";
+
+static auto rect(int x1, int x2, int y1, int y2) -> Rectangle<int> {
+    return Rectangle<int>{Interval<int>{x1, x2}, Interval<int>{y1, y2}};
+}
+
+// all shapes of the test design, read with small chunks and batches
+struct Shapes {
+    std::vector<Rectangle<int>> rects;
+    std::vector<def::ShapeKind> rect_kinds;
+    std::vector<accumulator_t<int>> rpolygon_areas;
+    std::size_t num_batches{0};
+};
+
+static auto collect(Shapes &shapes) {
+    return [&shapes](const def::ShapeBatch<int> &batch) {
+        shapes.rects.insert(shapes.rects.end(), batch.rects.begin(), batch.rects.end());
+        shapes.rect_kinds.insert(shapes.rect_kinds.end(), batch.rect_kinds.begin(),
+                                 batch.rect_kinds.end());
+        for (auto idx = std::size_t{0}; idx != batch.rpolygons.size(); ++idx) {
+            shapes.rpolygon_areas.push_back(RPolygon<int>(batch.rpolygons[idx]).signed_area());
+        }
+        ++shapes.num_batches;
+    };
+}
+
+static auto check_shapes(const Shapes &shapes) -> void {
+    const auto expected = std::vector<Rectangle<int>>{
+        rect(0, 100000, 0, 80000),  // DIEAREA
+        rect(1000, 1400, 2000, 3200),  rect(5000, 6200, 6000, 6600),  // u1, u2 (E)
+        rect(400, 600, 0, 200),        rect(1000, 1020, 990, 1000),   // in, out (E)
+        rect(0, 10, 0, 10),            rect(20, 30, 20, 40),          // blockages
+    };
+    CHECK(shapes.rects == expected);
+    REQUIRE_EQ(shapes.rect_kinds.size(), 7U);
+    CHECK_EQ(shapes.rect_kinds[0], def::ShapeKind::die_area);
+    CHECK_EQ(shapes.rect_kinds[2], def::ShapeKind::component);
+    CHECK_EQ(shapes.rect_kinds[4], def::ShapeKind::pin);
+    CHECK_EQ(shapes.rect_kinds[6], def::ShapeKind::blockage);
+    CHECK(shapes.rpolygon_areas == std::vector<accumulator_t<int>>{500, 7500});
+}
+
+TEST_CASE("DEF reader test (LEF macro sizes)") {
+    auto input = std::istringstream(test_lef);
+    const auto sizes = def::read_lef_macro_sizes(input);
+    REQUIRE_EQ(sizes.size(), 2U);
+    CHECK_EQ(sizes.at("INV").x(), 0.4);  // both parsed from the same text
+    CHECK_EQ(sizes.at("NAND2").y(), 1.2);
+}
+
+TEST_CASE("DEF reader test (LEF macros with OBS and PORT blocks)") {
+    auto input = std::istringstream(R"(MACRO INV
+  SIZE 0.4 BY 1.2 ;
+  PIN A
+    PORT
+      LAYER M1 ; RECT 0 0 0.1 0.1 ;
+    END
+  END A
+  OBS
+    LAYER M1 ; RECT 0.2 0.2 0.3 0.3 ;
+  END
+END INV
+MACRO NAND2
+  SIZE 0.6 BY 1.4 ;
+  OBS LAYER M1 ; RECT 0 0 0.6 0.1 ; END
+END NAND2
+END LIBRARY
+)");
+    const auto sizes = def::read_lef_macro_sizes(input);
+    REQUIRE_EQ(sizes.size(), 2U);
+    CHECK_EQ(sizes.at("INV").x(), 0.4);
+    CHECK_EQ(sizes.at("INV").y(), 1.2);
+    CHECK_EQ(sizes.at("NAND2").x(), 0.6);
+    CHECK_EQ(sizes.at("NAND2").y(), 1.4);
+}
+
+TEST_CASE("DEF reader test") {
+    auto lef = std::istringstream(test_lef);
+    const auto sizes = def::read_lef_macro_sizes(lef);
+    auto input = std::istringstream(test_def);
+    auto reader = def::DefReader<int>(input, &sizes, 16);  // tokens straddle the chunks
+    auto shapes = Shapes{};
+    def::read_def(reader, collect(shapes), 2);
+    CHECK_EQ(reader.dbu(), 1000);
+    check_shapes(shapes);
+    CHECK_EQ(shapes.num_batches, 5U);
+
+    auto batch = def::ShapeBatch<int>{};
+    CHECK(!reader.read(batch));
+    CHECK(batch.empty());
+}
+
+TEST_CASE("DEF reader test (pipelined)") {
+    auto lef = std::istringstream(test_lef);
+    const auto sizes = def::read_lef_macro_sizes(lef);
+    for (const auto batch_size : {std::size_t{1}, std::size_t{3}, std::size_t{4096}}) {
+        auto input = std::istringstream(test_def);
+        auto reader = def::DefReader<int>(input, &sizes, 32);
+        auto shapes = Shapes{};
+        def::read_def_pipelined(reader, collect(shapes), batch_size);
+        check_shapes(shapes);
+    }
+}
+
+TEST_CASE("DEF reader test (errors)") {
+    auto bad_polygon = std::istringstream(
+        "BLOCKAGES 1 ;\n- PLACEMENT POLYGON ( 0 0 ) ( 10 5 ) ( 0 10 ) ;\nEND BLOCKAGES\n");
+    auto reader = def::DefReader<int>(bad_polygon);
+    auto batch = def::ShapeBatch<int>{};
+    CHECK_THROWS_AS(reader.read(batch), std::runtime_error);
+
+    auto truncated = std::istringstream("PINS 1 ;\n- p + NET p + LAYER M1 ( 0 0 )");
+    auto reader2 = def::DefReader<int>(truncated);
+    CHECK_THROWS_AS(def::read_def_pipelined(reader2, [](const def::ShapeBatch<int> &) {}),
+                    std::runtime_error);
+
+    auto input = std::istringstream(test_def);
+    auto reader3 = def::DefReader<int>(input);
+    auto throwing = [](const def::ShapeBatch<int> &) { throw std::logic_error("consumer"); };
+    CHECK_THROWS_AS(def::read_def_pipelined(reader3, throwing, 1), std::logic_error);
+}
+
+TEST_CASE("DEF reader test (orientations)") {
+    const auto pt = Point<int>{1, 2};
+    CHECK_EQ(def::orient_point(def::Orient::N, pt), Point<int>{1, 2});
+    CHECK_EQ(def::orient_point(def::Orient::W, pt), Point<int>{-2, 1});
+    CHECK_EQ(def::orient_point(def::Orient::S, pt), Point<int>{-1, -2});
+    CHECK_EQ(def::orient_point(def::Orient::E, pt), Point<int>{2, -1});
+    CHECK_EQ(def::orient_point(def::Orient::FN, pt), Point<int>{-1, 2});
+    CHECK_EQ(def::orient_point(def::Orient::FS, pt), Point<int>{1, -2});
+    CHECK_EQ(def::orient_point(def::Orient::FW, pt), Point<int>{-2, -1});
+    CHECK_EQ(def::orient_point(def::Orient::FE, pt), Point<int>{2, 1});
+}
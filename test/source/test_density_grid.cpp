@@ -0,0 +1,104 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>               // for equal
+#include <ldsgen/ilds.hpp>         // for VdCorput
+#include <recti/density_grid.hpp>  // for DensityGrid
+#include <vector>                  // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, HSegment, VSegment
+
+using namespace recti;
+
+static auto make_rects(std::size_t num) -> std::vector<Rectangle<int>> {
+    auto hgen_x = ildsgen::VdCorput(2, 7);
+    auto hgen_y = ildsgen::VdCorput(3, 7);
+    auto rects = std::vector<Rectangle<int>>{};
+    for (auto idx = std::size_t{0}; idx != num; ++idx) {
+        const auto x = int(hgen_x.pop() % 130) - 10;  // some stick out of the grid
+        const auto y = int(hgen_y.pop() % 100) - 10;
+        const auto width = int(idx % 23);
+        const auto height = int(idx % 17);
+        rects.push_back({{x, x + width}, {y, y + height}});
+    }
+    return rects;
+}
+
+// the overlap area of every rectangle with every bin
+static auto brute_bin(const DensityGrid<int> &grid, const std::vector<Rectangle<int>> &rects,
+                      std::size_t ix, std::size_t iy) -> double {
+    const auto cell = grid.bin_rect(ix, iy);
+    auto total = 0.0;
+    for (const auto &rect : rects) {
+        if (cell.overlaps(rect)) {
+            const auto clip = cell.intersect_with(rect);
+            total += double(clip.xcoord().length()) * double(clip.ycoord().length());
+        }
+    }
+    return total;
+}
+
+TEST_CASE("Density grid test (rectangles)") {
+    const auto rects = make_rects(300);
+    auto grid = DensityGrid<int>(Point<int>{0, 0}, 10, 8, 10, 10);
+    CHECK_EQ(grid.region(), Rectangle<int>{{0, 100}, {0, 80}});
+    for (const auto &rect : rects) {
+        grid.add(rect);
+    }
+    auto all_match = true;
+    for (auto iy = std::size_t{0}; iy != grid.num_y(); ++iy) {
+        for (auto ix = std::size_t{0}; ix != grid.num_x(); ++ix) {
+            all_match = all_match && grid.bin(ix, iy) == brute_bin(grid, rects, ix, iy);
+        }
+    }
+    CHECK(all_match);
+}
+
+TEST_CASE("Density grid test (segments and points)") {
+    auto grid = DensityGrid<int>(Point<int>{-50, -50}, 25, 25, 4, 4);
+    grid.add(HSegment<int>{{-60, 10}, 0});         // clipped to [-50, 10], row 2
+    grid.add(VSegment<int>{-50, {-50, 50}}, 2.0);  // the left boundary, column 0
+    grid.add(VSegment<int>{100, {-50, 50}});       // outside
+    grid.add(Point<int>{50, 50});                  // the upper right corner
+    grid.add(Point<int>{-24, -24}, 3.0);
+    CHECK_EQ(grid.bin(0, 2), 25.0 + 2.0 * 25.0);
+    CHECK_EQ(grid.bin(1, 2), 25.0);
+    CHECK_EQ(grid.bin(2, 2), 10.0);
+    CHECK_EQ(grid.bin(0, 0), 50.0);
+    CHECK_EQ(grid.bin(0, 3), 50.0);
+    CHECK_EQ(grid.bin(3, 3), 1.0);
+    CHECK_EQ(grid.bin(0, 1), 50.0);
+    CHECK_EQ(grid.bin(1, 1), 3.0);
+}
+
+TEST_CASE("Density grid test (shards and prefix sums)") {
+    const auto rects = make_rects(20000);
+    auto serial = DensityGrid<int>(Point<int>{0, 0}, 10, 8, 10, 10);
+    auto sharded = serial;
+    serial.add_all<Rectangle<int>>(rects);
+    sharded.add_all<Rectangle<int>>(rects, 1.0, 4);
+    CHECK(std::equal(serial.bins().begin(), serial.bins().end(), sharded.bins().begin()));
+
+    CHECK(!sharded.has_prefix_sums());
+    sharded.build_prefix_sums();
+    auto all_match = true;
+    for (auto iy0 = std::size_t{0}; iy0 < 10; iy0 += 3) {
+        for (auto ix0 = std::size_t{0}; ix0 < 10; ix0 += 2) {
+            for (auto iy1 = iy0; iy1 <= 10; iy1 += 4) {
+                for (auto ix1 = ix0; ix1 <= 10; ix1 += 3) {
+                    auto sum = 0.0;
+                    for (auto iy = iy0; iy != iy1; ++iy) {
+                        for (auto ix = ix0; ix != ix1; ++ix) {
+                            sum += serial.bin(ix, iy);
+                        }
+                    }
+                    all_match = all_match && sharded.window_sum(ix0, iy0, ix1, iy1) == sum;
+                }
+            }
+        }
+    }
+    CHECK(all_match);
+    sharded.add(Point<int>{1, 1});
+    CHECK(!sharded.has_prefix_sums());
+    sharded.clear();
+    CHECK_EQ(sharded.bin(0, 0), 0.0);
+}
@@ -0,0 +1,207 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>  // for VdCorput
+#include <recti/dme.hpp>    // for DmeTree, ClockTopology, ElmoreDelay
+#include <vector>           // for vector
+
+#include "recti/point.hpp"  // for Point, min_dist
+
+using namespace recti;
+
+/**
+ * @brief Pair up the nodes level by level (sinks in index order).
+ */
+static auto balanced_topology(std::size_t num_sinks) -> ClockTopology {
+    auto topo = ClockTopology{num_sinks, {}};
+    auto level = std::vector<std::size_t>{};
+    for (auto i = 0U; i != num_sinks; ++i) {
+        level.push_back(i);
+    }
+    while (level.size() > 1) {
+        auto next = std::vector<std::size_t>{};
+        for (auto i = 0U; i + 1 < level.size(); i += 2) {
+            topo.children.emplace_back(level[i], level[i + 1]);
+            next.push_back(topo.num_nodes() - 1);
+        }
+        if (level.size() % 2 == 1) {
+            next.push_back(level.back());
+        }
+        level = std::move(next);
+    }
+    return topo;
+}
+
+static auto sink_delay(const DmeTree<int> &tree, std::size_t node) -> int {
+    auto delay = 0;
+    for (; tree.parent(node) != DmeTree<int>::npos; node = tree.parent(node)) {
+        delay += tree.wire_length(node);
+    }
+    return delay;
+}
+
+TEST_CASE("DmeTree test (two sinks)") {
+    auto sinks = std::vector<Point<int>>{{400, 400}, {700, 700}};
+    auto tree = DmeTree<int>(sinks, balanced_topology(2));
+    tree.build();
+    CHECK_EQ(tree.region(2), MergeObj<Interval<int>>(Interval<int>{1100, 1100},
+                                                      Interval<int>{-300, 300}));
+    CHECK_EQ(tree.delay(2), 300);
+    CHECK_EQ(tree.total_wire_length(), 600);
+    CHECK_EQ(min_dist(tree.position(2), sinks[0]), 300);
+    CHECK_EQ(min_dist(tree.position(2), sinks[1]), 300);
+}
+
+TEST_CASE("DmeTree test (detour)") {
+    // the third sink is right next to the root of the first two
+    auto sinks = std::vector<Point<int>>{{0, 0}, {1000, 0}, {500, 20}};
+    auto topo = ClockTopology{3, {{0, 1}, {3, 2}}};
+    auto tree = DmeTree<int>(sinks, topo);
+    tree.build();
+    CHECK_EQ(sink_delay(tree, 0), sink_delay(tree, 2));
+    CHECK_EQ(tree.wire_length(2), 500);
+}
+
+TEST_CASE("DmeTree test (zero skew, parallel)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto sinks = std::vector<Point<int>>{};
+    for (auto i = 0U; i != 3000; ++i) {
+        sinks.emplace_back(2 * int(hgenX.pop()), 2 * int(hgenY.pop()));
+    }
+    auto serial = DmeTree<int>(sinks, balanced_topology(sinks.size()));
+    serial.build(1);
+    auto threaded = DmeTree<int>(sinks, balanced_topology(sinks.size()));
+    threaded.build(4);
+
+    const auto root = serial.topology().root();
+    CHECK_EQ(serial.total_wire_length(), threaded.total_wire_length());
+    CHECK_EQ(serial.position(root), threaded.position(root));
+
+    auto max_skew = 0;
+    auto misplaced = 0;
+    for (auto i = 0U; i != sinks.size(); ++i) {
+        auto skew = serial.delay(root) - sink_delay(serial, i);
+        max_skew = std::max(max_skew, skew < 0 ? -skew : skew);
+    }
+    for (auto node = 0U; node != root; ++node) {
+        const auto par = serial.parent(node);
+        misplaced += int(min_dist(serial.position(node), serial.position(par))
+                         > serial.wire_length(node));
+    }
+    CHECK(max_skew <= 12);  // one unit of rounding per level at most
+    CHECK_EQ(misplaced, 0);
+}
+
+TEST_CASE("DmeTree test (bounded skew)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto sinks = std::vector<Point<int>>{};
+    for (auto i = 0U; i != 1000U; ++i) {
+        sinks.emplace_back(2 * int(hgenX.pop()), 2 * int(hgenY.pop()));
+    }
+    auto zero = DmeTree<int>(sinks, balanced_topology(sinks.size()));
+    zero.build();
+    auto bounded = DmeTree<int>(sinks, balanced_topology(sinks.size()), 200);
+    bounded.build();
+    CHECK_EQ(bounded.skew_bound(), 200);
+
+    const auto root = bounded.topology().root();
+    auto longest = 0;
+    auto shortest = sink_delay(bounded, 0);
+    for (auto i = 0U; i != sinks.size(); ++i) {
+        longest = std::max(longest, sink_delay(bounded, i));
+        shortest = std::min(shortest, sink_delay(bounded, i));
+    }
+    CHECK(longest - shortest <= 200 + 10);  // one unit of rounding per level at most
+    CHECK(longest <= bounded.delay(root) + 10);
+    CHECK(bounded.min_delay(root) <= shortest + 10);
+    CHECK(bounded.total_wire_length() < zero.total_wire_length());
+    for (auto node = 0U; node != root; ++node) {
+        const auto par = bounded.parent(node);
+        CHECK(min_dist(bounded.position(node), bounded.position(par))
+              <= bounded.wire_length(node));
+    }
+}
+
+TEST_CASE("DmeTree test (incremental re-embedding)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto sinks = std::vector<Point<int>>{};
+    for (auto i = 0U; i != 500U; ++i) {
+        sinks.emplace_back(2 * int(hgenX.pop()), 2 * int(hgenY.pop()));
+    }
+    for (const auto skew_bound : {0, 100}) {
+        auto tree = DmeTree<int>(sinks, balanced_topology(sinks.size()), skew_bound);
+        tree.build();
+        const auto moved = std::vector<std::size_t>{3, 4, 250};
+        const auto positions = std::vector<Point<int>>{{10, 20}, {1500, 40}, {600, 600}};
+        auto updated = sinks;
+        for (auto i = 0U; i != moved.size(); ++i) {
+            updated[moved[i]] = positions[i];
+        }
+        CHECK(tree.move_sinks(moved, positions) <= 2 * 9U);  // two paths of height 9
+        auto rebuilt = DmeTree<int>(updated, balanced_topology(sinks.size()), skew_bound);
+        rebuilt.build();
+        CHECK_EQ(tree.total_wire_length(), rebuilt.total_wire_length());
+        for (auto node = 0U; node != tree.topology().num_nodes(); ++node) {
+            CHECK_EQ(tree.position(node), rebuilt.position(node));
+            CHECK_EQ(tree.delay(node), rebuilt.delay(node));
+        }
+    }
+}
+
+static auto elmore_sink_delay(const DmeTree<int, ElmoreDelay<int>> &tree, std::size_t node)
+    -> double {
+    auto delay = 0.0;
+    for (; tree.parent(node) != DmeTree<int>::npos; node = tree.parent(node)) {
+        delay += tree.delay_model().wire_delay(tree.wire_length(node), tree.load(node));
+    }
+    return delay;
+}
+
+TEST_CASE("DmeTree test (Elmore delay)") {
+    const auto model = ElmoreDelay<int>{0.1, 0.2, 10.0};
+    auto two = DmeTree<int, ElmoreDelay<int>>(std::vector<Point<int>>{{400, 400}, {700, 700}},
+                                              balanced_topology(2), model);
+    two.build();
+    CHECK_EQ(two.region(2), DmeTree<int>::Region(Interval<int>{1100, 1100},
+                                                 Interval<int>{-300, 300}));
+    CHECK_EQ(two.load(2), 10.0 + 10.0 + 0.2 * 600);
+
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto sinks = std::vector<Point<int>>{};
+    for (auto i = 0U; i != 1000U; ++i) {
+        sinks.emplace_back(2 * int(hgenX.pop()), 2 * int(hgenY.pop()));
+    }
+    sinks.emplace_back(100, 100);  // an unbalanced subtree at the top
+    auto topo = balanced_topology(sinks.size() - 1);
+    topo.num_sinks = sinks.size();
+    for (auto &[left, right] : topo.children) {
+        left += std::size_t(left >= sinks.size() - 1);
+        right += std::size_t(right >= sinks.size() - 1);
+    }
+    topo.children.emplace_back(topo.num_nodes() - 1, sinks.size() - 1);
+    auto serial = DmeTree<int, ElmoreDelay<int>>(sinks, topo, model);
+    serial.build(1);
+    auto threaded = DmeTree<int, ElmoreDelay<int>>(sinks, topo, model);
+    threaded.build(4);
+    CHECK_EQ(serial.total_wire_length(), threaded.total_wire_length());
+
+    const auto root = serial.topology().root();
+    auto longest = 0.0;
+    auto shortest = elmore_sink_delay(serial, 0);
+    for (auto i = 0U; i != sinks.size(); ++i) {
+        longest = std::max(longest, elmore_sink_delay(serial, i));
+        shortest = std::min(shortest, elmore_sink_delay(serial, i));
+    }
+    CHECK(longest <= serial.delay(root) * 1.001);
+    CHECK(shortest >= serial.min_delay(root) * 0.999);
+    CHECK(longest - shortest < 0.01 * longest);  // unit rounding of the wire lengths only
+
+    // the linear model balances path lengths instead, leaving an Elmore skew
+    auto linear = DmeTree<int>(sinks, topo);
+    linear.build();
+    CHECK_EQ(linear.delay(root), linear.min_delay(root));
+    CHECK(linear.total_wire_length() != serial.total_wire_length());
+}
@@ -0,0 +1,52 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <recti/halton_int.hpp>  // for VdcorputTable, HaltonTable, Vdcorput
+#include <recti/parallel.hpp>    // for parallel_for
+#include <vector>                // for vector
+
+#include "recti/point.hpp"  // for Point
+
+using namespace recti;
+
+TEST_CASE("VdcorputTable test (same as Vdcorput)") {
+    for (const auto &[base, scale] : {std::pair{2U, 10U}, std::pair{2U, 31U}, std::pair{3U, 7U},
+                                      std::pair{5U, 5U}, std::pair{7U, 3U}, std::pair{11U, 9U}}) {
+        auto ref = Vdcorput(base, scale);
+        auto gen = VdcorputTable(base, scale);
+        auto mismatches = 0;
+        for (auto i = 1U; i != 5000; ++i) {
+            const auto val = ref();
+            mismatches += int(gen() != val);
+            mismatches += int(gen.at(i) != val);
+        }
+        CHECK_EQ(mismatches, 0);
+        gen.reseed(123456);
+        ref.reseed(123456);
+        CHECK_EQ(gen(), ref());
+        CHECK_EQ(gen(), ref());
+    }
+}
+
+TEST_CASE("HaltonTable test (parallel jump-ahead)") {
+    const unsigned base[] = {2, 3};
+    const unsigned scale[] = {11, 7};
+    auto ref = halton(base, scale);
+    auto expected = std::vector<Point<unsigned>>{};
+    for (auto i = 0; i != 4000; ++i) {
+        const auto res = ref();
+        expected.emplace_back(res[0], res[1]);
+    }
+
+    auto pts = std::vector<Point<unsigned>>(expected.size(), Point<unsigned>{0U, 0U});
+    const auto block = std::size_t{1000};
+    parallel_for(
+        0, pts.size() / block,
+        [&](std::size_t idx) {
+            auto gen = HaltonTable(base, scale);
+            gen.reseed(unsigned(idx * block));
+            gen.fill(gsl::span<Point<unsigned>>(pts).subspan(idx * block, block));
+        },
+        4);
+    CHECK_EQ(pts, expected);
+    CHECK_EQ(HaltonTable(base, scale).at(4000), expected.back());
+}
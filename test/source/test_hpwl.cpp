@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>        // for find
+#include <ldsgen/ilds.hpp>  // for VdCorput
+#include <recti/hpwl.hpp>   // for HpwlNetlist
+#include <vector>           // for vector
+
+#include "recti/recti.hpp"  // for Point, Vector2
+
+using namespace recti;
+
+struct TestNetlist {
+    std::vector<std::size_t> net_offsets{0};
+    std::vector<std::size_t> pin_cells;
+    std::vector<Vector2<int>> pin_offsets;
+    std::vector<Point<int>> cells;
+};
+
+// a small-grid netlist, so that many pins share the sides of their net bounding boxes
+static auto make_netlist(std::size_t num_cells, std::size_t num_nets) -> TestNetlist {
+    auto hgen_cell = ildsgen::VdCorput(3, 7);
+    auto hgen_x = ildsgen::VdCorput(2, 3);
+    auto hgen_y = ildsgen::VdCorput(3, 2);
+    auto netlist = TestNetlist{};
+    for (auto cell = std::size_t{0}; cell != num_cells; ++cell) {
+        netlist.cells.emplace_back(int(hgen_x.pop() % 16), int(hgen_y.pop() % 16));
+    }
+    for (auto net = std::size_t{0}; net != num_nets; ++net) {
+        const auto degree = net % 7;  // includes empty and single-pin nets
+        for (auto pin = std::size_t{0}; pin != degree; ++pin) {
+            netlist.pin_cells.push_back(std::size_t(hgen_cell.pop() % num_cells));
+            netlist.pin_offsets.emplace_back(int(pin % 3), int(pin % 2));
+        }
+        netlist.net_offsets.push_back(netlist.pin_cells.size());
+    }
+    return netlist;
+}
+
+// the reference: `hull_with` over the pins of each net
+static auto brute_hpwl(const TestNetlist &netlist, const std::vector<Point<int>> &cells,
+                       std::size_t net) -> int {
+    const auto first = netlist.net_offsets[net];
+    const auto last = netlist.net_offsets[net + 1];
+    if (first == last) {
+        return 0;
+    }
+    auto pin_point = [&](std::size_t pin) {
+        return cells[netlist.pin_cells[pin]] + netlist.pin_offsets[pin];
+    };
+    auto box = pin_point(first).hull_with(pin_point(first));
+    for (auto pin = first + 1; pin != last; ++pin) {
+        box = box.hull_with(pin_point(pin));
+    }
+    return box.xcoord().length() + box.ycoord().length();
+}
+
+static auto brute_total(const TestNetlist &netlist, const std::vector<Point<int>> &cells) -> int {
+    auto total = 0;
+    for (auto net = std::size_t{0}; net + 1 != netlist.net_offsets.size(); ++net) {
+        total += brute_hpwl(netlist, cells, net);
+    }
+    return total;
+}
+
+TEST_CASE("HPWL test") {
+    auto netlist = make_netlist(50, 200);
+    auto engine = HpwlNetlist<int>(netlist.net_offsets, netlist.pin_cells, netlist.pin_offsets,
+                                   netlist.cells);
+    CHECK_EQ(engine.num_nets(), 200U);
+    CHECK_EQ(engine.num_cells(), 50U);
+    CHECK_EQ(engine.total(), brute_total(netlist, netlist.cells));
+    CHECK_EQ(engine.hpwl(0), 0);
+    for (auto net = std::size_t{0}; net != engine.num_nets(); ++net) {
+        CHECK_EQ(engine.hpwl(net), brute_hpwl(netlist, netlist.cells, net));
+    }
+    const auto box = engine.bounding_box(1);  // a single pin
+    CHECK_EQ(box.xcoord().length(), 0);
+    CHECK_EQ(box.ycoord().length(), 0);
+}
+
+TEST_CASE("HPWL test (incremental moves)") {
+    auto netlist = make_netlist(50, 200);
+    auto engine = HpwlNetlist<int>(netlist.net_offsets, netlist.pin_cells, netlist.pin_offsets,
+                                   netlist.cells);
+    auto cells = netlist.cells;
+    auto hgen_cell = ildsgen::VdCorput(5, 11);
+    auto hgen_x = ildsgen::VdCorput(2, 5);
+    auto hgen_y = ildsgen::VdCorput(3, 5);
+    auto all_match = true;
+    for (auto step = 0U; step != 300; ++step) {
+        auto moved = std::vector<std::size_t>{};
+        auto positions = std::vector<Point<int>>{};
+        const auto num_moved = 1U + step % 3;
+        for (auto idx = 0U; idx != num_moved; ++idx) {
+            const auto cell = std::size_t(hgen_cell.pop() % 50);
+            if (std::find(moved.begin(), moved.end(), cell) != moved.end()) {
+                continue;
+            }
+            moved.push_back(cell);
+            positions.emplace_back(int(hgen_x.pop() % 16), int(hgen_y.pop() % 16));
+            cells[cell] = positions.back();
+        }
+        const auto before = engine.total();
+        const auto delta = engine.move_cells(moved, positions);
+        const auto expected = brute_total(netlist, cells);
+        all_match = all_match && engine.total() == expected && before + delta == expected;
+    }
+    CHECK(all_match);
+    for (auto net = std::size_t{0}; net != engine.num_nets(); ++net) {
+        CHECK_EQ(engine.hpwl(net), brute_hpwl(netlist, cells, net));
+    }
+    for (auto cell = std::size_t{0}; cell != engine.num_cells(); ++cell) {
+        CHECK_EQ(engine.cell(cell), cells[cell]);
+    }
+}
+
+TEST_CASE("HPWL test (threads)") {
+    auto netlist = make_netlist(2000, 5000);
+    auto serial = HpwlNetlist<int>(netlist.net_offsets, netlist.pin_cells, netlist.pin_offsets,
+                                   netlist.cells);
+    auto threaded = HpwlNetlist<int>(netlist.net_offsets, netlist.pin_cells, netlist.pin_offsets,
+                                     netlist.cells, 4);
+    CHECK_EQ(serial.total(), threaded.total());
+    CHECK_EQ(serial.total(), brute_total(netlist, netlist.cells));
+    threaded.update_all(0);
+    CHECK_EQ(serial.total(), threaded.total());
+}
@@ -0,0 +1,81 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <cstring>                // for strcmp
+#include <recti/instrument.hpp>   // for Probe, name_of, summary, write_json, ...
+#include <recti/merge_obj.hpp>          // for MergeObj
+#include <recti/overlap_sweep.hpp>      // for overlapping_pairs
+#include <recti/parallel.hpp>           // for parallel_for
+#include <recti/rtree.hpp>              // for StaticRTree
+#include <recti/segment_crossings.hpp>  // for crossing_pairs, count_crossings
+#include <sstream>                      // for ostringstream
+#include <string>                       // for string
+#include <vector>                       // for vector
+
+#include "recti/recti.hpp"  // for Rectangle
+
+using namespace recti;
+
+TEST_CASE("Instrument probe names") {
+    CHECK_EQ(instrument::num_probes, 17U);
+    CHECK(std::strcmp(instrument::name_of(instrument::Probe::overlap), "overlap") == 0);
+    CHECK(std::strcmp(instrument::name_of(instrument::Probe::hpwl_move_cells), "hpwl_move_cells")
+          == 0);
+    // the constexpr kernels stay usable at compile time either way
+    static_assert(overlap(Rectangle<int>{{0, 2}, {0, 2}}, Rectangle<int>{{1, 3}, {1, 3}}));
+}
+
+#ifdef RECTI_INSTRUMENT
+TEST_CASE("Instrument counters and trace") {
+    using instrument::Probe;
+    instrument::reset();
+    instrument::set_tracing(true);
+
+    auto rects = std::vector<Rectangle<int>>{};
+    for (auto idx = 0; idx != 100; ++idx) {
+        rects.emplace_back(Interval<int>{idx * 10, idx * 10 + 15}, Interval<int>{0, 10});
+    }
+    const auto tree = StaticRTree<int>(rects);
+    for (auto idx = 0; idx != 10; ++idx) {
+        CHECK_FALSE(tree.query(Rectangle<int>{{idx * 100, idx * 100 + 1}, {0, 1}}).empty());
+    }
+    const auto lhs = MergeObj<int>{4, 0};
+    const auto rhs = MergeObj<int>{0, 6};
+    static_cast<void>(lhs.merge_with(rhs));
+    // a multi-strip sweep is one call, timed at its entry point
+    auto many = std::vector<Rectangle<int>>{};
+    auto hsegs = std::vector<HSegment<int>>{};
+    auto vsegs = std::vector<VSegment<int>>{};
+    for (auto idx = 0; idx != 4096; ++idx) {
+        many.emplace_back(Interval<int>{idx, idx + 2}, Interval<int>{0, 10});
+        hsegs.emplace_back(Interval<int>{idx, idx + 2}, idx % 7);
+        vsegs.emplace_back(idx, Interval<int>{0, 10});
+    }
+    CHECK_FALSE(overlapping_pairs<int>(many, 4).empty());
+    CHECK_FALSE(crossing_pairs<int>(hsegs, vsegs, 4).empty());
+    CHECK(count_crossings<int>(hsegs, vsegs, 4) > 0U);
+    // per-thread counters are added up across the threads
+    parallel_for(std::size_t{0}, std::size_t{10000},
+                 [](std::size_t) { instrument::count(Probe::contain); }, 4, 16);
+
+    const auto totals = instrument::summary();
+    CHECK_EQ(totals.calls[std::size_t(Probe::rtree_build)], 1U);
+    CHECK_EQ(totals.calls[std::size_t(Probe::rtree_query)], 10U);
+    CHECK_EQ(totals.calls[std::size_t(Probe::merge_with)], 1U);
+    CHECK_EQ(totals.calls[std::size_t(Probe::overlap_sweep)], 1U);
+    CHECK_EQ(totals.calls[std::size_t(Probe::segment_crossings)], 2U);
+    CHECK_EQ(totals.calls[std::size_t(Probe::contain)], 10000U);
+    CHECK(totals.calls[std::size_t(Probe::overlap)] > 10U);
+
+    auto json = std::ostringstream{};
+    instrument::write_json(json);
+    CHECK(json.str().find("\"rtree_query\": {\"calls\": 10,") != std::string::npos);
+    auto trace = std::ostringstream{};
+    instrument::write_chrome_trace(trace);
+    CHECK(trace.str().find("\"name\": \"rtree_build\", \"cat\": \"recti\", \"ph\": \"X\"")
+          != std::string::npos);
+
+    instrument::set_tracing(false);
+    instrument::reset();
+    CHECK_EQ(instrument::summary().calls[std::size_t(Probe::contain)], 0U);
+}
+#endif
@@ -116,3 +116,35 @@ TEST_CASE("Interval overlapping test") {
         }
     }
 }
+
+TEST_CASE("Interval test (scalar fast paths)") {
+    static_assert(noexcept(Interval{1, 2}.overlaps(Interval{2, 3})));
+    static_assert(noexcept(recti::min_dist(1, 2)));
+    static_assert(Interval{1, 4}.intersect_with(Interval{2, 6}) == Interval{2, 4});
+    static_assert(Interval{1, 4}.hull_with(7) == Interval{1, 7});
+    static_assert(Interval{1, 4}.min_dist_with(Interval{-6, -2}) == 3);
+    static_assert(recti::min_dist(3U, 5U) == 2U);
+
+    // the fast paths (same coordinate type) must agree with the generic ones (mixed types)
+    auto hgen = ildsgen::VdCorput(3, 7);
+    for (auto i = 0; i != 500; ++i) {
+        const auto lb1 = int(hgen.pop()) - 1000;
+        const auto ub1 = lb1 + int(hgen.pop() % 300);
+        const auto lb2 = int(hgen.pop()) - 1000;
+        const auto ub2 = lb2 + int(hgen.pop() % 300);
+        const auto a = Interval<int>{lb1, ub1};
+        const auto b = Interval<int>{lb2, ub2};
+        const auto c = Interval<short>{short(lb2), short(ub2)};
+        CHECK_EQ(a.overlaps(b), a.overlaps(c));
+        CHECK_EQ(a.contains(b), a.contains(c));
+        CHECK_EQ(a.contains(lb2), a.contains(short(lb2)));
+        CHECK_EQ(a.intersect_with(b), a.intersect_with(c));
+        CHECK_EQ(a.hull_with(b), a.hull_with(c));
+        const auto gap = lb2 > ub1 ? lb2 - ub1 : lb1 > ub2 ? lb1 - ub2 : 0;
+        CHECK_EQ(a.min_dist_with(b), gap);
+        CHECK_EQ(a.min_dist_with(lb2), lb2 > ub1 ? lb2 - ub1 : lb1 > lb2 ? lb1 - lb2 : 0);
+        const auto d = Interval<short>{short(lb1), short(ub1)};
+        CHECK_EQ(d.min_dist_with(c), gap);
+        CHECK_EQ(min_dist(d, short(lb2)), a.min_dist_with(lb2));
+    }
+}
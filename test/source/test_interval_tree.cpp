@@ -0,0 +1,61 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>                // for sort
+#include <ldsgen/ilds.hpp>          // for VdCorput
+#include <recti/interval_tree.hpp>  // for IntervalTree
+#include <vector>                   // for vector
+
+#include "recti/interval.hpp"  // for Interval, overlap
+
+using namespace recti;
+
+TEST_CASE("IntervalTree test") {
+    auto tree = IntervalTree<int>{};
+    tree.insert(Interval<int>{1, 3}, 0);
+    tree.insert(Interval<int>{3, 5}, 1);
+    tree.insert(Interval<int>{7, 9}, 2);
+    CHECK_EQ(tree.size(), 3U);
+
+    auto stabbed = std::vector<std::size_t>{};
+    tree.stab(3, [&stabbed](const Interval<int> &, std::size_t val) { stabbed.push_back(val); });
+    CHECK_EQ(stabbed, std::vector<std::size_t>{0U, 1U});
+    CHECK_EQ(tree.overlapping(Interval<int>{5, 7}), std::vector<std::size_t>{1U, 2U});
+    CHECK(!tree.overlaps(Interval<int>{10, 12}));
+
+    CHECK(tree.erase(Interval<int>{3, 5}, 1));
+    CHECK(!tree.erase(Interval<int>{3, 5}, 1));
+    CHECK_EQ(tree.overlapping(Interval<int>{5, 7}), std::vector<std::size_t>{2U});
+    CHECK_EQ(tree.size(), 2U);
+}
+
+TEST_CASE("IntervalTree test (against linear scan)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenW = ildsgen::VdCorput(2, 5);
+    auto intervals = std::vector<Interval<int>>{};
+    auto tree = IntervalTree<int>{};
+    for (auto i = 0U; i != 2000; ++i) {
+        auto lb = int(hgenX.pop());
+        intervals.emplace_back(lb, lb + int(hgenW.pop()));
+        tree.insert(intervals.back(), i);
+    }
+    for (auto i = 0U; i < 2000; i += 3) {
+        CHECK(tree.erase(intervals[i], i));
+    }
+    CHECK_EQ(tree.size(), 2000U - 667U);
+
+    auto failures = 0;
+    for (auto lb = 0; lb < 2187; lb += 97) {
+        auto query = Interval<int>{lb, lb + 13};
+        auto expected = std::vector<std::size_t>{};
+        for (auto i = 0U; i != 2000; ++i) {
+            if (i % 3 != 0 && overlap(intervals[i], query)) {
+                expected.push_back(i);
+            }
+        }
+        auto found = tree.overlapping(query);
+        std::sort(found.begin(), found.end());
+        failures += int(found != expected);
+        failures += int(tree.overlaps(query) != !expected.empty());
+    }
+    CHECK_EQ(failures, 0);
+}
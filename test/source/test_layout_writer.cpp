@@ -0,0 +1,96 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>           // for VdCorput
+#include <recti/layout_writer.hpp>   // for LayoutWriter
+#include <recti/polygon.hpp>         // for Polygon, create_ymono_polygon
+#include <recti/rpolygon.hpp>        // for RPolygon, create_ymono_rpolygon
+#include <sstream>                   // for ostringstream
+#include <string>                    // for string
+#include <vector>                    // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, Point
+
+using namespace recti;
+
+static auto count_of(const std::string &text, const std::string &word) -> std::size_t {
+    auto count = std::size_t{0};
+    for (auto pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+TEST_CASE("Layout writer test (SVG)") {
+    auto out = std::ostringstream{};
+    const auto viewport = Rectangle<int>{Interval<int>{0, 100}, Interval<int>{0, 50}};
+    {
+        auto writer = LayoutWriter<int>(out, LayoutFormat::svg, viewport, 2.0, 3.0);
+        CHECK(writer.rectangle({{10, 20}, {0, 5}}));
+        CHECK(!writer.rectangle({{200, 300}, {0, 5}}));  // outside the viewport
+        CHECK(!writer.rectangle({{10, 11}, {0, 1}}));    // below 3 output units
+        CHECK(writer.rectangle({{10, 11}, {0, 40}}));    // thin but long
+        const auto pts = std::vector<Point<int>>{{0, 0}, {10, 10}, {5, 20}};
+        writer.style("none", "red");
+        CHECK(writer.rpolygon(pts));
+        CHECK(writer.polygon(pts));
+        CHECK(writer.point({50, 25}, 1.5));
+        CHECK(!writer.point({150, 25}, 1.5));
+        CHECK_EQ(writer.num_drawn(), 5U);
+        CHECK_EQ(writer.num_culled(), 3U);
+    }
+    const auto svg = out.str();
+    CHECK_EQ(svg.rfind("<svg viewBox='0 0 200 100'", 0), 0U);
+    CHECK_NE(svg.find("<rect x='20' y='90' width='20' height='10' fill='#88C0D0'"),
+             std::string::npos);
+    // the point list expands to the six corners, with y flipped
+    CHECK_NE(svg.find("<polygon points='0,100 20,100 20,80 10,80 10,60 0,60' fill='none'"),
+             std::string::npos);
+    CHECK_NE(svg.find("<circle cx='100' cy='50' r='1.5'"), std::string::npos);
+    CHECK_EQ(count_of(svg, "<rect"), 2U);
+    CHECK_EQ(count_of(svg, "<polygon"), 2U);
+    CHECK_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+}
+
+TEST_CASE("Layout writer test (TikZ)") {
+    auto out = std::ostringstream{};
+    const auto viewport = Rectangle<int>{Interval<int>{-10, 10}, Interval<int>{-10, 10}};
+    auto writer = LayoutWriter<int>(out, LayoutFormat::tikz, viewport, 0.5);
+    writer.rectangle({{0, 4}, {-2, 2}});
+    writer.style("none", "blue");
+    const auto pts = std::vector<Point<int>>{{0, 0}, {4, 4}};
+    writer.polygon(pts);
+    writer.close();
+    const auto tikz = out.str();
+    CHECK_EQ(tikz.rfind("\\begin{tikzpicture}\n\\clip (0,0) rectangle (10,10);\n", 0), 0U);
+    CHECK_NE(tikz.find("\\path[fill=cyan!30,draw=black] (5,4) rectangle (7,6);"),
+             std::string::npos);
+    CHECK_NE(tikz.find("\\path[draw=blue] (5,5) -- (7,7) -- cycle;"), std::string::npos);
+    CHECK_EQ(tikz.substr(tikz.size() - 18), "\\end{tikzpicture}\n");
+}
+
+TEST_CASE("Layout writer test (polygons, small chunks)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto S = std::vector<Point<int>>{};
+    for (auto i = 0; i != 50; ++i) {
+        S.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+    }
+    auto R = S;
+    create_ymono_polygon(S.begin(), S.end());
+    create_ymono_rpolygon(R.begin(), R.end());
+    const auto viewport = Rectangle<int>{Interval<int>{0, 2187}, Interval<int>{0, 2048}};
+    auto buffered = std::ostringstream{};
+    auto chunked = std::ostringstream{};
+    for (auto *out : {&buffered, &chunked}) {
+        auto writer = LayoutWriter<int>(*out, LayoutFormat::svg, viewport, 1.0, 0.0,
+                                        out == &chunked ? 64 : std::size_t{1} << 20);
+        CHECK(writer.draw(Polygon<int>(S)));
+        CHECK(writer.draw(RPolygon<int>(R)));
+        for (const auto &pt : S) {
+            writer.point(pt, 10.0);
+        }
+        CHECK_EQ(writer.num_drawn(), 52U);
+    }
+    CHECK_EQ(buffered.str(), chunked.str());
+    CHECK_EQ(count_of(buffered.str(), "<circle"), 50U);
+}
@@ -0,0 +1,50 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>          // for VdCorput
+#include <recti/overlap_sweep.hpp>  // for overlapping_pairs, sweep_overlapping...
+#include <utility>                  // for pair
+#include <vector>                   // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, Interval
+
+using namespace recti;
+
+TEST_CASE("Overlap sweep test (small)") {
+    const auto rects = std::vector<Rectangle<int>>{
+        {{0, 4}, {0, 4}}, {{4, 6}, {2, 3}}, {{5, 9}, {5, 9}}, {{1, 2}, {6, 8}}, {{6, 7}, {9, 12}}};
+    auto pairs = std::vector<std::pair<std::size_t, std::size_t>>{};
+    auto area = accumulator_t<int>{0};
+    sweep_overlapping_intersections<int>(rects, [&](std::size_t i, std::size_t j, auto inter) {
+        pairs.emplace_back(i, j);
+        area += inter.area();
+    });
+    std::sort(pairs.begin(), pairs.end());
+    CHECK_EQ(pairs, std::vector<std::pair<std::size_t, std::size_t>>{{0, 1}, {2, 4}});
+    CHECK_EQ(area, 0);  // both pairs only touch
+}
+
+TEST_CASE("Overlap sweep test (against brute force)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto hgenW = ildsgen::VdCorput(5, 3);
+    auto rects = std::vector<Rectangle<int>>{};
+    for (auto i = 0; i != 5000; ++i) {
+        const auto x = int(hgenX.pop());
+        const auto y = int(hgenY.pop());
+        const auto w = int(hgenW.pop());
+        rects.push_back(Rectangle<int>{{x, x + w}, {y, y + 2 * w}});
+    }
+    rects.push_back(Rectangle<int>{{0, 2187}, {1000, 1001}});  // spans all strips
+
+    auto expected = std::vector<std::pair<std::size_t, std::size_t>>{};
+    for (auto i = 0U; i != rects.size(); ++i) {
+        for (auto j = i + 1; j != rects.size(); ++j) {
+            if (overlap(rects[i], rects[j])) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+    CHECK(expected.size() > rects.size());
+    CHECK_EQ(overlapping_pairs<int>(rects, 1), expected);
+    CHECK_EQ(overlapping_pairs<int>(rects, 4), expected);
+}
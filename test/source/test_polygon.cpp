@@ -3,6 +3,8 @@
 // #include <gsl/span>           // for span
 #include <ldsgen/ilds.hpp>    // for VdCorput
 #include <recti/polygon.hpp>  // for Polygon, polygon_is_clockwise, creat...
+#include <memory_resource>    // for monotonic_buffer_resource
+#include <sstream>            // for ostringstream
 #include <vector>             // for vector
 
 #include "recti/point.hpp"  // for Point
@@ -66,3 +68,56 @@ TEST_CASE("Polygon test (ycoord-mono 50)") {
     CHECK(!polygon_is_clockwise<int>(S));
     CHECK(point_in_polygon<int>(S, q));
 }
+
+TEST_CASE("Polygon test (monotonic arena)") {
+    auto S = std::vector<Point<int>>{{-2, 2},  {0, -1}, {-5, 1}, {-2, 4}, {0, -4},  {-4, 3},
+                                     {-6, -2}, {5, 1},  {2, 2},  {3, -3}, {-3, -4}, {1, 4}};
+    create_ymono_polygon(S.begin(), S.end());
+    // no upstream: any allocation beyond the buffer would throw std::bad_alloc
+    char buffer[4096];
+    auto arena = std::pmr::monotonic_buffer_resource(buffer, sizeof buffer,
+                                                     std::pmr::null_memory_resource());
+    for (auto i = 0; i != 10; ++i) {
+        auto P = pmr::Polygon<int>(S, &arena);
+        CHECK_EQ(P.signed_area_x2(), 102);
+    }
+}
+
+TEST_CASE("Polygon test (radix sort path)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto S = std::vector<Point<int>>{};
+    for (auto i = 0; i != 1000; ++i) {
+        S.emplace_back(Point<int>(int(hgenX.pop()) - 1000, int(hgenY.pop()) - 1000));
+    }
+    auto R = S;
+    create_xmono_polygon(S.begin(), S.end());
+    create_mono_polygon(R.begin(), R.end(), [](const auto &lhs, const auto &rhs) -> bool {
+        return std::make_pair(lhs.xcoord(), lhs.ycoord())
+               < std::make_pair(rhs.xcoord(), rhs.ycoord());
+    });
+    CHECK(S == R);
+    CHECK(!polygon_is_clockwise<int>(S));
+}
+
+TEST_CASE("Polygon test (bounding box)") {
+    auto S = std::vector<Point<int>>{{-2, 2},  {0, -1}, {-5, 1}, {-2, 4}, {0, -4},  {-4, 3},
+                                     {-6, -2}, {5, 1},  {2, 2},  {3, -3}, {-3, -4}, {1, 4}};
+    create_xmono_polygon(S.begin(), S.end());
+    auto P = Polygon<int>(S);
+    CHECK_EQ(P.lb(), Point<int>{-6, -4});
+    CHECK_EQ(P.ub(), Point<int>{5, 4});
+    P += Vector2<int>{-1, 3};
+    CHECK_EQ(P.bounding_box(), Rectangle<int>{Interval<int>{-7, 4}, Interval<int>{-1, 7}});
+    CHECK_EQ(P.signed_area_x2(), 110);
+}
+
+TEST_CASE("Polygon test (operator<<)") {
+    const auto S = std::vector<Point<int>>{{0, 0}, {4, 0}, {2, 3}};
+    const auto P = Polygon<int>(S);
+    CHECK_EQ(P.num_vertices(), 3U);
+    CHECK_EQ(P.vertex(2), Point<int>{2, 3});
+    auto out = std::ostringstream{};
+    out << P;
+    CHECK_EQ(out.str(), "  \\draw (0, 0);\n  \\draw (4, 0);\n  \\draw (2, 3);\n");
+}
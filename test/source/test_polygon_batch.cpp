@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>                // for count, equal
+#include <atomic>                   // for atomic
+#include <ldsgen/ilds.hpp>          // for VdCorput
+#include <recti/parallel.hpp>       // for ThreadPool, execution::par
+#include <recti/polygon_batch.hpp>  // for create_xmono_rpolygon, signed_area, ...
+#include <recti/polygon_set.hpp>    // for PolygonSet
+#include <stdexcept>                // for runtime_error
+#include <vector>                   // for vector
+
+#include "recti/point.hpp"  // for Point
+
+using namespace recti;
+
+static auto make_set(std::size_t num) -> PolygonSet<int> {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto set = PolygonSet<int>{};
+    auto pointset = std::vector<Point<int>>{};
+    for (auto k = std::size_t{0}; k != num; ++k) {
+        pointset.clear();
+        for (auto i = 0U; i != 5 + k % 20; ++i) {
+            pointset.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+        }
+        set.push_back(pointset);
+    }
+    return set;
+}
+
+TEST_CASE("ThreadPool test") {
+    auto pool = ThreadPool(4);
+    CHECK_EQ(pool.num_threads(), 4U);
+    auto hits = std::vector<int>(10000, 0);
+    auto total = std::atomic<long>{0};
+    for (auto round = 0; round != 20; ++round) {  // the threads are reused across loops
+        pool.run(0, hits.size(), [&](std::size_t idx) {
+            ++hits[idx];
+            pool.run(0, 3, [&](std::size_t) { ++total; });  // nested: runs serially
+        }, 16);
+    }
+    CHECK_EQ(std::count(hits.begin(), hits.end(), 20), 10000);
+    CHECK_EQ(total.load(), 20L * 10000 * 3);
+
+    auto fail = [](std::size_t idx) {
+        if (idx == 777) {
+            throw std::runtime_error("fail");
+        }
+    };
+    CHECK_THROWS_AS(pool.run(0, 10000, fail, 8), std::runtime_error);
+    pool.run(0, 100, [&](std::size_t idx) { hits[idx] = 0; });  // still usable
+    CHECK_EQ(hits[99], 0);
+}
+
+TEST_CASE("Polygon batch test (against single shapes)") {
+    auto set = make_set(1000);
+    auto serial = set;
+    const auto anticw = create_xmono_rpolygon(execution::par, set);
+    const auto anticw_seq = create_xmono_rpolygon(execution::seq, serial);
+    const auto ptq = Point<int>{1000, 1000};
+    const auto areas = signed_area(execution::par, set);
+    const auto inside = point_in_rpolygon(execution::par, set, ptq);
+    const auto clockwise = rpolygon_is_clockwise(execution::par, set);
+    CHECK_EQ(anticw, anticw_seq);
+    auto num_inside = 0;
+    for (auto k = 0U; k != set.size(); ++k) {
+        auto pointset = std::vector<Point<int>>(serial[k].begin(), serial[k].end());
+        CHECK((std::equal(pointset.begin(), pointset.end(), set[k].begin())));
+        CHECK_EQ(areas[k], RPolygon<int>(set[k]).signed_area());
+        CHECK_EQ(inside[k] != 0, point_in_rpolygon<int>(set[k], ptq));
+        CHECK_EQ(clockwise[k] != 0, rpolygon_is_clockwise<int>(set[k]));
+        num_inside += inside[k];
+    }
+    CHECK(num_inside > 0);
+
+    auto mono = make_set(500);
+    create_ymono_polygon(execution::par, mono);
+    const auto poly_cw = polygon_is_clockwise(execution::seq, mono);
+    const auto poly_in = point_in_polygon(execution::par, mono, ptq);
+    for (auto k = 0U; k != mono.size(); ++k) {
+        CHECK_EQ(poly_cw[k] != 0, polygon_is_clockwise<int>(mono[k]));
+        CHECK_EQ(poly_in[k] != 0, point_in_polygon<int>(mono[k], ptq));
+    }
+
+    auto tests = make_set(500);
+    create_test_rpolygon(execution::par, tests);
+    const auto test_areas = signed_area(execution::seq, tests);
+    for (auto k = 0U; k != tests.size(); ++k) {
+        CHECK_EQ(test_areas[k], RPolygon<int>(tests[k]).signed_area());
+    }
+}
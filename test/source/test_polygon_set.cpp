@@ -0,0 +1,51 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>        // for VdCorput
+#include <memory_resource>        // for monotonic_buffer_resource
+#include <recti/polygon.hpp>      // for Polygon, create_xmono_polygon
+#include <recti/polygon_set.hpp>  // for PolygonSet
+#include <recti/rpolygon.hpp>     // for RPolygon, create_xmono_rpolygon
+#include <vector>                 // for vector
+
+#include "recti/point.hpp"  // for Point
+
+using namespace recti;
+
+TEST_CASE("Polygon set test") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto set = PolygonSet<int>{};
+    auto areas = std::vector<accumulator_t<int>>{};
+    set.reserve(20, 20 * 12);
+    for (auto k = 0U; k != 20; ++k) {
+        auto S = std::vector<Point<int>>{};
+        for (auto i = 0U; i != 4 + k % 9; ++i) {
+            S.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+        }
+        create_xmono_rpolygon(S.begin(), S.end());
+        areas.push_back(RPolygon<int>(S).signed_area());
+        set.push_back(S);
+    }
+    CHECK_EQ(set.size(), 20U);
+    CHECK_EQ(set.offsets().back(), set.num_points());
+    for (auto k = 0U; k != set.size(); ++k) {
+        CHECK_EQ(set[k].size(), 4 + k % 9);
+        CHECK_EQ(RPolygon<int>(set[k]).signed_area(), areas[k]);
+    }
+    set.clear();
+    CHECK(set.empty());
+}
+
+TEST_CASE("Polygon set test (pmr)") {
+    auto S = std::vector<Point<int>>{{-2, 2},  {0, -1}, {-5, 1}, {-2, 4}, {0, -4},  {-4, 3},
+                                     {-6, -2}, {5, 1},  {2, 2},  {3, -3}, {-3, -4}, {1, 4}};
+    create_xmono_polygon(S.begin(), S.end());
+    auto arena = std::pmr::monotonic_buffer_resource{};
+    auto set = pmr::PolygonSet<int>(&arena);
+    for (auto i = 0; i != 100; ++i) {
+        set.push_back(S.begin(), S.end());
+    }
+    CHECK_EQ(set.num_points(), 1200U);
+    CHECK_EQ(Polygon<int>(set[57]).signed_area_x2(), 110);
+    CHECK_EQ(set.get_allocator().resource(), &arena);
+}
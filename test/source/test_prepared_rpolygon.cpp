@@ -0,0 +1,53 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <cstdint>                      // for uint64_t
+#include <ldsgen/ilds.hpp>              // for VdCorput
+#include <recti/prepared_rpolygon.hpp>  // for PreparedRPolygon
+#include <recti/rpolygon.hpp>           // for point_in_rpolygon, create_ymono_...
+#include <vector>                       // for vector
+
+#include "recti/point.hpp"  // for Point
+
+using namespace recti;
+
+TEST_CASE("Prepared rpolygon test (small)") {
+    // an L-shape: (0,0)-(4,0)-(4,2)-(2,2)-(2,4)-(0,4)
+    auto S = std::vector<Point<int>>{{0, 0}, {4, 2}, {2, 4}};
+    auto P = PreparedRPolygon<int>(S);
+    CHECK_EQ(P.num_slabs(), 2U);
+    for (auto x = -1; x != 6; ++x) {
+        for (auto y = -1; y != 6; ++y) {
+            const auto q = Point<int>{x, y};
+            CHECK_EQ(P.contains(q), point_in_rpolygon<int>(S, q));
+        }
+    }
+    CHECK(P.contains(Point<int>{1, 3}));
+    CHECK(!P.contains(Point<int>{3, 3}));
+}
+
+TEST_CASE("Prepared rpolygon test (batch)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto S = std::vector<Point<int>>{};
+    for (auto i = 0; i != 200; ++i) {
+        S.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+    }
+    create_ymono_rpolygon(S.begin(), S.end());
+    auto pts = std::vector<Point<int>>{};
+    for (auto i = 0; i != 5000; ++i) {
+        pts.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+    }
+    const auto P = PreparedRPolygon<int>(S);
+    const auto mask = P.contains(pts, 1);
+    CHECK_EQ(P.contains(pts, 4), mask);
+
+    auto mismatches = 0;
+    auto inside = 0;
+    for (auto i = 0U; i != pts.size(); ++i) {
+        const auto bit = ((mask[i / 64] >> (i % 64)) & 1U) != 0;
+        mismatches += int(bit != point_in_rpolygon<int>(S, pts[i]));
+        inside += int(bit);
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK(inside > 0);
+}
@@ -0,0 +1,60 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <cstdint>                  // for uint64_t
+#include <ldsgen/ilds.hpp>          // for VdCorput
+#include <recti/rectangle_set.hpp>  // for RectangleSet
+#include <vector>                   // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, overlap, min_dist
+
+using namespace recti;
+
+static auto make_rects(unsigned num) -> std::vector<Rectangle<int>> {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto rects = std::vector<Rectangle<int>>{};
+    for (auto i = 0U; i != num; ++i) {
+        auto x = int(hgenX.pop());
+        auto y = int(hgenY.pop());
+        rects.emplace_back(Interval<int>{x, x + 100}, Interval<int>{y, y + 120});
+    }
+    return rects;
+}
+
+TEST_CASE("RectangleSet test") {
+    auto R = RectangleSet<int>{};
+    CHECK(R.empty());
+    R.push_back(Rectangle<int>{Interval<int>{0, 10}, Interval<int>{0, 10}});
+    R.push_back(Rectangle<int>{Interval<int>{20, 30}, Interval<int>{5, 15}});
+    CHECK_EQ(R.size(), 2U);
+    CHECK_EQ(R[1], Rectangle<int>{Interval<int>{20, 30}, Interval<int>{5, 15}});
+
+    auto query = Rectangle<int>{Interval<int>{10, 19}, Interval<int>{10, 12}};
+    CHECK_EQ(R.overlaps(query), std::vector<std::uint64_t>{1U});
+    CHECK_EQ(R.contains(Point<int>{25, 15}), std::vector<std::size_t>{1U});
+    CHECK_EQ(R.min_dist(query), std::vector<int>{0, 1});
+}
+
+TEST_CASE("RectangleSet test (against scalar kernels)") {
+    const auto rects = make_rects(1000);
+    const auto R = RectangleSet<int>(rects);
+    auto query = Rectangle<int>{Interval<int>{800, 1200}, Interval<int>{700, 900}};
+    auto ptq = Point<int>{1000, 1000};
+
+    const auto mask = R.overlaps(query);
+    const auto inside = R.contains(ptq);
+    const auto dist = R.min_dist(query);
+    auto expected_inside = std::vector<std::size_t>{};
+    auto failures = 0;
+    for (auto i = 0U; i != rects.size(); ++i) {
+        const auto bit = ((mask[i / 64] >> (i % 64)) & 1U) != 0U;
+        failures += int(bit != overlap(rects[i], query));
+        failures += int(dist[i] != min_dist(rects[i], query));
+        if (contain(rects[i], ptq)) {
+            expected_inside.push_back(i);
+        }
+    }
+    CHECK_EQ(failures, 0);
+    CHECK_EQ(inside, expected_inside);
+    CHECK(!inside.empty());
+}
@@ -3,11 +3,17 @@
 #include <recti/halton_int.hpp>  // for recti
 #include <recti/recti.hpp>       // for Rectangle, HSegment, VSegment
 // #include <random>
-#include <ostream>  // for operator<<
+#include <cstdint>      // for int64_t
+#include <ostream>      // for operator<<
+#include <type_traits>  // for is_same_v
+#include <vector>       // for vector
 
-#include "recti/interval.hpp"  // for Interval, min_dist, overlap
-#include "recti/point.hpp"     // for Point, operator<<, operator+, operat...
-#include "recti/vector2.hpp"   // for operator/, vector2
+#include "recti/accumulator.hpp"  // for accumulator_t
+#include "recti/interval.hpp"     // for Interval, min_dist, overlap
+#include "recti/point.hpp"        // for Point, operator<<, operator+, operat...
+#include "recti/polygon.hpp"      // for Polygon
+#include "recti/rpolygon.hpp"     // for RPolygon
+#include "recti/vector2.hpp"      // for operator/, vector2
 
 // using std::randint;
 using namespace recti;
@@ -54,6 +60,11 @@ TEST_CASE("Rectangle test") {
 
     CHECK(r1.min_dist_with(r2) == 0);
     CHECK(min_dist(r1, r2) == 0);
+
+    // short coordinates (the differences are promoted to int)
+    const auto s1 = Rectangle<short>{{40, 80}, {50, 70}};
+    const auto s2 = Rectangle<short>{{90, 95}, {10, 20}};
+    CHECK_EQ(min_dist(s1, s2), 40);
 }
 
 TEST_CASE("Segment test") {
@@ -64,3 +75,22 @@ TEST_CASE("Segment test") {
 
     CHECK(s1.overlaps(s2));
 }
+
+TEST_CASE("Accumulator test (DBU-sized coordinates)") {
+    static_assert(std::is_same_v<accumulator_t<int>, std::int64_t>);
+    static_assert(std::is_same_v<accumulator_t<double>, double>);
+    static_assert(std::is_same_v<accumulator_t<bool>, bool>);
+
+    // 3e6 x 2e6 DBU: the area and the cross products overflow 32 bits
+    const auto die = Rectangle<int>{{0, 3000000}, {0, 2000000}};
+    CHECK_EQ(die.area(), std::int64_t{6000000000000});
+    const auto v = Vector2<int>{3000000, 0};
+    const auto w = Vector2<int>{0, 2000000};
+    CHECK_EQ(v.cross(w), std::int64_t{6000000000000});
+    CHECK_EQ(w.cross(v), -std::int64_t{6000000000000});
+
+    const auto r_pts = std::vector<Point<int>>{{0, 0}, {3000000, 2000000}};
+    CHECK_EQ(RPolygon<int>(r_pts).signed_area(), std::int64_t{6000000000000});
+    const auto p_pts = std::vector<Point<int>>{{0, 0}, {3000000, 0}, {3000000, 2000000}};
+    CHECK_EQ(Polygon<int>(p_pts).signed_area_x2(), std::int64_t{6000000000000});
+}
@@ -0,0 +1,164 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <cstddef>                // for size_t
+#include <deque>                  // for deque
+#include <ldsgen/ilds.hpp>        // for VdCorput
+#include <recti/maze_router.hpp>  // for MazeRouter, RouteResult
+#include <vector>                 // for vector
+
+#include "recti/recti.hpp"  // for Point, Rectangle
+
+using namespace recti;
+
+// BFS path length on the unit grid over [0, size]^2, or -1 if unreachable
+static auto bfs_length(const std::vector<Rectangle<int>> &obstacles, int size,
+                       const Point<int> &source, const Point<int> &target) -> int {
+    const auto width = size + 1;
+    auto dist = std::vector<int>(std::size_t(width * width), -1);
+    auto blocked = [&](int x, int y) {
+        for (const auto &obs : obstacles) {
+            if (obs.contains(Point<int>{x, y})) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto queue = std::deque<Point<int>>{source};
+    dist[std::size_t(source.ycoord() * width + source.xcoord())] = 0;
+    while (!queue.empty()) {
+        const auto pt = queue.front();
+        queue.pop_front();
+        const auto cur = dist[std::size_t(pt.ycoord() * width + pt.xcoord())];
+        if (pt == target) {
+            return cur;
+        }
+        const int moves[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const auto &move : moves) {
+            const auto x = pt.xcoord() + move[0];
+            const auto y = pt.ycoord() + move[1];
+            if (x < 0 || y < 0 || x > size || y > size) {
+                continue;
+            }
+            auto &seen = dist[std::size_t(y * width + x)];
+            if (seen >= 0 || (blocked(x, y) && Point<int>{x, y} != target)) {
+                continue;
+            }
+            seen = cur + 1;
+            queue.push_back({x, y});
+        }
+    }
+    return -1;
+}
+
+// whether any segment touches `rect`
+static auto touches(const RouteResult<int> &result, const Rectangle<int> &rect) -> bool {
+    for (const auto &seg : result.hsegments) {
+        if (rect.overlaps(Rectangle<int>{seg.xcoord(), {seg.ycoord(), seg.ycoord()}})) {
+            return true;
+        }
+    }
+    for (const auto &seg : result.vsegments) {
+        if (rect.overlaps(Rectangle<int>{{seg.xcoord(), seg.xcoord()}, seg.ycoord()})) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE("MazeRouter straight and L-shaped routes") {
+    const auto region = Rectangle<int>{{0, 100}, {0, 100}};
+    const auto router = MazeRouter<int>(region, 10, {});
+    CHECK_EQ(router.num_x(), 11U);
+    auto scratch = router.make_scratch();
+    auto result = RouteResult<int>{};
+    CHECK(router.route({10, 20}, {70, 20}, scratch, result));
+    CHECK_EQ(result.wirelength(), 60);
+    CHECK_EQ(result.hsegments.size(), 1U);
+    CHECK(result.vsegments.empty());
+
+    CHECK(router.route({12, 18}, {71, 92}, scratch, result));  // snapped to (10,20)-(70,90)
+    CHECK_EQ(result.wirelength(), 60 + 70);
+    CHECK_EQ(result.hsegments.size() + result.vsegments.size(), 2U);  // a single bend
+}
+
+TEST_CASE("MazeRouter detours around obstacles") {
+    const auto obstacles = std::vector<Rectangle<int>>{
+        {{5, 5}, {0, 15}}, {{10, 10}, {5, 20}}, {{14, 16}, {0, 12}}, {{2, 18}, {14, 14}}};
+    const auto router = MazeRouter<int>({{0, 20}, {0, 20}}, 1, obstacles);
+    CHECK(router.is_blocked({5, 3}));
+    CHECK(!router.is_blocked({6, 3}));
+    auto scratch = router.make_scratch();
+    auto result = RouteResult<int>{};
+    auto hgen_x = ildsgen::VdCorput(2, 5);
+    auto hgen_y = ildsgen::VdCorput(3, 5);
+    for (auto idx = 0; idx != 30; ++idx) {
+        const auto source = Point<int>{int(hgen_x.pop() % 21), int(hgen_y.pop() % 21)};
+        const auto target = Point<int>{int(hgen_x.pop() % 21), int(hgen_y.pop() % 21)};
+        const auto expected = bfs_length(obstacles, 20, source, target);
+        const auto routed = router.route(source, target, scratch, result);
+        CHECK_EQ(routed, expected >= 0);
+        if (!routed) {
+            continue;
+        }
+        CHECK_EQ(result.wirelength(), expected);
+        if (!router.is_blocked(source) && !router.is_blocked(target)) {
+            for (const auto &obs : obstacles) {
+                CHECK(!touches(result, obs));
+            }
+        }
+    }
+}
+
+TEST_CASE("MazeRouter unreachable pins") {
+    const auto walls = std::vector<Rectangle<int>>{{{20, 40}, {20, 20}}, {{20, 40}, {40, 40}},
+                                                   {{20, 20}, {20, 40}}, {{40, 40}, {20, 40}}};
+    const auto router = MazeRouter<int>({{0, 60}, {0, 60}}, 5, walls);
+    auto scratch = router.make_scratch();
+    auto result = RouteResult<int>{};
+    CHECK(!router.route({30, 30}, {0, 0}, scratch, result));
+    CHECK(router.route({30, 30}, {35, 25}, scratch, result));
+    CHECK_EQ(result.wirelength(), 10);
+}
+
+TEST_CASE("MazeRouter multi-pin nets and batches") {
+    const auto obstacles
+        = std::vector<Rectangle<int>>{{{30, 50}, {0, 60}}, {{60, 70}, {40, 100}}};
+    const auto router = MazeRouter<int>({{0, 100}, {0, 100}}, 2, obstacles);
+    auto hgen_x = ildsgen::VdCorput(2, 7);
+    auto hgen_y = ildsgen::VdCorput(3, 7);
+    auto pins = std::vector<Point<int>>{};
+    auto offsets = std::vector<std::size_t>{0};
+    for (auto net = 0U; net != 40U; ++net) {
+        for (auto idx = 0U; idx != 2U + net % 4U; ++idx) {
+            auto pin = Point<int>{0, 0};
+            do {  // on the grid and off the obstacles
+                pin = Point<int>{2 * int(hgen_x.pop() % 51), 2 * int(hgen_y.pop() % 51)};
+            } while (router.is_blocked(pin));
+            pins.push_back(pin);
+        }
+        offsets.push_back(pins.size());
+    }
+    auto serial = std::vector<RouteResult<int>>{};
+    router.route_nets(pins, offsets, serial, 1);
+    auto concurrent = std::vector<RouteResult<int>>{};
+    router.route_nets(pins, offsets, concurrent, 4);
+    REQUIRE_EQ(serial.size(), 40U);
+    REQUIRE_EQ(concurrent.size(), 40U);
+    for (auto net = 0U; net != 40U; ++net) {
+        const auto &result = serial[net];
+        CHECK(result.routed);
+        CHECK_EQ(result.wirelength(), concurrent[net].wirelength());
+        for (const auto &obs : obstacles) {
+            CHECK(!touches(result, obs));
+        }
+        // every pin lies on the tree and a tree is at least as long as the bounding box
+        auto box = Rectangle<int>{pins[offsets[net]].hull_with(pins[offsets[net]])};
+        for (auto idx = offsets[net]; idx != offsets[net + 1]; ++idx) {
+            const auto &pin = pins[idx];
+            box = box.hull_with(pin);
+            const auto on_tree = touches(result, Rectangle<int>{pin.hull_with(pin)});
+            CHECK((on_tree || pin == pins[offsets[net]]));
+        }
+        CHECK(result.wirelength() >= box.xcoord().length() + box.ycoord().length());
+    }
+}
@@ -4,6 +4,8 @@
 // #include <gsl/span>            // for span
 #include <ldsgen/ilds.hpp>     // for VdCorput
 #include <recti/rpolygon.hpp>  // for RPolygon, RPolygon_is_clockwise, cre...
+#include <cstdint>             // for int64_t
+#include <memory_resource>     // for monotonic_buffer_resource
 #include <vector>              // for vector
 
 #include "recti/point.hpp"  // for Point, operator>
@@ -69,3 +71,55 @@ TEST_CASE("Rectilinear Polygon test (ycoord-mono 50)") {
     CHECK(rpolygon_is_clockwise<int>(S));
     CHECK(!point_in_rpolygon<int>(S, q));
 }
+
+TEST_CASE("Rectilinear Polygon test (monotonic arena)") {
+    auto S = std::vector<Point<int>>{{-2, 2},  {0, -1}, {-5, 1}, {-2, 4}, {0, -4},  {-4, 3},
+                                     {-6, -2}, {5, 1},  {2, 2},  {3, -3}, {-3, -4}, {1, 4}};
+    create_ymono_rpolygon(S.begin(), S.end());
+    // no upstream: any allocation beyond the buffer would throw std::bad_alloc
+    char buffer[4096];
+    auto arena = std::pmr::monotonic_buffer_resource(buffer, sizeof buffer,
+                                                     std::pmr::null_memory_resource());
+    for (auto i = 0; i != 10; ++i) {
+        auto P = pmr::RPolygon<int>(S, &arena);
+        CHECK_EQ(P.signed_area(), 45);
+        CHECK_EQ(P.get_allocator().resource(), &arena);
+    }
+}
+
+TEST_CASE("Rectilinear Polygon test (radix sort path)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto S = std::vector<Point<int>>{};
+    for (auto i = 0; i != 1000; ++i) {
+        S.emplace_back(Point<int>(int(hgenX.pop()) - 1000, int(hgenY.pop()) - 1000));
+    }
+    // 64-bit keys do not fit the packed radix key, so these take the std::sort path
+    auto wide_x = [](const auto &pt) {
+        return std::make_pair(std::int64_t(pt.xcoord()), std::int64_t(pt.ycoord()));
+    };
+    auto wide_y = [](const auto &pt) {
+        return std::make_pair(std::int64_t(pt.ycoord()), std::int64_t(pt.xcoord()));
+    };
+    auto R = S;
+    CHECK_EQ(create_xmono_rpolygon(S.begin(), S.end()),
+             create_mono_rpolygon(R.begin(), R.end(), wide_x));
+    CHECK(S == R);
+    CHECK_EQ(create_ymono_rpolygon(S.begin(), S.end()),
+             create_mono_rpolygon(R.begin(), R.end(), wide_y));
+    CHECK(S == R);
+}
+
+TEST_CASE("Rectilinear Polygon test (bounding box)") {
+    auto S = std::vector<Point<int>>{{-2, 2},  {0, -1}, {-5, 1}, {-2, 4}, {0, -4},  {-4, 3},
+                                     {-6, -2}, {5, 1},  {2, 2},  {3, -3}, {-3, -4}, {1, 4}};
+    create_xmono_rpolygon(S.begin(), S.end());
+    auto P = RPolygon<int>(S);
+    CHECK_EQ(P.lb(), Point<int>{-6, -4});
+    CHECK_EQ(P.ub(), Point<int>{5, 4});
+    CHECK_EQ(P.bounding_box(), Rectangle<int>{Interval<int>{-6, 5}, Interval<int>{-4, 4}});
+    P += Vector2<int>{10, 20};
+    CHECK_EQ(P.lb(), Point<int>{4, 16});
+    CHECK_EQ(P.ub(), Point<int>{15, 24});
+    CHECK_EQ(P.signed_area(), -53);
+}
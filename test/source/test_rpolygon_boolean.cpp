@@ -0,0 +1,125 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>             // for VdCorput
+#include <recti/polygon_set.hpp>       // for PolygonSet
+#include <recti/rpolygon_boolean.hpp>  // for rpolygon_boolean, rpolygon_union, ...
+#include <vector>                      // for vector
+
+#include "recti/point.hpp"  // for Point
+
+using namespace recti;
+
+// an axis-parallel rectangle in the point-list form of RPolygon
+static auto add_rect(PolygonSet<int> &set, int x0, int y0, int x1, int y1) -> void {
+    const auto pts = std::vector<Point<int>>{{x0, y0}, {x1, y1}};
+    set.push_back(pts);
+}
+
+static auto total_area(const std::vector<RPolygonWithHoles<int>> &polys) -> accumulator_t<int> {
+    auto res = accumulator_t<int>{0};
+    for (const auto &poly : polys) {
+        res += poly.area();
+    }
+    return res;
+}
+
+TEST_CASE("Rectilinear boolean test (ring and corners)") {
+    auto ring = PolygonSet<int>{};
+    add_rect(ring, 0, 0, 6, 2);
+    add_rect(ring, 0, 4, 6, 6);
+    add_rect(ring, 0, 0, 2, 6);
+    add_rect(ring, 4, 0, 6, 6);
+    add_rect(ring, 2, 2, 3, 3);  // island touching the hole boundary
+    const auto result = rpolygon_union(ring);
+    REQUIRE_EQ(result.size(), 1U);
+    CHECK_EQ(result[0].holes.size(), 1U);
+    CHECK_EQ(result[0].area(), 36 - 4 + 1);
+
+    auto nested = PolygonSet<int>{};
+    add_rect(nested, 0, 0, 10, 10);
+    add_rect(nested, 20, 0, 30, 10);
+    add_rect(nested, 4, 4, 6, 6);
+    auto holes = PolygonSet<int>{};
+    add_rect(holes, 2, 2, 8, 8);
+    add_rect(holes, 22, 2, 28, 8);
+    const auto framed = rpolygon_difference(nested, holes);
+    REQUIRE_EQ(framed.size(), 2U);
+    CHECK_EQ(framed[0].holes.size() + framed[1].holes.size(), 2U);
+    CHECK_EQ(total_area(framed), 2 * (100 - 36));
+    const auto island = rpolygon_intersection(nested, holes);
+    CHECK_EQ(island.size(), 2U);  // the island is inside both
+    CHECK_EQ(total_area(island), 36 + 36);
+
+    auto corners = PolygonSet<int>{};
+    add_rect(corners, 0, 0, 2, 2);
+    add_rect(corners, 2, 2, 4, 4);
+    const auto touching = rpolygon_union(corners);
+    CHECK_EQ(touching.size(), 2U);
+    CHECK_EQ(total_area(touching), 8);
+
+    auto other = PolygonSet<int>{};
+    add_rect(other, 1, 1, 3, 3);
+    CHECK_EQ(total_area(rpolygon_intersection(corners, other)), 2);
+    CHECK_EQ(total_area(rpolygon_difference(corners, other)), 6);
+    CHECK_EQ(total_area(rpolygon_boolean(corners, other, BoolOp::Xor)), 8);
+}
+
+TEST_CASE("Rectilinear boolean test (long rails and large coordinates)") {
+    // one rail spanning many elementary intervals, crossed by a column of squares
+    auto rail = PolygonSet<int>{};
+    add_rect(rail, 0, 0, 2, 4000);
+    auto squares = PolygonSet<int>{};
+    for (auto idx = 0; idx != 1000; ++idx) {
+        add_rect(squares, 1, 4 * idx, 3, 4 * idx + 2);
+    }
+    CHECK_EQ(total_area(rpolygon_union(rail)), 8000);
+    CHECK_EQ(total_area(rpolygon_intersection(rail, squares)), 2000);
+    CHECK_EQ(total_area(rpolygon_difference(squares, rail)), 2000);
+
+    // a ring whose doubled coordinates do not fit in int
+    const auto base = 1500000000;
+    auto ring = PolygonSet<int>{};
+    add_rect(ring, base, base, base + 6, base + 2);
+    add_rect(ring, base, base + 4, base + 6, base + 6);
+    add_rect(ring, base, base, base + 2, base + 6);
+    add_rect(ring, base + 4, base, base + 6, base + 6);
+    const auto result = rpolygon_union(ring);
+    REQUIRE_EQ(result.size(), 1U);
+    CHECK_EQ(result[0].holes.size(), 1U);
+    CHECK_EQ(result[0].area(), 36 - 4);
+}
+
+TEST_CASE("Rectilinear boolean test (against raster)") {
+    auto hgenX = ildsgen::VdCorput(3, 5);
+    auto hgenY = ildsgen::VdCorput(2, 8);
+    auto hgenW = ildsgen::VdCorput(5, 2);
+    constexpr auto size = 300;
+    auto lhs = PolygonSet<int>{};
+    auto rhs = PolygonSet<int>{};
+    auto cover_a = std::vector<int>(size * size, 0);
+    auto cover_b = std::vector<int>(size * size, 0);
+    for (auto i = 0; i != 6000; ++i) {
+        const auto x0 = int(hgenX.pop());
+        const auto y0 = int(hgenY.pop());
+        const auto x1 = x0 + 1 + int(hgenW.pop()) % 13;
+        const auto y1 = y0 + 1 + int(hgenW.pop()) % 11;
+        auto &cover = i % 2 == 0 ? cover_a : cover_b;
+        add_rect(i % 2 == 0 ? lhs : rhs, x0, y0, x1, y1);
+        for (auto x = x0; x != x1; ++x) {
+            for (auto y = y0; y != y1; ++y) {
+                cover[std::size_t(x * size + y)] = 1;
+            }
+        }
+    }
+    for (const auto op : {BoolOp::Union, BoolOp::Intersection, BoolOp::Difference, BoolOp::Xor}) {
+        auto expected = 0;
+        for (auto cell = std::size_t{0}; cell != cover_a.size(); ++cell) {
+            expected += int(detail::bool_op_inside(op, cover_a[cell], cover_b[cell]));
+        }
+        const auto result1 = rpolygon_boolean(lhs, rhs, op, 1);
+        const auto result4 = rpolygon_boolean(lhs, rhs, op, 4);
+        CHECK_EQ(total_area(result1), expected);
+        CHECK_EQ(total_area(result4), expected);
+        CHECK_EQ(result1.size(), result4.size());
+    }
+}
@@ -0,0 +1,113 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>                     // for sort
+#include <ldsgen/ilds.hpp>               // for VdCorput
+#include <recti/prepared_rpolygon.hpp>   // for PreparedRPolygon
+#include <recti/rectangle_set.hpp>       // for RectangleSet
+#include <recti/rpolygon.hpp>            // for RPolygon, create_xmono_rpolygon
+#include <recti/rpolygon_decompose.hpp>  // for decompose_rpolygon
+#include <vector>                        // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, Point
+
+using namespace recti;
+
+// total area, or -1 if two rectangles share interior points
+static auto checked_area(const std::vector<Rectangle<int>> &rects) -> accumulator_t<int> {
+    auto area = accumulator_t<int>{0};
+    for (auto i = 0U; i != rects.size(); ++i) {
+        area += rects[i].area();
+        for (auto j = i + 1; j != rects.size(); ++j) {
+            if (overlap(rects[i], rects[j])
+                && Rectangle<int>(rects[i].intersect_with(rects[j])).area() != 0) {
+                return -1;
+            }
+        }
+    }
+    return area;
+}
+
+// area of the points inside by the parity rule of point_in_rpolygon, cell by cell
+static auto parity_area(const std::vector<Point<int>> &pts) -> int {
+    auto xs = std::vector<int>{};
+    auto ys = std::vector<int>{};
+    auto doubled = std::vector<Point<int>>{};
+    for (const auto &pt : pts) {
+        xs.push_back(pt.xcoord());
+        ys.push_back(pt.ycoord());
+        doubled.emplace_back(2 * pt.xcoord(), 2 * pt.ycoord());
+    }
+    std::sort(xs.begin(), xs.end());
+    std::sort(ys.begin(), ys.end());
+    const auto prepared = PreparedRPolygon<int>(doubled);
+    auto area = 0;
+    for (auto i = 1U; i < xs.size(); ++i) {
+        for (auto j = 1U; j < ys.size(); ++j) {
+            if (prepared.contains(Point<int>{xs[i - 1] + xs[i], ys[j - 1] + ys[j]})) {
+                area += (xs[i] - xs[i - 1]) * (ys[j] - ys[j - 1]);
+            }
+        }
+    }
+    return area;
+}
+
+TEST_CASE("Rectilinear decomposition test (shapes)") {
+    // H-shape: two facing notches joined by horizontal chords
+    const auto h_shape = std::vector<Point<int>>{{0, 0}, {6, 2}, {4, 4}, {6, 6},
+                                                 {0, 4}, {2, 2}};
+    auto rects = std::vector<Rectangle<int>>{};
+    CHECK_EQ(decompose_rpolygon<int>(h_shape, rects, DecompositionMode::Minimum), 3U);
+    CHECK_EQ(checked_area(rects), 36 - 8);
+
+    // staircase with 4 steps
+    const auto stairs = std::vector<Point<int>>{{0, 0}, {4, 1}, {3, 2}, {2, 3}, {1, 4}};
+    rects.clear();
+    CHECK_EQ(decompose_rpolygon<int>(stairs, rects, DecompositionMode::Slab), 4U);
+    CHECK_EQ(checked_area(rects), 10);
+    rects.clear();
+    CHECK_EQ(decompose_rpolygon<int>(stairs, rects, DecompositionMode::Minimum), 4U);
+    CHECK_EQ(checked_area(rects), 10);
+
+    // vertical chords beat the horizontal slabs: a comb with 3 teeth pointing up
+    const auto comb = std::vector<Point<int>>{{0, 0}, {5, 5}, {4, 1}, {3, 5}, {2, 1}, {1, 5}};
+    auto set = RectangleSet<int>{};
+    CHECK_EQ(decompose_rpolygon<int>(comb, set, DecompositionMode::Slab), 4U);
+    set.clear();
+    CHECK_EQ(decompose_rpolygon<int>(comb, set, DecompositionMode::Minimum), 4U);
+
+    // a long comb: every slab crosses all teeth, but each edge only touches its neighbours
+    const auto teeth = 2000;
+    auto long_comb = std::vector<Point<int>>{{0, 0}, {2 * teeth - 1, teeth}};
+    for (auto tooth = teeth - 1; tooth != 0; --tooth) {
+        long_comb.emplace_back(2 * tooth, 1);
+        long_comb.emplace_back(2 * tooth - 1, teeth);
+    }
+    rects.clear();
+    CHECK_EQ(decompose_rpolygon<int>(long_comb, rects, DecompositionMode::Slab),
+             std::size_t(teeth + 1));
+    auto total = accumulator_t<int>{0};
+    for (const auto &rect : rects) {
+        total += rect.area();
+    }
+    CHECK_EQ(total, accumulator_t<int>(2 * teeth - 1) + accumulator_t<int>(teeth) * (teeth - 1));
+}
+
+TEST_CASE("Rectilinear decomposition test (random)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    for (auto num : {10, 50, 200}) {
+        auto S = std::vector<Point<int>>{};
+        for (auto i = 0; i != num; ++i) {
+            S.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+        }
+        create_xmono_rpolygon(S.begin(), S.end());
+        const auto area = parity_area(S);  // the point list may cross itself
+        auto slab = std::vector<Rectangle<int>>{};
+        auto best = std::vector<Rectangle<int>>{};
+        decompose_rpolygon<int>(S, slab, DecompositionMode::Slab);
+        decompose_rpolygon<int>(S, best, DecompositionMode::Minimum);
+        CHECK_EQ(checked_area(slab), area);
+        CHECK_EQ(checked_area(best), area);
+        CHECK(best.size() <= slab.size());
+    }
+}
@@ -0,0 +1,145 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <ldsgen/ilds.hpp>        // for VdCorput
+#include <recti/polygon_set.hpp>  // for PolygonSet
+#include <recti/rsmt.hpp>         // for rectilinear_steiner_tree, rsmt_length
+#include <vector>                 // for vector
+
+#include "recti/recti.hpp"  // for Point
+
+using namespace recti;
+
+static auto halton_net(ildsgen::VdCorput &hgenX, ildsgen::VdCorput &hgenY, std::size_t num)
+    -> std::vector<Point<int>> {
+    auto pins = std::vector<Point<int>>{};
+    for (auto i = std::size_t{0}; i != num; ++i) {
+        pins.emplace_back(int(hgenX.pop()), int(hgenY.pop()));
+    }
+    return pins;
+}
+
+// O(n^2) Prim, the reference for the MST length
+static auto brute_mst_length(const std::vector<Point<int>> &pins) -> int {
+    auto dist = std::vector<int>(pins.size(), 1 << 30);
+    auto done = std::vector<bool>(pins.size(), false);
+    dist[0] = 0;
+    auto total = 0;
+    for (auto step = 0U; step != pins.size(); ++step) {
+        auto best = pins.size();
+        for (auto i = 0U; i != pins.size(); ++i) {
+            if (!done[i] && (best == pins.size() || dist[i] < dist[best])) {
+                best = i;
+            }
+        }
+        done[best] = true;
+        total += dist[best];
+        for (auto i = 0U; i != pins.size(); ++i) {
+            dist[i] = std::min(dist[i], min_dist(pins[best], pins[i]));
+        }
+    }
+    return total;
+}
+
+// the tree spans all nodes and its first nodes are the pins
+static auto is_valid_tree(const SteinerTree<int> &tree, const std::vector<Point<int>> &pins)
+    -> bool {
+    if (tree.num_pins != pins.size() || tree.edges.size() + 1 != tree.nodes.size()) {
+        return false;
+    }
+    auto sets = detail::DisjointSets(tree.nodes.size());
+    for (const auto &[src, dst] : tree.edges) {
+        if (!sets.unite(src, dst)) {
+            return false;
+        }
+    }
+    return std::equal(pins.begin(), pins.end(), tree.nodes.begin());
+}
+
+TEST_CASE("RSMT test (small nets)") {
+    const auto plus = std::vector<Point<int>>{{0, 1}, {2, 1}, {1, 0}, {1, 2}};
+    const auto tree = rectilinear_steiner_tree<int>(plus, SteinerMode::OneSteiner);
+    CHECK(is_valid_tree(tree, plus));
+    CHECK_EQ(tree.wirelength(), 4);
+    CHECK_EQ(brute_mst_length(plus), 6);
+    const auto fast = rectilinear_steiner_tree<int>(plus);
+    CHECK(is_valid_tree(fast, plus));
+    CHECK(fast.wirelength() < 6);
+
+    const auto corner = std::vector<Point<int>>{{0, 0}, {4, 0}, {0, 3}};
+    const auto tree3 = rectilinear_steiner_tree<int>(corner);
+    CHECK(is_valid_tree(tree3, corner));
+    CHECK_EQ(tree3.nodes.size(), 3U);  // the median point is the pin (0, 0)
+    CHECK_EQ(tree3.wirelength(), 7);
+    CHECK_EQ(rsmt_length<int>(corner), 7);
+    CHECK_EQ(rsmt_length<int>(gsl::span<const Point<int>>(corner).first(1)), 0);
+}
+
+TEST_CASE("RSMT test (rectilinear MST)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    for (const auto num : {2U, 5U, 50U, 300U}) {
+        const auto pins = halton_net(hgenX, hgenY, num);
+        const auto edges = rectilinear_mst<int>(pins);
+        CHECK_EQ(edges.size(), num - 1);
+        auto total = 0;
+        auto sets = detail::DisjointSets(num);
+        for (const auto &[src, dst] : edges) {
+            CHECK(sets.unite(src, dst));
+            total += min_dist(pins[src], pins[dst]);
+        }
+        CHECK_EQ(total, brute_mst_length(pins));
+    }
+}
+
+TEST_CASE("RSMT test (Steiner trees)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto total_mst = 0;
+    auto total_rsmt = 0;
+    for (const auto num : {4U, 5U, 7U, 9U, 10U, 30U, 100U}) {
+        for (auto trial = 0; trial != 5; ++trial) {
+            const auto pins = halton_net(hgenX, hgenY, num);
+            const auto mst = brute_mst_length(pins);
+            for (const auto mode : {SteinerMode::Fast, SteinerMode::OneSteiner}) {
+                if (mode == SteinerMode::OneSteiner && num > 10) {
+                    continue;
+                }
+                const auto tree = rectilinear_steiner_tree<int>(pins, mode);
+                CHECK(is_valid_tree(tree, pins));
+                const auto length = tree.wirelength();
+                CHECK(length <= mst);
+                CHECK(length >= detail::half_perimeter<int>(pins));
+                CHECK_EQ(rsmt_length<int>(pins, mode), length);
+                if (mode == SteinerMode::Fast) {
+                    total_mst += mst;
+                    total_rsmt += length;
+                }
+            }
+        }
+    }
+    CHECK(double(total_rsmt) < 0.95 * double(total_mst));
+
+    // 1-Steiner has no degree limit (its scratch space grows with the net)
+    const auto pins = halton_net(hgenX, hgenY, 40);
+    const auto tree = rectilinear_steiner_tree<int>(pins, SteinerMode::OneSteiner);
+    CHECK(is_valid_tree(tree, pins));
+    CHECK(tree.nodes.size() > 40U);
+    CHECK(tree.wirelength() < brute_mst_length(pins));
+}
+
+TEST_CASE("RSMT test (batch)") {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto nets = PolygonSet<int>{};
+    for (auto net = 0U; net != 500; ++net) {
+        nets.push_back(halton_net(hgenX, hgenY, 2 + net % 13));
+    }
+    auto serial = std::vector<int>(nets.size());
+    auto threaded = std::vector<int>(nets.size());
+    rsmt_lengths<int>(nets.points(), nets.offsets(), serial);
+    rsmt_lengths<int>(nets.points(), nets.offsets(), threaded, 4);
+    CHECK(serial == threaded);
+    for (auto net = 0U; net < nets.size(); net += 37) {
+        CHECK_EQ(serial[net], rsmt_length<int>(nets[net]));
+    }
+}
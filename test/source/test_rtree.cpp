@@ -0,0 +1,61 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>        // for sort
+#include <ldsgen/ilds.hpp>  // for VdCorput
+#include <recti/rtree.hpp>  // for StaticRTree
+#include <utility>          // for pair
+#include <vector>           // for vector
+
+#include "recti/recti.hpp"  // for Rectangle, overlap, min_dist
+
+using namespace recti;
+
+static auto make_cells(unsigned num) -> std::vector<Rectangle<int>> {
+    auto hgenX = ildsgen::VdCorput(3, 7);
+    auto hgenY = ildsgen::VdCorput(2, 11);
+    auto rects = std::vector<Rectangle<int>>{};
+    for (auto i = 0U; i != num; ++i) {
+        auto x = int(hgenX.pop());
+        auto y = int(hgenY.pop());
+        rects.emplace_back(Interval<int>{x, x + 30}, Interval<int>{y, y + 20});
+    }
+    return rects;
+}
+
+TEST_CASE("StaticRTree test (small)") {
+    auto rects = std::vector<Rectangle<int>>{{{0, 10}, {0, 10}}, {{20, 30}, {0, 10}}};
+    auto tree = StaticRTree<int>(rects);
+    CHECK_EQ(tree.size(), 2U);
+    CHECK_EQ(tree.bounding_box(), Rectangle<int>{{0, 30}, {0, 10}});
+    CHECK_EQ(tree.query(Point<int>{25, 5}), std::vector<std::size_t>{1U});
+    CHECK(tree.query(Rectangle<int>{{11, 19}, {0, 10}}).empty());
+    auto knn = tree.nearest(Point<int>{15, 12}, 2);
+    CHECK_EQ(knn, std::vector<std::pair<int, std::size_t>>{{7, 0U}, {7, 1U}});
+    CHECK(StaticRTree<int>{}.query(Point<int>{0, 0}).empty());
+}
+
+TEST_CASE("StaticRTree test (against linear scan)") {
+    const auto rects = make_cells(3000);
+    const auto tree = StaticRTree<int, 8>(rects);
+    const auto window = Rectangle<int>{{500, 800}, {600, 700}};
+    auto found = tree.query(window);
+    std::sort(found.begin(), found.end());
+    auto expected = std::vector<std::size_t>{};
+    for (auto i = 0U; i != rects.size(); ++i) {
+        if (overlap(rects[i], window)) {
+            expected.push_back(i);
+        }
+    }
+    CHECK(!expected.empty());
+    CHECK_EQ(found, expected);
+
+    const auto ptq = Point<int>{1111, 999};
+    auto knn = tree.nearest(ptq, 5);
+    auto brute = std::vector<std::pair<int, std::size_t>>{};
+    for (auto i = 0U; i != rects.size(); ++i) {
+        brute.emplace_back(min_dist(rects[i], ptq), i);
+    }
+    std::sort(brute.begin(), brute.end());
+    brute.resize(5);
+    CHECK_EQ(knn, brute);
+}
@@ -0,0 +1,57 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>                    // for sort
+#include <ldsgen/ilds.hpp>              // for VdCorput
+#include <recti/segment_crossings.hpp>  // for count_crossings, crossing_pairs, ...
+#include <utility>                      // for pair
+#include <vector>                       // for vector
+
+#include "recti/recti.hpp"  // for HSegment, VSegment
+
+using namespace recti;
+
+TEST_CASE("Segment crossings (small)") {
+    const auto hsegs = std::vector<HSegment<int>>{{{0, 10}, 5}, {{2, 4}, 1}, {{6, 8}, 5}};
+    const auto vsegs = std::vector<VSegment<int>>{{3, {0, 6}}, {8, {5, 9}}, {11, {0, 9}},
+                                                  {4, {2, 4}}};
+    auto pairs = std::vector<std::pair<std::size_t, std::size_t>>{};
+    sweep_crossings<int>(hsegs, vsegs,
+                         [&pairs](std::size_t h, std::size_t v) { pairs.emplace_back(h, v); });
+    std::sort(pairs.begin(), pairs.end());
+    // (2, 1) only touches: the vertical segment starts on the end of the horizontal one
+    CHECK_EQ(pairs, std::vector<std::pair<std::size_t, std::size_t>>{
+                        {0, 0}, {0, 1}, {1, 0}, {2, 1}});
+    CHECK_EQ(count_crossings<int>(hsegs, vsegs), 4U);
+    CHECK_EQ(count_crossings<int>(hsegs, {}), 0U);
+}
+
+TEST_CASE("Segment crossings (against brute force)") {
+    auto hgen_x = ildsgen::VdCorput(3, 7);
+    auto hgen_y = ildsgen::VdCorput(2, 11);
+    auto hgen_w = ildsgen::VdCorput(5, 3);
+    auto hsegs = std::vector<HSegment<int>>{};
+    auto vsegs = std::vector<VSegment<int>>{};
+    for (auto idx = 0; idx != 3000; ++idx) {
+        const auto x = int(hgen_x.pop());
+        const auto y = int(hgen_y.pop() % 300);  // shared y-coordinates
+        const auto w = int(hgen_w.pop());
+        hsegs.push_back({{x, x + 3 * w}, y});
+        vsegs.push_back({x + w, {y - w, y + w}});
+    }
+    hsegs.push_back({{0, 2187}, 150});  // spans all strips
+
+    auto expected = std::vector<std::pair<std::size_t, std::size_t>>{};
+    for (auto h = 0U; h != hsegs.size(); ++h) {
+        for (auto v = 0U; v != vsegs.size(); ++v) {
+            if (hsegs[h].xcoord().contains(vsegs[v].xcoord())
+                && vsegs[v].ycoord().contains(hsegs[h].ycoord())) {
+                expected.emplace_back(h, v);
+            }
+        }
+    }
+    REQUIRE(expected.size() > 3000U);
+    CHECK_EQ(count_crossings<int>(hsegs, vsegs), expected.size());
+    CHECK_EQ(count_crossings<int>(hsegs, vsegs, 4), expected.size());
+    CHECK_EQ(crossing_pairs<int>(hsegs, vsegs), expected);
+    CHECK_EQ(crossing_pairs<int>(hsegs, vsegs, 4), expected);
+}
@@ -4,6 +4,7 @@ add_rules("mode.debug", "mode.release", "mode.coverage")
 add_requires("fmt", {alias = "fmt"})
 add_requires("doctest", {alias = "doctest"})
 add_requires("microsoft-gsl", {alias = "ms-gsl"})
+add_requires("benchmark", {alias = "benchmark"})
 
 if is_mode("coverage") then
     add_cxflags("-ftest-coverage", "-fprofile-arcs", {force = true})
@@ -32,6 +33,14 @@ target("test_recti")
     add_files("test/source/*.cpp")
     add_packages("fmt", "doctest", "ms-gsl")
 
+target("bench_recti")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include", {public = true})
+    add_includedirs("../lds-gen-cpp/include", {public = true})
+    add_files("bench/source/*.cpp")
+    add_packages("fmt", "ms-gsl", "benchmark")
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --